@@ -4,6 +4,7 @@ out vec4 fragmentColor;
 struct Material {
     sampler2D diffuse;
     sampler2D specular;
+    sampler2D normal;
 
     float shininess;
 };
@@ -19,22 +20,38 @@ struct Light {
 in vec3 fragPosition;
 in vec3 normals;
 in vec2 textureCoordinates;
+in mat3 tangentFrame;
 
 uniform vec3 viewPos;
 
 uniform Material material;
 uniform Light light;
+// set for meshes with a normal map and tangents
+uniform bool normalMapped;
+// set when the diffuse maps are sRGB textures and therefore sampled as linear values
+uniform bool gammaEncode;
+// set when the diffuse maps hold sRGB colors stored as plain data, gray ones without an sRGB format
+uniform bool gammaDecode;
 
 void main()
 {
+    vec3 albedo = texture(material.diffuse, textureCoordinates).rgb;
+    if (gammaDecode)
+        albedo = pow(albedo, vec3(2.2));
+
     // ambient
-    vec3 ambient = light.ambient * texture(material.diffuse, textureCoordinates).rgb;
+    vec3 ambient = light.ambient * albedo;
 
     // diffuse
     vec3 norm = normalize(normals);
+    if (normalMapped) {
+        // only x and y are stored, BC5 normal maps have no third channel
+        vec2 xy = texture(material.normal, textureCoordinates).rg * 2.0 - 1.0;
+        norm = normalize(tangentFrame * vec3(xy, sqrt(max(1.0 - dot(xy, xy), 0.0))));
+    }
     vec3 lightDir = normalize(light.position - fragPosition);
     float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = light.diffuse * diff * texture(material.diffuse, textureCoordinates).rgb;
+    vec3 diffuse = light.diffuse * diff * albedo;
 
     // specular
     vec3 viewDir = normalize(viewPos - fragPosition);
@@ -43,5 +60,10 @@ void main()
     vec3 specular = light.specular * spec * texture(material.specular, textureCoordinates).rgb;
 
     vec3 result = ambient + diffuse + specular;
+
+    // the default framebuffer is not sRGB, encode linear results by hand
+    if (gammaEncode)
+        result = pow(result, vec3(1.0 / 2.2));
+
     fragmentColor = vec4(result, 1.0);
 }
\ No newline at end of file
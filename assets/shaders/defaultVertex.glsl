@@ -2,19 +2,38 @@
 layout (location = 0) in vec3 vertexPosition;
 layout (location = 1) in vec3 vertexNormals;
 layout (location = 2) in vec2 vertexTexture;
+// placement of the mesh in the model, per instance or constant when not instanced
+layout (location = 3) in mat4 instanceTransform;
+// xyz tangent and w the sign of the bitangent, only read when normal mapped
+layout (location = 7) in vec4 vertexTangent;
 
 out vec3 fragPosition;
 out vec3 normals;
 out vec2 textureCoordinates;
+out mat3 tangentFrame;
 
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+// maps quantized positions back to model space, identity for float positions
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
 void main()
 {
-    fragPosition = vec3(model * vec4(vertexPosition, 1.0));
-    normals = mat3(transpose(inverse(model))) * vertexNormals;
+    vec3 position = positionOffset + vertexPosition * positionScale;
+    mat4 world = model * instanceTransform;
+
+    fragPosition = vec3(world * vec4(position, 1.0));
+    mat3 normalMatrix = mat3(transpose(inverse(world)));
+    normals = normalMatrix * vertexNormals;
+
+    // MikkTSpace frame, the bitangent is rebuilt from the normal rather than stored
+    vec3 tangent = normalize(mat3(world) * vertexTangent.xyz);
+    vec3 normal = normalize(normals);
+    tangent = normalize(tangent - dot(tangent, normal) * normal);
+    tangentFrame = mat3(tangent, cross(normal, tangent) * vertexTangent.w, normal);
     textureCoordinates = vertexTexture;
 
     gl_Position = projection * view * vec4(fragPosition, 1.0);
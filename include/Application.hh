@@ -16,6 +16,12 @@ namespace kT {
         auto Init() -> void;
         auto UpdateState() -> void;
         auto PushLayer(std::shared_ptr<Layer> layer) -> void;
+
+        /**
+         * Releases the layers and every OpenGL object held by the process wide caches.
+         * Must be called before the application is destroyed, the window takes the context down with it
+         * */
+        auto ShutDown() -> void;
         auto IsRunning() -> bool { return m_State == State::RUNNING; }
 
     private:
@@ -0,0 +1,45 @@
+/**
+ * @file AssetFiles.hh
+ * @author kT
+ * @brief Defines where the asset sources live and which files are assets
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef ASSET_FILES_HH
+#define ASSET_FILES_HH
+
+// C++ Standard Library
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace kT {
+    // asset directories, relative to the build directory the tools are run from
+    constexpr std::string_view ModelsDirectory{ "../assets/models" };
+    constexpr std::string_view TexturesDirectory{ "../assets/textures" };
+
+    /**
+     * Returns true if the given file is a model one of the importers reads. The extension
+     * is compared without regard to case
+     * @param path path to a file
+     * */
+    auto isModelFile(const std::filesystem::path& path) -> bool;
+
+    /**
+     * Returns true if the given file is an image kT::Texture decodes. The extension
+     * is compared without regard to case
+     * @param path path to a file
+     * */
+    auto isImageFile(const std::filesystem::path& path) -> bool;
+
+    /**
+     * Returns the model files found under the given directory and its subdirectories
+     * @param root directory to search
+     * @returns paths of the model files, sorted so runs visit them in the same order
+     * @throws std::filesystem::filesystem_error if root can not be read
+     * */
+    auto findModelFiles(const std::filesystem::path& root = ModelsDirectory) -> std::vector<std::filesystem::path>;
+}
+
+#endif // ASSET_FILES_HH
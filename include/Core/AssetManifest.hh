@@ -0,0 +1,116 @@
+/**
+ * @file AssetManifest.hh
+ * @author kT
+ * @brief Defines the dependency graph of baked assets
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef ASSET_MANIFEST_HH
+#define ASSET_MANIFEST_HH
+
+// C++ Standard Library
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace kT {
+    /**
+     * Source file an asset was baked from, with its content hash at bake time
+     * */
+    struct AssetSource {
+        std::filesystem::path   path{};
+        std::uint64_t           hash{};
+        std::uintmax_t          size{};
+        std::int64_t            writeTime{};    // last write time, lets unchanged files skip rehashing
+    };
+
+    /**
+     * Records, for every baked output, the files and settings it was built from, so only assets
+     * whose inputs changed are baked again. An output is up to date when it exists and the hashes of
+     * its sources, its settings and its format version all match. Sources whose size and write time
+     * did not change keep their stored hash instead of being read again. Stored as a text file
+     * */
+    class AssetManifest {
+    public:
+        /**
+         * Version of the manifest file format
+         * */
+        static constexpr std::uint32_t s_Version{ 1 };
+
+        /**
+         * Default constructs an empty manifest
+         * */
+        explicit AssetManifest() = default;
+
+        /**
+         * Reads a manifest file
+         * @param path path to the manifest, a missing file or one written by another version gives an empty manifest
+         * @throws std::runtime_error if the file is corrupted
+         * */
+        explicit AssetManifest(const std::filesystem::path& path);
+
+        /**
+         * Returns the current state of a source file, its contents hashed
+         * @param path path to the file
+         * @throws std::runtime_error if the file could not be read
+         * */
+        static auto HashFile(const std::filesystem::path& path) -> AssetSource;
+
+        /**
+         * Writes the manifest, replacing the given file
+         * @param path path to the manifest
+         * @throws std::runtime_error if the file could not be written
+         * */
+        auto save(const std::filesystem::path& path) const -> void;
+
+        /**
+         * Returns true if the output exists and was baked from the current contents of the given
+         * sources, with the same settings and format version. Sources whose contents match but whose size or write
+         * time changed get those updated, so they are not hashed again. Safe to call from several threads
+         * @param output path of the baked file
+         * @param sources every file the output is built from
+         * @param settings hash of the settings the output depends on
+         * @param version format version of the output
+         * */
+        [[nodiscard]]
+        auto isUpToDate(const std::filesystem::path& output, const std::vector<std::filesystem::path>& sources,
+                        std::uint64_t settings, std::uint32_t version) -> bool;
+
+        /**
+         * Records a freshly baked output, hashing its sources. Safe to call from several threads
+         * @param output path of the baked file
+         * @param sources every file the output is built from
+         * @param settings hash of the settings the output depends on
+         * @param version format version of the output
+         * @throws std::runtime_error if a source could not be read
+         * */
+        auto record(const std::filesystem::path& output, const std::vector<std::filesystem::path>& sources,
+                    std::uint64_t settings, std::uint32_t version) -> void;
+
+        /**
+         * Forgets the outputs not checked nor recorded since the manifest was read, those of assets that no longer exist
+         * @returns amount of outputs removed
+         * */
+        auto prune() -> std::size_t;
+
+        [[nodiscard]]
+        auto getSize() const -> std::size_t { return m_Outputs.size(); }
+
+    private:
+        struct Output {
+            std::uint64_t               settings{};
+            std::uint32_t               version{};
+            std::vector<AssetSource>    sources{};
+            bool                        visited{};
+        };
+
+        std::unordered_map<std::string, Output> m_Outputs{};
+        mutable std::mutex m_Mutex{};
+    };
+}
+
+#endif // ASSET_MANIFEST_HH
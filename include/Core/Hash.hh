@@ -0,0 +1,61 @@
+/**
+ * @file Hash.hh
+ * @author kT
+ * @brief Defines content hashing utilities
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef HASH_HH
+#define HASH_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace kT {
+    // FNV-1a constants for 64-bit hashes
+    constexpr std::uint64_t HashSeed{ 0xcbf29ce484222325ull };
+    constexpr std::uint64_t HashPrime{ 0x100000001b3ull };
+
+    /**
+     * Hashes the given bytes. Used to detect content changes of asset
+     * files, it is not meant to be cryptographically secure.
+     * Reads eight bytes per step so large files hash at memory speed
+     * @param data bytes to hash
+     * @param seed previous hash value, allows chaining several buffers
+     * @returns 64-bit hash of data
+     * */
+    inline auto hashBytes(std::span<const std::byte> data, std::uint64_t seed = HashSeed) -> std::uint64_t {
+        std::uint64_t hash{ seed };
+        std::size_t offset{};
+
+        for (; offset + sizeof(std::uint64_t) <= data.size(); offset += sizeof(std::uint64_t)) {
+            std::uint64_t word{};
+            std::memcpy(&word, data.data() + offset, sizeof(word));
+
+            hash = (hash ^ word) * HashPrime;
+            hash ^= hash >> 32;
+        }
+
+        for (; offset < data.size(); offset++)
+            hash = (hash ^ static_cast<std::uint64_t>(data[offset])) * HashPrime;
+
+        return hash;
+    }
+
+    /**
+     * Hashes the characters of the given string
+     * @param str characters to hash
+     * @param seed previous hash value, allows chaining several buffers
+     * @returns 64-bit hash of str
+     * */
+    inline auto hashString(std::string_view str, std::uint64_t seed = HashSeed) -> std::uint64_t {
+        return hashBytes(std::as_bytes(std::span{ str.data(), str.size() }), seed);
+    }
+}
+
+#endif // HASH_HH
@@ -0,0 +1,99 @@
+/**
+ * @file Json.hh
+ * @author kT
+ * @brief Defines a small JSON document reader
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef JSON_HH
+#define JSON_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace kT {
+    /**
+     * Value of a parsed JSON document. Only reading is supported, which is all
+     * asset formats like glTF need. Lookups of missing members or elements return a
+     * null value instead of throwing, so optional fields read as their default
+     * */
+    class JsonValue {
+    public:
+        using Array = std::vector<JsonValue>;
+        using Object = std::vector<std::pair<std::string, JsonValue>>;   // members in document order
+
+        /**
+         * Default constructs a null value
+         * */
+        explicit JsonValue() = default;
+
+        /**
+         * Parses a whole JSON document
+         * @param text UTF-8 encoded document
+         * @returns the root value
+         * @throws std::runtime_error if text is not valid JSON
+         * */
+        static auto Parse(std::string_view text) -> JsonValue;
+
+        /**
+         * Returns the member with the given name, or a null value if this is not an object or has no such member
+         * @param key name of the member
+         * */
+        auto operator[](std::string_view key) const -> const JsonValue&;
+
+        /**
+         * Returns the element at the given position, or a null value if this is not an array or is too short
+         * @param index position of the element
+         * */
+        auto operator[](std::size_t index) const -> const JsonValue&;
+
+        /**
+         * Returns the amount of elements of an array or members of an object, zero for every other value
+         * */
+        [[nodiscard]]
+        auto size() const -> std::size_t;
+
+        [[nodiscard]]
+        auto isNull() const -> bool { return std::holds_alternative<std::monostate>(m_Value); }
+
+        [[nodiscard]]
+        auto isNumber() const -> bool { return std::holds_alternative<double>(m_Value); }
+
+        [[nodiscard]]
+        auto isString() const -> bool { return std::holds_alternative<std::string>(m_Value); }
+
+        [[nodiscard]]
+        auto isArray() const -> bool { return std::holds_alternative<Array>(m_Value); }
+
+        [[nodiscard]]
+        auto isObject() const -> bool { return std::holds_alternative<Object>(m_Value); }
+
+        [[nodiscard]]
+        auto asBool(bool fallback = false) const -> bool;
+
+        [[nodiscard]]
+        auto asNumber(double fallback = 0.0) const -> double;
+
+        [[nodiscard]]
+        auto asString(std::string_view fallback = {}) const -> std::string_view;
+
+        /**
+         * Returns the members of an object, empty for every other value
+         * */
+        [[nodiscard]]
+        auto getMembers() const -> const Object&;
+
+    private:
+        friend class JsonParser;
+
+        std::variant<std::monostate, bool, double, std::string, Array, Object> m_Value{};
+    };
+}
+
+#endif // JSON_HH
@@ -12,6 +12,7 @@ namespace kT {
     public:
         Layer(std::string_view name = "BaseLayer") : m_Name{ name } {}
         virtual auto OnAttach(std::shared_ptr<Window> handle = nullptr) -> void = 0;
+        virtual auto OnDetach() -> void {}
         virtual auto OnUpdate(std::shared_ptr<Window> handle) -> void = 0;
         virtual auto OnImGuiRender() -> void = 0;
 
@@ -0,0 +1,95 @@
+/**
+ * @file MappedFile.hh
+ * @author kT
+ * @brief Defines the MappedFile class
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef MAPPED_FILE_HH
+#define MAPPED_FILE_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace kT {
+    /**
+     * Read only view of a whole file mapped into memory
+     * */
+    class MappedFile {
+    public:
+        /**
+         * Default constructs an empty mapping
+         * */
+        explicit MappedFile() = default;
+
+        /**
+         * Maps the file in path into memory
+         * @param path path to the file
+         * @throws std::runtime_error if the file could not be opened or mapped
+         * */
+        explicit MappedFile(const std::filesystem::path& path);
+
+        /**
+         * Copy constructor disabled. One mapping is owned by one MappedFile
+         * */
+        MappedFile(const MappedFile& other) = delete;
+
+        /**
+         * Copy assigment disabled. One mapping is owned by one MappedFile
+         * */
+        auto operator=(const MappedFile& other) -> MappedFile& = delete;
+
+        /**
+         * Move constructor
+         * @param other moved from MappedFile
+         * */
+        MappedFile(MappedFile&& other) noexcept;
+
+        /**
+         * Move assignment
+         * @param other moved from MappedFile
+         * @returns *this
+         * */
+        auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+        /**
+         * Returns the contents of the mapped file
+         * @returns bytes of the file
+         * */
+        [[nodiscard]]
+        auto getData() const -> std::span<const std::byte> { return { static_cast<const std::byte*>(m_Data), m_Size }; }
+
+        [[nodiscard]]
+        auto getSize() const -> std::size_t { return m_Size; }
+
+        [[nodiscard]]
+        auto isEmpty() const -> bool { return m_Size == 0; }
+
+        /**
+         * Drops the pages of part of the mapping from physical memory. They stay mapped and
+         * are read from the file again if touched, so this only lowers the resident memory
+         * @param bytes range of getData() that will not be read for a while
+         * */
+        auto evict(std::span<const std::byte> bytes) const -> void;
+
+        /**
+         * Unmaps the file
+         * */
+        ~MappedFile();
+
+    private:
+        auto release() -> void;
+
+        const void*     m_Data{};
+        std::size_t     m_Size{};
+#if defined(_WIN64) || defined(WIN32)
+        void*           m_File{};       // HANDLE of the file
+        void*           m_Mapping{};    // HANDLE of the file mapping
+#endif
+    };
+}
+
+#endif // MAPPED_FILE_HH
@@ -6,6 +6,7 @@
 #define RENDERER_MODEL_LOAD_LAYER_HH
 
 // C++ Standard Library
+#include <filesystem>
 #include <memory>
 
 // Third-Party Libraries
@@ -18,6 +19,7 @@
 #include <Core/Layer.hh>
 #include <Core/Window.hh>
 
+#include <OpenGL/AsyncModelLoader.hh>
 #include <OpenGL/Camera.hh>
 #include <OpenGL/Model.hh>
 #include <OpenGL/Shader.hh>
@@ -27,13 +29,22 @@ namespace kT {
     public:
         ModelLoader(std::string_view name = "ModelLoadLayer") : Layer{ name } {}
         auto OnAttach(std::shared_ptr<Window> handle = nullptr) -> void override;
+        auto OnDetach() -> void override;
         auto OnUpdate(std::shared_ptr<Window> handle) -> void override;
         auto OnImGuiRender() -> void override;
 
+    private:
+        /**
+         * Starts loading the model in path in place of the current one
+         * @param path path to the model to be loaded
+         * */
+        auto loadModel(const std::filesystem::path& path) -> void;
+
     private:
         std::shared_ptr<Camera> m_Camera{};
         std::shared_ptr<Shader> m_DefaultShader{};
         std::shared_ptr<Model> m_Model{};
+        std::shared_ptr<ModelLoadHandle> m_ModelLoad{};
 
         bool m_Lines{ false };
         glm::vec4 m_ClearColor {};
@@ -0,0 +1,46 @@
+/**
+ * @file ProcessMemory.hh
+ * @author kT
+ * @brief Defines queries of the memory used by the process
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef PROCESS_MEMORY_HH
+#define PROCESS_MEMORY_HH
+
+// C++ Standard Library
+#include <cstddef>
+
+namespace kT {
+    /**
+     * Returns the largest amount of physical memory the process has used since it started,
+     * used to compare the memory cost of the import paths
+     * @returns peak resident set size in bytes, zero if the platform can not tell
+     * */
+    auto getPeakResidentBytes() -> std::size_t;
+
+    /**
+     * Returns the largest amount of physical memory the process has used since the last
+     * kT::resetPeakResidentBytes(), the same as kT::getPeakResidentBytes() where it can not be reset
+     * @returns peak resident set size in bytes, zero if the platform can not tell
+     * */
+    auto getPeakResidentBytesSinceReset() -> std::size_t;
+
+    /**
+     * Restarts the peak of kT::getPeakResidentBytesSinceReset() from the memory used now, so one
+     * stage of work is told apart from the earlier ones. The peak is process wide, work running
+     * meanwhile on other threads counts as well. Only Linux supports it
+     * @returns true if the peak was reset
+     * */
+    auto resetPeakResidentBytes() -> bool;
+
+    /**
+     * Returns the physical memory the process uses right now, which the streaming
+     * import of kT::Model compares against its memory budget
+     * @returns resident set size in bytes, zero if the platform can not tell
+     * */
+    auto getResidentBytes() -> std::size_t;
+}
+
+#endif // PROCESS_MEMORY_HH
@@ -0,0 +1,157 @@
+/**
+ * @file ThreadPool.hh
+ * @author kT
+ * @brief Defines the ThreadPool class
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef THREAD_POOL_HH
+#define THREAD_POOL_HH
+
+// C++ Standard Library
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace kT {
+    class ThreadPool {
+    public:
+        /**
+         * Starts <code>threadCount</code> worker threads. If the count is zero
+         * one worker per hardware thread is started
+         * @param threadCount amount of worker threads
+         * */
+        explicit ThreadPool(std::size_t threadCount = 0);
+
+        /**
+         * Copy constructor disabled
+         * */
+        ThreadPool(const ThreadPool&) = delete;
+
+        /**
+         * Copy assigment disabled
+         * */
+        auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+        /**
+         * Queues the given callable to be executed by one of the worker threads
+         * @param task callable taking no arguments
+         * @returns future holding the result of the task or the exception it threw
+         * */
+        template<typename Func>
+        auto submit(Func&& task) -> std::future<std::invoke_result_t<std::decay_t<Func>>> {
+            using Result_T = std::invoke_result_t<std::decay_t<Func>>;
+
+            // std::function must be copyable, packaged_task is not, so it is shared
+            auto packaged{ std::make_shared<std::packaged_task<Result_T()>>(std::forward<Func>(task)) };
+            std::future<Result_T> result{ packaged->get_future() };
+
+            {
+                std::scoped_lock lock{ m_Mutex };
+                m_Tasks.emplace([packaged]() -> void { (*packaged)(); });
+            }
+
+            m_Condition.notify_one();
+            return result;
+        }
+
+        /**
+         * Calls body(i) for every i in [0, count) spread over the worker threads and waits for all of them.
+         * The calling thread takes part in the loop, so it is safe to call from a task of this same pool:
+         * the loop finishes even if no worker is free to help
+         * @param count amount of iterations
+         * @param body callable taking the iteration index
+         * @throws the first exception thrown by body, once every started iteration has finished
+         * */
+        template<typename Func>
+        auto parallelFor(std::size_t count, Func&& body) -> void {
+            struct Loop {
+                std::atomic<std::size_t>    next{};
+                std::size_t                 finished{};
+                std::exception_ptr          error{};
+                std::mutex                  mutex{};
+                std::condition_variable     done{};
+            };
+
+            if (count == 0)
+                return;
+
+            auto loop{ std::make_shared<Loop>() };
+
+            // helpers starting after every index is claimed leave without touching body, which may be gone by then
+            auto work{ [loop, count, &body]() -> void {
+                for (std::size_t i{ loop->next++ }; i < count; i = loop->next++) {
+                    std::exception_ptr error{};
+
+                    try {
+                        body(i);
+                    }
+                    catch (...) {
+                        error = std::current_exception();
+                    }
+
+                    std::scoped_lock lock{ loop->mutex };
+                    if (error != nullptr && loop->error == nullptr)
+                        loop->error = error;
+
+                    if (++loop->finished == count)
+                        loop->done.notify_all();
+                }
+            } };
+
+            const std::size_t helpers{ std::min(count, getThreadCount() + 1) - 1 };
+            for (std::size_t i{}; i < helpers; i++)
+                submit(work);
+
+            work();
+
+            std::unique_lock lock{ loop->mutex };
+            loop->done.wait(lock, [&loop, count]() -> bool { return loop->finished == count; });
+
+            if (loop->error != nullptr)
+                std::rethrow_exception(loop->error);
+        }
+
+        /**
+         * Returns the amount of worker threads of this pool
+         * @returns worker count
+         * */
+        [[nodiscard]]
+        auto getThreadCount() const -> std::size_t { return m_Workers.size(); }
+
+        /**
+         * Returns the pool shared by the asset loading code. It is
+         * created on first use with one worker per hardware thread
+         * @returns global thread pool
+         * */
+        static auto Get() -> ThreadPool&;
+
+        /**
+         * Finishes the queued tasks and joins the worker threads
+         * */
+        ~ThreadPool();
+
+    private:
+        auto workerLoop() -> void;
+
+        std::vector<std::thread>            m_Workers{};
+        std::queue<std::function<void()>>   m_Tasks{};
+        std::mutex                          m_Mutex{};
+        std::condition_variable             m_Condition{};
+        bool                                m_Stopping{ false };
+    };
+}
+
+#endif // THREAD_POOL_HH
@@ -0,0 +1,142 @@
+/**
+ * @file AsyncModelLoader.hh
+ * @author kT
+ * @brief Defines the asynchronous model loading interface
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef ASYNC_MODEL_LOADER_HH
+#define ASYNC_MODEL_LOADER_HH
+
+// C++ Standard Library
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Project Libraries
+#include "Model.hh"
+
+namespace kT {
+    /**
+     * Tracks a model being loaded by kT::AsyncModelLoader. The model is usable right
+     * away, its meshes show up as they are uploaded. Must only be used from the thread
+     * owning the OpenGL context
+     * */
+    class ModelLoadHandle {
+    public:
+        /**
+         * Stage of the load
+         * */
+        enum class State {
+            IMPORTING,      // importing and decoding on the worker pool
+            UPLOADING,      // creating the OpenGL objects a few meshes per frame
+            READY,
+            FAILED,
+        };
+
+        [[nodiscard]]
+        auto getState() const -> State { return m_State; }
+
+        [[nodiscard]]
+        auto getPath() const -> const std::filesystem::path& { return m_Path; }
+
+        /**
+         * Returns the model being loaded. It holds the meshes uploaded so far
+         * @returns loaded model
+         * */
+        [[nodiscard]]
+        auto getModel() const -> const std::shared_ptr<Model>& { return m_Model; }
+
+        /**
+         * Returns the reason of the failure when the state is FAILED
+         * */
+        [[nodiscard]]
+        auto getError() const -> const std::string& { return m_Error; }
+
+        /**
+         * Returns the completion of the load, from 0 to 1
+         * */
+        [[nodiscard]]
+        auto getProgress() const -> float;
+
+        [[nodiscard]]
+        auto isDone() const -> bool { return m_State == State::READY || m_State == State::FAILED; }
+
+        /**
+         * Returns a C-String representing the given state
+         * */
+        static constexpr auto getStrState(State state) -> std::string_view {
+            switch (state) {
+                case State::IMPORTING: return "importing";
+                case State::UPLOADING: return "uploading";
+                case State::READY: return "ready";
+                case State::FAILED: return "failed";
+                default: return "invalid";
+            }
+        }
+
+    private:
+        friend class AsyncModelLoader;
+
+        std::filesystem::path                   m_Path{};
+        std::shared_ptr<Model>                  m_Model{};
+        std::future<PreparedModel>              m_Import{};
+        std::optional<PreparedModel>            m_Prepared{};
+        State                                   m_State{ State::IMPORTING };
+        std::string                             m_Error{};
+        std::chrono::steady_clock::time_point   m_Start{};
+    };
+
+    /**
+     * Loads models without blocking the render loop. Importing and decoding run on
+     * the worker pool, the OpenGL objects are created from Update() under a per frame time budget
+     * */
+    class AsyncModelLoader {
+    public:
+        /**
+         * Starts loading the model in path and returns immediately
+         * @param path path to the model to be loaded
+         * @param options import settings
+         * @returns handle tracking the load
+         * */
+        static auto Load(const std::filesystem::path& path, const ModelLoadOptions& options = {}) -> std::shared_ptr<ModelLoadHandle>;
+
+        /**
+         * Advances the pending loads. Uploads meshes until the frame budget is
+         * spent, call it once per frame from the thread owning the OpenGL context
+         * */
+        static auto Update() -> void;
+
+        /**
+         * Drops the pending loads along with the meshes they uploaded so far,
+         * waiting for the imports still running on the worker pool
+         * */
+        static auto ShutDown() -> void;
+
+        /**
+         * Sets the time Update() may spend uploading per frame. At least
+         * one mesh is uploaded per frame so loads always make progress
+         * @param budget upload time per frame
+         * */
+        static auto SetFrameBudget(std::chrono::microseconds budget) -> void { s_FrameBudget = budget; }
+
+        [[nodiscard]]
+        static auto GetFrameBudget() -> std::chrono::microseconds { return s_FrameBudget; }
+
+        [[nodiscard]]
+        static auto GetPendingCount() -> std::size_t { return s_Loads.size(); }
+
+    private:
+        inline static std::vector<std::shared_ptr<ModelLoadHandle>> s_Loads{};
+        inline static std::chrono::microseconds s_FrameBudget{ 4000 };
+    };
+}
+
+#endif // ASYNC_MODEL_LOADER_HH
@@ -0,0 +1,266 @@
+/**
+ * @file BakedModel.hh
+ * @author kT
+ * @brief Defines the baked binary mesh format
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef BAKED_MODEL_HH
+#define BAKED_MODEL_HH
+
+// C++ Standard Library
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Project Libraries
+#include "Core/MappedFile.hh"
+#include "MeshData.hh"
+#include "SceneGraph.hh"
+
+namespace kT {
+    /**
+     * Binary cache of an imported model. The file stores, for every mesh, the interleaved
+     * vertices laid out as the kT::Mesh buffer layout, the indices of every level of detail,
+     * the meshlets, the bounds and the texture references of its material, plus the content hash of the source it was imported from.
+     * The vertices are also stored quantized and the tangents packed, as kT::VertexQuantizer encodes them for the upload.
+     * Images embedded in the source model are stored as well, still encoded.
+     * Loading maps the file and hands out views into it, so the data goes straight
+     * to the GPU without being parsed or copied. Files written with encodeGeometry store
+     * vertices, indices and tangents compressed by kT::VertexCodec instead, those are
+     * decoded into client memory one mesh at a time, see kT::BakedModel::decode()
+     * */
+    class BakedModel {
+    public:
+        /**
+         * Amount of floats and indices of the streams of a mesh, known before it is decoded
+         * */
+        struct GeometrySize {
+            std::size_t vertices{};
+            std::size_t indices{};
+            std::size_t tangents{};
+        };
+
+        /**
+         * Version of the file format, bump whenever the layout changes
+         * */
+        static constexpr std::uint32_t s_Version{ 10 };
+
+        /**
+         * Extension appended to the source file name
+         * */
+        static constexpr std::string_view s_Extension{ ".ktmesh" };
+
+        /**
+         * Returns the path of the baked file for the given source model
+         * @param source path to the source model
+         * @returns path to the baked file
+         * */
+        static auto GetBakePath(const std::filesystem::path& source) -> std::filesystem::path;
+
+        /**
+         * Returns the content hash of the given source file
+         * @param source path to the source model
+         * @param seed previous hash value, used to chain the import settings and other source files
+         * @returns hash of the file contents
+         * @throws std::runtime_error if the file could not be read
+         * */
+        static auto HashSource(const std::filesystem::path& source, std::uint64_t seed) -> std::uint64_t;
+
+        /**
+         * Writes the given meshes to a baked file. Texture paths are stored
+         * relative to modelDirectory
+         * @param path path of the baked file
+         * @param sourceHash content hash of the source model
+         * @param meshes imported meshes
+         * @param instances placements of the meshes
+         * @param scene nodes the instances are attached to
+         * @param modelDirectory directory containing the source model
+         * @param encodeGeometry compress the vertices, indices and tangents with kT::VertexCodec
+         * @throws std::runtime_error if the file could not be written
+         * */
+        static auto Write(const std::filesystem::path& path, std::uint64_t sourceHash, std::span<const MeshData> meshes,
+                          std::span<const MeshInstance> instances, const SceneGraph& scene, const std::filesystem::path& modelDirectory,
+                          bool encodeGeometry = false) -> void;
+
+        /**
+         * Maps a baked file. Compressed geometry is not decoded yet. Texture paths are resolved relative to modelDirectory
+         * @param path path of the baked file
+         * @param sourceHash expected content hash of the source model
+         * @param modelDirectory directory containing the source model
+         * @returns the baked model or std::nullopt if the file is missing, stale or corrupted
+         * */
+        static auto Open(const std::filesystem::path& path, std::uint64_t sourceHash,
+                         const std::filesystem::path& modelDirectory) -> std::optional<BakedModel>;
+
+        /**
+         * Returns views of the meshes contained in the file. They stay valid for as long as
+         * this object lives. The geometry of compressed meshes is empty until they are decoded
+         * @returns mesh views
+         * */
+        [[nodiscard]]
+        auto getMeshes() const -> std::span<const MeshView> { return m_Meshes; }
+
+        /**
+         * Returns the placements of the meshes, in the order they were written. Their
+         * transforms are not stored, they come from the scene once it is updated
+         * @returns mesh instances
+         * */
+        [[nodiscard]]
+        auto getInstances() const -> std::span<const MeshInstance> { return m_Instances; }
+
+        /**
+         * Returns the scene nodes the instances are attached to, not updated yet
+         * */
+        [[nodiscard]]
+        auto getScene() const -> const SceneGraph& { return m_Scene; }
+
+        /**
+         * Returns the size of the geometry of a mesh, decoded or not
+         * @param mesh index into getMeshes()
+         * */
+        [[nodiscard]]
+        auto getGeometrySize(std::size_t mesh) const -> GeometrySize;
+
+        /**
+         * Returns the vertices of a mesh in the given format with its packed tangents, laid out as they are
+         * uploaded. They are encoded when the file is written, so loading does not quantize them again.
+         * Empty for compressed meshes until they are decoded in that format
+         * @param mesh index into getMeshes()
+         * @param format layout of the vertices
+         * */
+        [[nodiscard]]
+        auto getVertices(std::size_t mesh, VertexFormat format) const -> VertexView;
+
+        /**
+         * Decodes the compressed geometry of a mesh into client memory and points its view at it. Only the
+         * indices, the packed tangents and the vertices in the given format are decoded, see getVertices(). Does nothing
+         * for mapped or already decoded meshes. Different meshes may be decoded from different threads at once
+         * @param mesh index into getMeshes()
+         * @param format layout of the vertices to decode
+         * @throws std::runtime_error if the compressed streams are corrupted
+         * */
+        auto decode(std::size_t mesh, VertexFormat format = VertexFormat::STANDARD) -> void;
+
+        /**
+         * Drops the vertices and indices of a mesh from physical memory once they are uploaded. Mapped
+         * data stays valid but reading it goes back to the file, decoded data is freed along with its view
+         * @param mesh index into getMeshes()
+         * */
+        auto evict(std::size_t mesh) -> void;
+
+    private:
+        struct FileHeader {
+            std::array<char, 4> magic{};
+            std::uint32_t       version{};
+            std::uint64_t       sourceHash{};
+            std::uint32_t       meshCount{};
+            std::uint32_t       textureCount{};
+            std::uint32_t       lodCount{};
+            std::uint32_t       meshletCount{};
+            std::uint32_t       instanceCount{};
+            std::uint32_t       nodeCount{};
+            std::uint32_t       vertexStride{};     // bytes per vertex
+            std::uint32_t       stringBytes{};      // size of the texture path and node name blob
+            std::uint32_t       geometryEncoding{}; // s_RawGeometry or s_EncodedGeometry
+            std::uint32_t       reserved{};
+        };
+
+        struct MeshRecord {
+            std::uint64_t vertexOffset{};           // offset in bytes from the start of the file
+            std::uint64_t vertexCount{};            // amount of floats
+            std::uint64_t indexOffset{};            // offset in bytes from the start of the file
+            std::uint64_t indexCount{};
+            std::uint64_t tangentOffset{};          // offset in bytes from the start of the file
+            std::uint64_t tangentCount{};           // amount of floats, zero without normal map
+            std::uint64_t vertexBytes{};            // size of each stream in the file, smaller than the data when encoded
+            std::uint64_t indexBytes{};
+            std::uint64_t tangentBytes{};
+            std::uint64_t compactOffset{};          // vertices as kT::VertexFormat::COMPACT, offset in bytes from the start of the file
+            std::uint64_t compactBytes{};
+            std::uint64_t packedTangentOffset{};    // tangents as kT::Mesh::GetTangentLayout(), offset in bytes from the start of the file
+            std::uint64_t packedTangentBytes{};
+            std::uint32_t firstTexture{};
+            std::uint32_t textureCount{};
+            std::uint32_t firstLod{};
+            std::uint32_t lodCount{};
+            std::uint32_t firstMeshlet{};
+            std::uint32_t meshletCount{};
+            float         boundsCenter[3]{};
+            float         boundsRadius{};
+            float         positionOffset[3]{};      // transform of the compact positions
+            float         positionScale[3]{};
+        };
+
+        struct LodRecord {
+            std::uint32_t firstIndex{};             // in the indices of the mesh
+            std::uint32_t indexCount{};
+            float         error{};
+            std::uint32_t reserved{};
+        };
+
+        struct TextureRecord {
+            std::uint32_t type{};
+            std::uint32_t pathOffset{};             // offset in the texture path blob
+            std::uint32_t pathLength{};
+            std::uint32_t reserved{};
+            std::int32_t  rawWidth{};               // dimensions of embedded RGBA texels, zero for encoded images
+            std::int32_t  rawHeight{};
+            std::uint64_t embeddedOffset{};         // offset in bytes from the start of the file of an embedded image
+            std::uint64_t embeddedBytes{};          // zero for image files
+        };
+
+        struct MeshletRecord {
+            std::uint32_t firstIndex{};             // in the indices of the mesh
+            std::uint32_t indexCount{};
+            float         boundsCenter[3]{};
+            float         boundsRadius{};
+            float         coneAxis[3]{};
+            float         coneCutoff{};
+        };
+
+        struct InstanceRecord {
+            std::uint32_t mesh{};                   // index in the mesh table
+            std::uint32_t node{};                   // index in the node table
+        };
+
+        struct NodeRecord {
+            std::uint32_t parent{};                 // earlier index in the node table or kT::SceneGraph::s_NoParent
+            std::uint32_t nameOffset{};             // offset in the string blob
+            std::uint32_t nameLength{};
+            std::uint32_t reserved{};
+            float         local[16]{};              // column major
+        };
+
+        struct DecodedMesh {
+            std::vector<float>          vertices{};
+            std::vector<std::uint32_t>  indices{};
+            std::vector<std::byte>      compact{};
+            std::vector<std::uint32_t>  packedTangents{};
+            bool                        decoded{};  // stays set once the mesh is evicted
+        };
+
+        static constexpr std::array<char, 4> s_Magic{ 'k', 'T', 'M', 'B' };
+        static constexpr std::size_t s_BlobAlignment{ 16 };
+        static constexpr std::uint32_t s_RawGeometry{ 0 };
+        static constexpr std::uint32_t s_EncodedGeometry{ 1 };
+
+        MappedFile              m_File{};
+        std::vector<TextureRef> m_Textures{};
+        std::vector<LodLevel>   m_Lods{};
+        std::vector<Meshlet>    m_Meshlets{};
+        std::vector<MeshView>   m_Meshes{};
+        std::vector<MeshRecord> m_Records{};
+        std::vector<DecodedMesh> m_Decoded{};     // geometry of encoded files, the views point into it once decoded
+        std::uint32_t           m_VertexStride{};
+        std::vector<MeshInstance> m_Instances{};
+        SceneGraph              m_Scene{};
+    };
+}
+
+#endif // BAKED_MODEL_HH
@@ -0,0 +1,124 @@
+/**
+ * @file BakedTexture.hh
+ * @author kT
+ * @brief Defines the baked texture format
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef BAKED_TEXTURE_HH
+#define BAKED_TEXTURE_HH
+
+// C++ Standard Library
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+// Project Libraries
+#include "Texture.hh"
+
+namespace kT {
+    /**
+     * Binary cache of a decoded image file: every level of its mip chain, either as texels with
+     * the channels of the source or block compressed, and the content hash of the source it was decoded from. Loading it skips
+     * the image decoder, the mip generation and the compression. Like a KTX2 file the header is followed
+     * by an index of the levels, each aligned so it can be uploaded straight from the mapping.
+     * Baked files live next to their source, like kT::BakedModel
+     * */
+    class BakedTexture {
+    public:
+        /**
+         * Version of the file format, bump whenever the layout changes
+         * */
+        static constexpr std::uint32_t s_Version{ 4 };
+
+        /**
+         * Extension appended to the source file name
+         * */
+        static constexpr std::string_view s_Extension{ ".kttex" };
+
+        /**
+         * Returns the path of the baked file for the given source image and use. The use picks the color
+         * space of the mips and the block format, so an image used in several ways has one bake for each
+         * @param source path to the source image
+         * @param type use of the texture
+         * @returns path to the baked file
+         * */
+        static auto GetBakePath(const std::filesystem::path& source, Texture::TextureType type = Texture::TextureType::DIFFUSE) -> std::filesystem::path;
+
+        /**
+         * Returns the content hash of the given source file
+         * @param source path to the source image
+         * @returns hash of the file contents
+         * @throws std::runtime_error if the file could not be read
+         * */
+        static auto HashSource(const std::filesystem::path& source) -> std::uint64_t;
+
+        /**
+         * Writes a decoded image and its mip chain to a baked file
+         * @param path path of the baked file
+         * @param sourceHash content hash of the source image
+         * @param image decoded image, its mips are generated first if missing. Compressed images write their blocks
+         * @param srgb whether the mips were filtered in linear space from sRGB colors, see kT::MipGenerator::Generate
+         * @throws std::runtime_error if the file could not be written
+         * */
+        static auto Write(const std::filesystem::path& path, std::uint64_t sourceHash, Texture::ImageData& image, bool srgb = false) -> void;
+
+        /**
+         * Reads a baked file into client memory
+         * @param path path of the baked file
+         * @param sourceHash expected content hash of the source image
+         * @param srgb expected color space of the mips, a bake filtered for the other one is stale
+         * @returns the image with its mip chain, in blocks when compressed and pointing back at the file, or std::nullopt if it is missing, stale or corrupted
+         * */
+        static auto Open(const std::filesystem::path& path, std::uint64_t sourceHash, bool srgb = false) -> std::optional<Texture::ImageData>;
+
+        /**
+         * Decodes an image file with its mip chain, from its baked file if it is up to date and its format
+         * is supported by the driver, see kT::Texture::isFormatSupported. Without an up to date baked file the mips are
+         * generated and an uncompressed one is written, so the next run loads them. Safe to call from worker threads
+         * @param source path to the source image
+         * @param type use of the texture, diffuse maps have their mips filtered in linear space
+         * @returns decoded image with its mip chain
+         * @throws std::runtime_error if the file could not be decoded
+         * */
+        static auto Decode(const std::filesystem::path& source, Texture::TextureType type = Texture::TextureType::DIFFUSE) -> Texture::ImageData;
+
+        /**
+         * Decodes an image file, generates its mip chain with the Kaiser filter and writes its baked file
+         * @param source path to the source image
+         * @param type use of the texture, picks the color space of the mips and the block format, see kT::TextureCompressor::ChooseFormat
+         * @param compress whether to block compress the levels or keep them RGBA
+         * @returns format of the baked levels
+         * @throws std::runtime_error if the file could not be decoded or written
+         * */
+        static auto Bake(const std::filesystem::path& source, Texture::TextureType type = Texture::TextureType::DIFFUSE, bool compress = true) -> Texture::PixelFormat;
+
+    private:
+        struct FileHeader {
+            std::array<char, 4> magic{};
+            std::uint32_t       version{};
+            std::uint64_t       sourceHash{};
+            std::int32_t        width{};
+            std::int32_t        height{};
+            std::int32_t        channels{};     // components per texel of uncompressed levels, as in the source image
+            std::int32_t        levels{};
+            std::uint32_t       format{};       // kT::Texture::PixelFormat of every level
+            std::uint32_t       srgb{};         // non zero if the mips were filtered in linear space
+        };
+
+        // follows the header, one per level from the base down
+        struct LevelRecord {
+            std::uint64_t       offset{};       // from the start of the file
+            std::uint64_t       bytes{};
+        };
+
+        static constexpr std::size_t s_LevelAlignment{ 16 };
+
+        static constexpr std::array<char, 4> s_Magic{ 'k', 'T', 'T', 'X' };
+    };
+}
+
+#endif // BAKED_TEXTURE_HH
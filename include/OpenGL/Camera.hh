@@ -113,6 +113,15 @@ namespace kT {
          * */
         auto getPosition() const -> const glm::vec3&;
 
+        /**
+         * Returns the height in pixels of an object of the given size seen at the given distance
+         * @param worldSize size of the object in world units
+         * @param distance distance from the camera to the object in world units
+         * @returns projected size in pixels
+         * */
+        [[nodiscard]]
+        auto getScreenSize(float worldSize, float distance) const -> float;
+
     private:
         /**
          *
@@ -153,6 +162,9 @@ namespace kT {
 
         double m_Fov{};
 
+        // height in pixels of the viewport the projection was computed for
+        float m_ViewportHeight{};
+
         std::pair<double, double> m_LastCursorPosition{};
     };
 }
@@ -11,6 +11,8 @@
 
 // C++ Standard Library
 #include <vector>
+#include <span>
+#include <cstddef>
 #include <cstdint>
 
 // Third-Party Libraries
@@ -27,6 +29,12 @@ namespace kT {
          * */
         explicit ElementBuffer(const std::vector<std::uint32_t> &indices, GLenum usage = GL_STATIC_DRAW);
 
+        /**
+         * Creates a new Vertex index buffer and initializes it with the data from indices
+         * @param indices view of the indices values, may point to memory mapped data
+         * */
+        explicit ElementBuffer(std::span<const std::uint32_t> indices, GLenum usage = GL_STATIC_DRAW);
+
         /**
          * Mark this Vertex index buffer as current
          * */
@@ -74,6 +82,32 @@ namespace kT {
         static auto unbind() -> void;
 
         auto load(const std::vector<std::uint32_t> &indices, GLenum usage = GL_STATIC_DRAW) -> void;
+        auto load(std::span<const std::uint32_t> indices, GLenum usage = GL_STATIC_DRAW) -> void;
+
+        /**
+         * Allocates immutable storage for the given amount of indices, left uninitialized.
+         * Its contents can only be written through update() afterwards, or through getMapped() if mapped
+         * @param count amount of indices
+         * @param mapped keep the storage persistently mapped for writing, if ARB_buffer_storage is available
+         * */
+        auto reserve(std::size_t count, bool mapped = false) -> void;
+
+        /**
+         * Returns the persistently mapped storage, empty if the buffer is not mapped. The mapping is
+         * coherent, so writes are seen by OpenGL without flushing, from any thread
+         * */
+        [[nodiscard]]
+        auto getMapped() const -> std::span<std::byte> { return { m_Mapped, m_Mapped != nullptr ? m_Count * sizeof(std::uint32_t) : 0 }; }
+
+        /**
+         * Overwrites part of the buffer contents. Binds the buffer, so no
+         * Vertex Array Object may be bound while calling it. 16 and 32 bit
+         * indices may share a buffer as long as each is aligned to its size
+         * @param offset offset in bytes from the start of the buffer
+         * @param indices data to be copied
+         * */
+        auto update(std::size_t offset, std::span<const std::uint32_t> indices) const -> void;
+        auto update(std::size_t offset, std::span<const std::uint16_t> indices) const -> void;
 
         /**
          * Releases resources from this Vertex index buffer
@@ -81,8 +115,11 @@ namespace kT {
         ~ElementBuffer();
 
     private:
+        auto update(std::size_t offset, const void* data, std::size_t bytes) const -> void;
+
         std::uint32_t m_Id{};
         std::size_t m_Count{};
+        std::byte* m_Mapped{};
     };
 }
 
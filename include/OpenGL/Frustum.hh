@@ -0,0 +1,52 @@
+/**
+ * @file Frustum.hh
+ * @author kT
+ * @brief Defines the view frustum used for culling
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef FRUSTUM_HH
+#define FRUSTUM_HH
+
+// C++ Standard Library
+#include <array>
+
+// Third-Party Libraries
+#include <glm/glm.hpp>
+
+// Project Libraries
+#include "MeshData.hh"
+
+namespace kT {
+    /**
+     * Six planes bounding what a projection matrix can see. Planes extracted from
+     * projection * view * model are in model space, so bounds can be tested without transforming them
+     * */
+    class Frustum {
+    public:
+        /**
+         * Default constructs a frustum that contains everything
+         * */
+        explicit Frustum() = default;
+
+        /**
+         * Extracts the planes of the given matrix (Gribb and Hartmann)
+         * @param matrix clip space transform, the planes are in the space it maps from
+         * */
+        explicit Frustum(const glm::mat4& matrix);
+
+        /**
+         * Returns false if the sphere is entirely outside one of the planes
+         * @param sphere sphere in the space the planes are in
+         * */
+        [[nodiscard]]
+        auto intersects(const BoundingSphere& sphere) const -> bool;
+
+    private:
+        // xyz is the unit normal pointing inside, w the distance to the origin
+        std::array<glm::vec4, 6> m_Planes{};
+    };
+}
+
+#endif // FRUSTUM_HH
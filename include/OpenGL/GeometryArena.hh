@@ -0,0 +1,228 @@
+/**
+ * @file GeometryArena.hh
+ * @author kT
+ * @brief Defines the shared vertex and index buffer arena
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef GEOMETRY_ARENA_HH
+#define GEOMETRY_ARENA_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+// Project Libraries
+#include "ElementBuffer.hh"
+#include "MeshData.hh"
+#include "VertexArray.hh"
+#include "VertexBuffer.hh"
+
+namespace kT {
+    /**
+     * Suballocates the vertices and indices of every mesh out of a few large immutable
+     * buffers. Each block pairs one vertex buffer and one index buffer with a vertex array
+     * configured once, so drawing any range of a block only needs that block bound.
+     * A block stores a single kT::VertexFormat, while 16 and 32 bit indices share the index buffers.
+     * Blocks created for meshes with tangents carry a second vertex buffer for the tangent stream, indexed like the vertices.
+     * Blocks stay persistently mapped when the driver allows it, so uploads write straight into
+     * GPU visible memory instead of going through glBufferSubData staging copies.
+     * Must only be used from the thread owning the OpenGL context
+     * */
+    class GeometryArena {
+    public:
+        /**
+         * Part of a block. Vertices are counted in vertices of the block format, indices in bytes
+         * */
+        struct Range {
+            std::uint32_t block{};
+            std::uint32_t firstVertex{};
+            std::uint32_t vertexCount{};
+            std::uint32_t indexOffset{};
+            std::uint32_t indexBytes{};
+        };
+
+        /**
+         * Owns a range of the arena, which is released when the allocation is destroyed
+         * */
+        class Allocation {
+        public:
+            Allocation() = default;
+            explicit Allocation(const Range& range) : m_Range{ range }, m_Valid{ true } {}
+
+            Allocation(Allocation&& other) noexcept;
+            auto operator=(Allocation&& other) noexcept -> Allocation&;
+
+            Allocation(const Allocation& other) = delete;
+            auto operator=(const Allocation& other) -> Allocation& = delete;
+
+            [[nodiscard]]
+            auto getRange() const -> const Range& { return m_Range; }
+
+            [[nodiscard]]
+            auto isValid() const -> bool { return m_Valid; }
+
+            ~Allocation();
+
+        private:
+            Range   m_Range{};
+            bool    m_Valid{};
+        };
+
+        /**
+         * Usage of the arena. Fragmentation is the share of free space that
+         * lies outside the largest free range, from 0 to 1
+         * */
+        struct Stats {
+            std::size_t blocks{};
+            std::size_t allocations{};
+            std::size_t vertexBytesUsed{};
+            std::size_t vertexBytesCapacity{};
+            std::size_t indexBytesUsed{};
+            std::size_t indexBytesCapacity{};
+            float       vertexFragmentation{};
+            float       indexFragmentation{};
+        };
+
+        /**
+         * Size in bytes of the vertex and index buffers of a new block. Bigger requests get a block of their own
+         * */
+        static constexpr std::size_t s_BlockVertexBytes{ 32 << 20 };
+        static constexpr std::size_t s_BlockIndexBytes{ 16 << 20 };
+
+        /**
+         * Alignment of index ranges, enough for either index type
+         * */
+        static constexpr std::size_t s_IndexAlignment{ sizeof(std::uint32_t) };
+
+        /**
+         * Returns the narrowest index type able to address the given amount of vertices
+         * @param vertexCount amount of vertices of the mesh
+         * @returns GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+         * */
+        static constexpr auto GetIndexType(std::size_t vertexCount) -> GLenum {
+            return vertexCount <= std::size_t{ UINT16_MAX } + 1 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        }
+
+        /**
+         * Returns the bytes taken by the indices of a mesh, padded to kT::GeometryArena::s_IndexAlignment
+         * @param vertexCount amount of vertices of the mesh
+         * @param indexCount amount of indices of the mesh
+         * @returns size of the index range in bytes
+         * */
+        static constexpr auto GetIndexBytes(std::size_t vertexCount, std::size_t indexCount) -> std::size_t {
+            const std::size_t bytes{ indexCount * (GetIndexType(vertexCount) == GL_UNSIGNED_SHORT ? sizeof(std::uint16_t) : sizeof(std::uint32_t)) };
+            return (bytes + s_IndexAlignment - 1) / s_IndexAlignment * s_IndexAlignment;
+        }
+
+        /**
+         * Reserves a contiguous range of vertices and indices, creating a new block if none has room
+         * @param format layout of the vertices
+         * @param vertexCount amount of vertices
+         * @param indexBytes size of the indices in bytes, see kT::GeometryArena::GetIndexBytes()
+         * @param tangents reserve room in the tangent stream as well, laid out as kT::Mesh::GetTangentLayout()
+         * @returns the reserved range
+         * */
+        static auto Allocate(VertexFormat format, std::size_t vertexCount, std::size_t indexBytes, bool tangents = false) -> Allocation;
+
+        /**
+         * Chooses whether blocks created from now on are persistently mapped. Enabled by default,
+         * disabling it falls back to glBufferSubData uploads, e.g. to compare both paths
+         * */
+        static auto SetPersistentMapping(bool enable) -> void { s_PersistentMapping = enable; }
+
+        /**
+         * Copies vertices and indices into a part of an allocated range. Mapped blocks
+         * receive them directly, narrowing the indices in place when needed
+         * @param range destination, vertices start at firstVertex and indices at indexOffset
+         * @param vertices interleaved vertices in the format of the block
+         * @param tangents tangent stream of the vertices, may be empty. Ignored by blocks without one
+         * @param indices indices relative to the first vertex of the range
+         * @param indexType type the indices are stored as, narrowed if GL_UNSIGNED_SHORT
+         * */
+        static auto Upload(const Range& range, std::span<const std::byte> vertices, std::span<const std::byte> tangents,
+                           std::span<const std::uint32_t> indices, GLenum indexType) -> void;
+
+        /**
+         * Binds the vertex array of the given block
+         * @param block index of the block
+         * */
+        static auto Bind(std::uint32_t block) -> void;
+
+        [[nodiscard]]
+        static auto GetStats() -> Stats;
+
+        /**
+         * Destroys the blocks holding no allocation, giving their memory back
+         * */
+        static auto Trim() -> void;
+
+        /**
+         * Destroys every block, call it while the OpenGL context is still current.
+         * Allocations still alive afterwards release nothing when destroyed
+         * */
+        static auto ShutDown() -> void;
+
+    private:
+        /**
+         * Free ranges of a block, keyed by offset. Adjacent ranges are merged on release
+         * */
+        class FreeList {
+        public:
+            explicit FreeList(std::size_t capacity) : m_Capacity{ capacity } { m_Ranges.emplace(0, capacity); }
+
+            auto allocate(std::size_t count) -> std::optional<std::size_t>;
+            auto release(std::size_t offset, std::size_t count) -> void;
+
+            [[nodiscard]]
+            auto getFree() const -> std::size_t;
+
+            [[nodiscard]]
+            auto getFragmentation() const -> float;
+
+            [[nodiscard]]
+            auto getCapacity() const -> std::size_t { return m_Capacity; }
+
+        private:
+            std::map<std::size_t, std::size_t>  m_Ranges{};
+            std::size_t                         m_Capacity{};
+        };
+
+        struct Block {
+            VertexFormat    format;
+            std::size_t     stride;
+            std::size_t     tangentStride;      // zero without tangent stream
+            VertexBuffer    vertices;
+            VertexBuffer    tangents;
+            ElementBuffer   indices;
+            VertexArray     vertexArray;
+            FreeList        freeVertices;       // in vertices
+            FreeList        freeIndices;        // in bytes
+            std::size_t     allocations{};
+            GLsync          releaseFence{};     // commands issued before the last release, mapped blocks wait on it before reusing a range
+
+            Block(VertexFormat vertexFormat, std::size_t vertexCount, std::size_t indexBytes, bool hasTangents);
+            Block(const Block& other) = delete;
+            auto operator=(const Block& other) -> Block& = delete;
+            ~Block();
+
+            [[nodiscard]]
+            auto isMapped() const -> bool {
+                return !vertices.getMapped().empty() && !indices.getMapped().empty() && (tangentStride == 0 || !tangents.getMapped().empty());
+            }
+        };
+
+        static auto release(const Range& range) -> void;
+
+        static std::vector<std::unique_ptr<Block>> s_Blocks;
+        inline static bool s_PersistentMapping{ true };
+    };
+}
+
+#endif // GEOMETRY_ARENA_HH
@@ -0,0 +1,66 @@
+/**
+ * @file GltfLoader.hh
+ * @author kT
+ * @brief Defines the native glTF 2.0 importer
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef GLTF_LOADER_HH
+#define GLTF_LOADER_HH
+
+// C++ Standard Library
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// Project Libraries
+#include "MeshData.hh"
+#include "SceneGraph.hh"
+
+namespace kT {
+    /**
+     * Imports glTF 2.0 files, both .gltf with external or data URI buffers and binary .glb,
+     * without going through assimp. Buffers are mapped into memory and every accessor is read
+     * from the mapping straight into vertices laid out as kT::Mesh::GetLayout(), one mesh per
+     * primitive, decoded on the worker pool. Images may be files next to the model or embedded in it,
+     * embedded ones are handed out as kT::TextureRef::embedded. Like the assimp import of kT::Model,
+     * meshes referenced by several nodes are imported once and placed by instances, and meshes
+     * without normals get smooth ones. Works on client memory only, so it may run on any thread
+     * */
+    class GltfLoader {
+    public:
+        /**
+         * First four bytes of a binary glTF file, "glTF"
+         * */
+        static constexpr std::uint32_t s_BinaryMagic{ 0x46546C67 };
+
+        /**
+         * Imports the meshes of the scene of the given file
+         * @param path path to the .gltf or .glb file, external buffers and images are looked up relative to its directory
+         * @param scene receives the nodes of the scene, with their local transforms
+         * @param instances receives one instance per node and primitive sorted by mesh, transforms are left to the scene
+         * @returns distinct meshes in the order their nodes are first found walking the scene depth first
+         * @throws std::runtime_error if the file is not valid glTF 2.0 or references missing data
+         * */
+        static auto Load(const std::filesystem::path& path, SceneGraph& scene, std::vector<MeshInstance>& instances) -> std::vector<MeshData>;
+
+        /**
+         * Returns the files besides the model the meshes are read from, its external buffers. Images are not included
+         * @param path path to the .gltf or .glb file
+         * @returns paths of the buffer files referenced by the file
+         * @throws std::runtime_error if the file is not valid glTF 2.0 or references missing buffers
+         * */
+        [[nodiscard]]
+        static auto GetDependencies(const std::filesystem::path& path) -> std::vector<std::filesystem::path>;
+
+        /**
+         * Returns true if the given file is handled by this loader
+         * @param path path to a model file
+         * */
+        [[nodiscard]]
+        static auto IsSupported(const std::filesystem::path& path) -> bool;
+    };
+}
+
+#endif // GLTF_LOADER_HH
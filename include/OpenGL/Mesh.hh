@@ -15,6 +15,7 @@
 #include <span>
 #include <algorithm>
 #include <utility>
+#include <memory>
 
 // Third-Party Libraries
 #include "GL/glew.h"
@@ -27,6 +28,8 @@
 #include "VertexArray.hh"
 #include "VertexBuffer.hh"
 #include "ElementBuffer.hh"
+#include "GeometryArena.hh"
+#include "MeshData.hh"
 
 namespace kT {
     class Mesh {
@@ -37,13 +40,21 @@ namespace kT {
         explicit Mesh() = default;
 
         /**
-         * Initializes this Mesh' vertex, index and texture objects with the
-         * data we pass ass parameters. The parameters data are moved
-         * @param vertices contains the vertex data for this mesh, like positions, texture coordinates, etc.
-         * @param indices contains the indices for indexed drawing
-         * @param textures contains the texture data for this mesh, see kT::Texture for more
+         * Copies the vertex and index data we pass as parameters into the given
+         * range of kT::GeometryArena. The range is owned by the caller and must outlive this mesh. The textures are moved.
+         * Indices are stored 16 bit wide when the mesh has few enough vertices, see kT::GeometryArena::GetIndexType()
+         * @param geometry arena range receiving the data, in a block of the vertex format and sized for vertices and indices
+         * @param vertices contains the vertex data for this mesh, like positions, texture coordinates, etc. laid out as kT::Mesh::GetLayout(),
+         * and its tangents if any, which the range must have room for
+         * @param indices contains the indices for indexed drawing, relative to the first vertex of this mesh
+         * @param lods ranges of indices of every level of detail, the whole index list is a single level if empty
+         * @param bounds sphere enclosing the vertices, in model space
+         * @param meshlets clusters of the full resolution level, may be empty
+         * @param textures contains the textures for this mesh, shared with other meshes through kT::TextureCache
          * */
-        explicit Mesh(const std::vector<float> &vertices, const std::vector<std::uint32_t> &indices, std::vector<Texture> &&textures);
+        explicit Mesh(const GeometryArena::Range& geometry, const VertexView& vertices, std::span<const std::uint32_t> indices,
+                      std::span<const LodLevel> lods, const BoundingSphere& bounds, std::span<const Meshlet> meshlets,
+                      std::vector<std::shared_ptr<Texture>> &&textures);
 
         /**
          * Constructs and initializes this mesh with the contents of the other
@@ -60,14 +71,69 @@ namespace kT {
          * */
         auto operator=(Mesh&& other) noexcept -> Mesh&;
 
-        auto getVertexBuffer() const -> const VertexBuffer& { return m_VertexBuffer; }
-        auto getIndexBuffer() const -> const ElementBuffer& { return m_ElementBuffer; }
-        auto getTextures() const -> const std::vector<Texture>& { return m_Textures; }
+        /**
+         * Returns where the vertices and indices of this mesh live in kT::GeometryArena
+         * */
+        auto getGeometry() const -> const GeometryArena::Range& { return m_Geometry; }
+        auto getTextures() const -> const std::vector<std::shared_ptr<Texture>>& { return m_Textures; }
+
+        /**
+         * Returns the transform from stored positions to model space, the identity unless the format is compact
+         * */
+        auto getPositionTransform() const -> const PositionTransform& { return m_PositionTransform; }
+        auto getVertexFormat() const -> VertexFormat { return m_VertexFormat; }
 
-        auto getVertexCount() const -> std::size_t { return m_VertexBuffer.getCount(); }
-        auto getIndexCount() const -> std::size_t { return m_ElementBuffer.getCount(); }
+        /**
+         * Returns true if the tangent stream of the mesh was uploaded, see kT::TangentGenerator
+         * */
+        auto hasTangents() const -> bool { return m_HasTangents; }
+
+        /**
+         * Returns GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+         * */
+        auto getIndexType() const -> GLenum { return m_IndexType; }
+
+        auto getVertexCount() const -> std::size_t { return m_Geometry.vertexCount; }
+        auto getIndexCount() const -> std::size_t { return m_IndexCount; }
+
+        /**
+         * Returns the levels of detail of this mesh, from full resolution to coarsest.
+         * Their indices live in the geometry range of the mesh, one level after the other
+         * */
+        auto getLods() const -> const std::vector<LodLevel>& { return m_Lods; }
+        auto getLodCount() const -> std::size_t { return m_Lods.size(); }
+        auto getBounds() const -> const BoundingSphere& { return m_Bounds; }
+
+        /**
+         * Returns the texture coordinate units spanned by one model unit of the surface, averaged over the full resolution
+         * triangles. Tells how many texels of its textures cover a given screen area, see kT::TextureStreamer
+         * */
+        auto getTexelDensity() const -> float { return m_TexelDensity; }
+
+        /**
+         * Returns the clusters the full resolution level is split into, empty if it is drawn whole
+         * */
+        auto getMeshlets() const -> const std::vector<Meshlet>& { return m_Meshlets; }
         auto getTextureCount() const -> std::size_t { return m_Textures.size(); }
 
+        /**
+         * Returns the buffer layout of the vertices of the given format
+         * */
+        static auto GetLayout(VertexFormat format = VertexFormat::STANDARD) -> const BufferLayout& {
+            return format == VertexFormat::COMPACT ? s_CompactLayout : s_Layout;
+        }
+
+        /**
+         * Returns the layout of the optional tangent stream, kept apart from the
+         * interleaved vertices so meshes without normal maps do not pay for it
+         * */
+        static auto GetTangentLayout() -> const BufferLayout& { return s_TangentLayout; }
+
+        /**
+         * Attribute location of the tangent stream, the ones before are the vertex layout and the instance transform
+         * */
+        static constexpr std::uint32_t s_TangentAttribute{ 7 };
+
         /**
          * Frees resources owned by this mesh
          * */
@@ -81,9 +147,29 @@ namespace kT {
                 {ShaderDataType::FLOAT2_TYPE, "Attribute_Texture_Coordinates"},
         };
 
-        std::vector<Texture> m_Textures{};
-        VertexBuffer m_VertexBuffer{};
-        ElementBuffer  m_ElementBuffer{};
+        // quantized mesh data Layout, see kT::VertexQuantizer
+        inline static BufferLayout s_CompactLayout{
+                {ShaderDataType::USHORT4_TYPE, "Attribute_Position", true},
+                {ShaderDataType::INT_2_10_10_10_REV_TYPE, "Attribute_Normal", true},
+                {ShaderDataType::HALF2_TYPE, "Attribute_Texture_Coordinates"},
+        };
+
+        // tangent and handedness, in either vertex format
+        inline static BufferLayout s_TangentLayout{
+                {ShaderDataType::INT_2_10_10_10_REV_TYPE, "Attribute_Tangent", true},
+        };
+
+        std::vector<std::shared_ptr<Texture>> m_Textures{};
+        GeometryArena::Range m_Geometry{};
+        VertexFormat m_VertexFormat{ VertexFormat::STANDARD };
+        PositionTransform m_PositionTransform{};
+        std::size_t m_IndexCount{};
+        std::vector<LodLevel> m_Lods{};
+        BoundingSphere m_Bounds{};
+        float m_TexelDensity{};
+        std::vector<Meshlet> m_Meshlets{};
+        GLenum m_IndexType{ GL_UNSIGNED_INT };
+        bool m_HasTangents{};
 
     };
 }
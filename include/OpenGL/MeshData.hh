@@ -0,0 +1,152 @@
+/**
+ * @file MeshData.hh
+ * @author kT
+ * @brief Defines the CPU side representation of meshes
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef MESH_DATA_HH
+#define MESH_DATA_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Third-Party Libraries
+#include <glm/glm.hpp>
+
+// Project Libraries
+#include "Texture.hh"
+
+namespace kT {
+    /**
+     * Vertex layouts a kT::Mesh may be stored with, see kT::Mesh::GetLayout()
+     * */
+    enum class VertexFormat {
+        STANDARD,   // float3 position, float3 normal, float2 texture coordinates, 32 bytes
+        COMPACT,    // unorm16 position within the mesh bounds, snorm 2_10_10_10 normal, half2 texture coordinates, 16 bytes
+    };
+
+    /**
+     * Maps stored positions back to model space: position = offset + stored * scale
+     * */
+    struct PositionTransform {
+        glm::vec3 offset{ 0.0f };
+        glm::vec3 scale{ 1.0f };
+    };
+
+    /**
+     * Non owning view of vertices encoded in one of the kT::VertexFormat layouts
+     * */
+    struct VertexView {
+        VertexFormat                format{ VertexFormat::STANDARD };
+        std::span<const std::byte>  data{};
+        PositionTransform           transform{};
+        std::span<const std::byte>  tangents{};     // optional stream laid out as kT::Mesh::GetTangentLayout()
+    };
+
+    /**
+     * Texture file referenced by a mesh material. Images stored inside the model file
+     * carry their bytes, their path then only names them for the texture cache. Those
+     * bytes are an encoded file, or RGBA texels ready for kT::Texture::fromData() when rawSize is set
+     * */
+    struct TextureRef {
+        std::filesystem::path   path{};
+        Texture::TextureType    type{};
+        std::shared_ptr<const std::vector<std::byte>> embedded{};     // encoded image (PNG, JPEG...) or texels, null for image files
+        Texture::Dimensions     rawSize{};                            // width and height of raw texels, zero for encoded images
+
+        [[nodiscard]]
+        auto isRaw() const -> bool { return embedded != nullptr && rawSize.first > 0 && rawSize.second > 0; }
+    };
+
+    /**
+     * Level of detail of a mesh. Every level is a range of the mesh indices
+     * referencing the same vertices, level 0 being the full resolution one
+     * */
+    struct LodLevel {
+        std::uint32_t   firstIndex{};
+        std::uint32_t   indexCount{};
+        float           error{};        // distance to the full resolution surface, in model units
+    };
+
+    /**
+     * Sphere enclosing every vertex of a mesh, in model units
+     * */
+    struct BoundingSphere {
+        glm::vec3   center{ 0.0f };
+        float       radius{};
+    };
+
+    /**
+     * Cluster of neighbouring triangles of the full resolution level of a mesh, see kT::MeshletBuilder.
+     * Its triangles are a contiguous range of the mesh indices. The cone bounds the normals of the
+     * triangles: all of them face away from a viewer at eye when
+     * dot(bounds.center - eye, coneAxis) >= coneCutoff * length(bounds.center - eye) + bounds.radius
+     * */
+    struct Meshlet {
+        std::uint32_t   firstIndex{};
+        std::uint32_t   indexCount{};
+        BoundingSphere  bounds{};
+        glm::vec3       coneAxis{ 0.0f };
+        float           coneCutoff{ 1.0f };  // sine of the cone angle, 1 never culls
+    };
+
+    /**
+     * CPU side data of an imported mesh. Vertices are interleaved
+     * following the kT::Mesh buffer layout. The indices hold every
+     * level of detail one after the other, see kT::MeshSimplifier.
+     * Meshes with a normal map also carry one tangent per vertex, see kT::TangentGenerator
+     * */
+    struct MeshData {
+        std::vector<float>          vertices{};
+        std::vector<std::uint32_t>  indices{};
+        std::vector<float>          tangents{};     // xyz tangent and w handedness, empty without normal map
+        std::vector<TextureRef>     textures{};
+        std::vector<LodLevel>       lods{};
+        std::vector<Meshlet>        meshlets{};
+        BoundingSphere              bounds{};
+    };
+
+    /**
+     * Placement of a mesh in its model. A mesh referenced by several nodes of the
+     * source file is stored once and placed by one instance per node
+     * */
+    struct MeshInstance {
+        std::uint32_t   mesh{};                 // index into the meshes of the model
+        std::uint32_t   node{};                 // kT::SceneGraph node the mesh is attached to
+        glm::mat4       transform{ 1.0f };      // node to model space, every parent node applied
+    };
+
+    /**
+     * Non owning view of mesh data ready to be uploaded. The data may live
+     * in a kT::MeshData or directly in a memory mapped baked asset
+     * */
+    struct MeshView {
+        std::span<const float>          vertices{};
+        std::span<const std::uint32_t>  indices{};
+        std::span<const float>          tangents{};
+        std::span<const TextureRef>     textures{};
+        std::span<const LodLevel>       lods{};
+        std::span<const Meshlet>        meshlets{};
+        BoundingSphere                  bounds{};
+
+        MeshView() = default;
+
+        MeshView(std::span<const float> vertexData, std::span<const std::uint32_t> indexData, std::span<const float> tangentData,
+                 std::span<const TextureRef> textureRefs, std::span<const LodLevel> lodLevels, std::span<const Meshlet> clusters, const BoundingSphere& sphere)
+            :   vertices{ vertexData }, indices{ indexData }, tangents{ tangentData }, textures{ textureRefs }, lods{ lodLevels },
+                meshlets{ clusters }, bounds{ sphere } {}
+
+        explicit MeshView(const MeshData& data)
+            :   vertices{ data.vertices }, indices{ data.indices }, tangents{ data.tangents }, textures{ data.textures }, lods{ data.lods },
+                meshlets{ data.meshlets }, bounds{ data.bounds } {}
+    };
+}
+
+#endif // MESH_DATA_HH
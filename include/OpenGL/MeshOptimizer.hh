@@ -0,0 +1,108 @@
+/**
+ * @file MeshOptimizer.hh
+ * @author kT
+ * @brief Defines the mesh optimization pass
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef MESH_OPTIMIZER_HH
+#define MESH_OPTIMIZER_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Project Libraries
+#include "MeshData.hh"
+
+namespace kT {
+    /**
+     * Reorders the triangles and vertices of imported meshes so they render faster: triangles
+     * are sorted for post transform cache locality, then clustered and sorted again to cut
+     * overdraw, and last the vertices are laid out in the order they are first fetched.
+     * Works on client memory only, so it may run on any thread
+     * */
+    class MeshOptimizer {
+    public:
+        /**
+         * Post transform cache efficiency of an index buffer. ACMR is the average cache miss ratio,
+         * vertex shader invocations per triangle, and ATVR is the invocations per referenced vertex.
+         * Lower is better for both, ATVR bottoms out at 1
+         * */
+        struct CacheStats {
+            float acmr{};
+            float atvr{};
+        };
+
+        /**
+         * Cache efficiency of a mesh before and after kT::MeshOptimizer::Optimize()
+         * */
+        struct Report {
+            CacheStats  before{};
+            CacheStats  after{};
+            bool        optimized{};    // false if the mesh was left untouched
+        };
+
+        /**
+         * Entries of the FIFO cache simulated for kT::MeshOptimizer::CacheStats
+         * */
+        static constexpr std::uint32_t s_CacheSize{ 16 };
+
+        /**
+         * How much the ACMR of a cluster may exceed the one of the triangles it was split from
+         * */
+        static constexpr float s_OverdrawThreshold{ 1.05f };
+
+        /**
+         * Runs every stage of the pass on the given mesh. Meshes that are not
+         * made of triangles or reference missing vertices are left untouched
+         * @param mesh imported mesh laid out as kT::Mesh::GetLayout()
+         * @returns the cache efficiency before and after
+         * */
+        static auto Optimize(MeshData& mesh) -> Report;
+
+        /**
+         * Simulates a FIFO post transform cache over the given triangles
+         * @param indices triangle list
+         * @param vertexCount amount of vertices the indices refer to
+         * @param cacheSize entries of the simulated cache
+         * @returns the cache efficiency of the index buffer
+         * */
+        static auto AnalyzeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount,
+                                       std::uint32_t cacheSize = s_CacheSize) -> CacheStats;
+
+        /**
+         * Reorders triangles for post transform cache locality, following
+         * Tom Forsyth's linear speed vertex cache optimisation
+         * @param indices triangle list
+         * @param vertexCount amount of vertices the indices refer to
+         * @returns the reordered triangle list
+         * */
+        static auto OptimizeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount) -> std::vector<std::uint32_t>;
+
+        /**
+         * Splits a cache optimized triangle list into clusters and sorts them so the ones facing
+         * away from the center of the mesh are drawn first, which lets them occlude the rest
+         * @param indices triangle list, expected to be cache optimized
+         * @param vertices interleaved vertices, positions are the first three floats of each
+         * @param floatsPerVertex amount of floats of each vertex
+         * @param threshold how much the cache efficiency of a cluster may degrade to allow splitting it
+         * @returns the reordered triangle list
+         * */
+        static auto OptimizeOverdraw(std::span<const std::uint32_t> indices, std::span<const float> vertices,
+                                     std::size_t floatsPerVertex, float threshold = s_OverdrawThreshold) -> std::vector<std::uint32_t>;
+
+        /**
+         * Lays out the vertices in the order the indices first reference them and
+         * rewrites the indices to match. Vertices not referenced are dropped
+         * @param mesh mesh to be reordered
+         * @param floatsPerVertex amount of floats of each vertex
+         * */
+        static auto OptimizeVertexFetch(MeshData& mesh, std::size_t floatsPerVertex) -> void;
+    };
+}
+
+#endif // MESH_OPTIMIZER_HH
@@ -0,0 +1,85 @@
+/**
+ * @file MeshSimplifier.hh
+ * @author kT
+ * @brief Defines the level of detail generator
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef MESH_SIMPLIFIER_HH
+#define MESH_SIMPLIFIER_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+// Project Libraries
+#include "MeshData.hh"
+
+namespace kT {
+    /**
+     * Builds levels of detail by collapsing edges in order of their quadric error (Garland and Heckbert).
+     * Vertices are only ever collapsed onto other existing vertices, so every level reuses the vertex
+     * buffer of the full resolution mesh and only adds indices. Vertices on open borders and on attribute
+     * seams are never removed, which keeps the silhouette and the texture mapping in place.
+     * Works on client memory only, so it may run on any thread
+     * */
+    class MeshSimplifier {
+    public:
+        /**
+         * Indices of a simplified mesh and its deviation from the input
+         * */
+        struct Result {
+            std::vector<std::uint32_t>  indices{};
+            float                       error{};    // in model units
+        };
+
+        /**
+         * Maximum amount of levels, the full resolution one included
+         * */
+        static constexpr std::size_t s_MaxLevels{ 4 };
+
+        /**
+         * Triangles kept by every level with respect to the previous one
+         * */
+        static constexpr float s_LevelRatio{ 0.5f };
+
+        /**
+         * A level reducing the triangles of the previous one by less than this is not worth storing
+         * */
+        static constexpr float s_MinReduction{ 0.85f };
+
+        /**
+         * Simplifies a triangle list
+         * @param indices triangle list
+         * @param vertices interleaved vertices, positions are the first three floats of each
+         * @param floatsPerVertex amount of floats of each vertex
+         * @param targetIndexCount stop once the result has this many indices or fewer
+         * @param maxError stop before collapses deviating further than this, in model units
+         * @returns the simplified triangle list
+         * */
+        static auto Simplify(std::span<const std::uint32_t> indices, std::span<const float> vertices, std::size_t floatsPerVertex,
+                             std::size_t targetIndexCount, float maxError = std::numeric_limits<float>::max()) -> Result;
+
+        /**
+         * Fills the levels of detail of the given mesh, appending the indices of the simplified levels.
+         * Meshes that do not simplify enough end up with a single level
+         * @param mesh imported mesh laid out as kT::Mesh::GetLayout()
+         * @param generate if false only the full resolution level is set
+         * */
+        static auto GenerateLods(MeshData& mesh, bool generate = true) -> void;
+
+        /**
+         * Returns a sphere enclosing the given vertices
+         * @param vertices interleaved vertices, positions are the first three floats of each
+         * @param floatsPerVertex amount of floats of each vertex
+         * @returns the bounding sphere
+         * */
+        static auto ComputeBounds(std::span<const float> vertices, std::size_t floatsPerVertex) -> BoundingSphere;
+    };
+}
+
+#endif // MESH_SIMPLIFIER_HH
@@ -0,0 +1,62 @@
+/**
+ * @file MeshletBuilder.hh
+ * @author kT
+ * @brief Defines the meshlet clustering of imported meshes
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef MESHLET_BUILDER_HH
+#define MESHLET_BUILDER_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Project Libraries
+#include "MeshData.hh"
+
+namespace kT {
+    /**
+     * Splits the full resolution level of a mesh into small clusters of connected triangles so the renderer
+     * can cull the parts of a dense mesh that are off screen or facing away. Triangles are regrouped
+     * in place, so the clusters are ranges of the mesh indices and need no extra GPU memory.
+     * Works on client memory only, so it may run on any thread
+     * */
+    class MeshletBuilder {
+    public:
+        /**
+         * Maximum amount of distinct vertices referenced by a meshlet
+         * */
+        static constexpr std::size_t s_MaxVertices{ 64 };
+
+        /**
+         * Maximum amount of triangles of a meshlet
+         * */
+        static constexpr std::size_t s_MaxTriangles{ 124 };
+
+        /**
+         * Meshes with fewer triangles than this are drawn whole, culling them per cluster costs more than it saves
+         * */
+        static constexpr std::size_t s_MinTriangles{ 4 * s_MaxTriangles };
+
+        /**
+         * Fills the meshlets of the given mesh, reordering the triangles of its full resolution level
+         * @param mesh imported mesh laid out as kT::Mesh::GetLayout()
+         * */
+        static auto Build(MeshData& mesh) -> void;
+
+        /**
+         * Computes the bounds and the normal cone of the triangles in the given range
+         * @param indices triangle list
+         * @param vertices interleaved vertices, positions are the first three floats of each
+         * @param floatsPerVertex amount of floats of each vertex
+         * @returns a meshlet covering the whole range of indices, firstIndex is left to zero
+         * */
+        static auto ComputeBounds(std::span<const std::uint32_t> indices, std::span<const float> vertices, std::size_t floatsPerVertex) -> Meshlet;
+    };
+}
+
+#endif // MESHLET_BUILDER_HH
@@ -0,0 +1,61 @@
+/**
+ * @file MipGenerator.hh
+ * @author kT
+ * @brief Defines the generation of texture mip chains on the CPU
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef MIP_GENERATOR_HH
+#define MIP_GENERATOR_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+
+// Project Libraries
+#include "Texture.hh"
+
+namespace kT {
+    /**
+     * Builds the mip chain of decoded images ahead of time, so textures are uploaded with every
+     * level instead of having the driver generate them. Color channels of sRGB images are filtered
+     * in linear space, averaging their encoded values would darken every level. Texels are filtered
+     * four channels at a time with SSE2 where available and the rows of a level are spread over the
+     * worker pool. Works on client memory only, so it may run on any thread
+     * */
+    class MipGenerator {
+    public:
+        /**
+         * Reconstruction filter of each level from the previous one
+         * */
+        enum class Filter {
+            BOX,        // 2x2 average, fast enough for load time
+            KAISER,     // 6x6 Kaiser windowed sinc, sharper levels for offline bakes
+        };
+
+        /**
+         * Fills in kT::Texture::ImageData::mips, every level being the previous one filtered
+         * down to half its size, down to 1x1. Odd sizes round down and repeat the last row or column
+         * @param image decoded image of any channel count, its mips are replaced
+         * @param srgb whether the color channels are sRGB encoded, alpha is always linear
+         * @param filter reconstruction filter
+         * */
+        static auto Generate(Texture::ImageData& image, bool srgb = false, Filter filter = Filter::BOX) -> void;
+
+        /**
+         * Returns the amount of levels of a full mip chain, the base level included
+         * */
+        [[nodiscard]]
+        static auto GetLevelCount(std::int32_t width, std::int32_t height) -> std::int32_t;
+
+        /**
+         * Returns the size in bytes of the levels after the base one of a full mip chain
+         * @param channels components per texel
+         * */
+        [[nodiscard]]
+        static auto GetMipBytes(std::int32_t width, std::int32_t height, std::int32_t channels = 4) -> std::size_t;
+    };
+}
+
+#endif // MIP_GENERATOR_HH
@@ -10,10 +10,16 @@
 #define MODEL_HH
 
 // C++ Standard Library
+#include <algorithm>
 #include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <unordered_map>
 #include <string_view>
 #include <stdexcept>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -23,12 +29,153 @@
 #include "assimp/postprocess.h"
 
 // Project Libraries
+#include "BakedModel.hh"
+#include "GeometryArena.hh"
 #include "Mesh.hh"
+#include "MeshData.hh"
+#include "SceneGraph.hh"
 #include "Shader.hh"
+#include "TextureCache.hh"
+#include "VertexQuantizer.hh"
 
 namespace kT {
+    /**
+     * Tweaks how a Model is imported
+     * */
+    struct ModelLoadOptions {
+        bool parallelTextureDecode{ true };     // decode texture files on the worker pool
+        bool useBakedCache{ true };             // load from and write to kT::BakedModel files, decode textures through kT::BakedTexture
+        bool compressBakes{ true };             // write baked geometry compressed by kT::VertexCodec, smaller files decoded one mesh at a time
+        bool optimizeMeshes{ true };            // reorder triangles and vertices with kT::MeshOptimizer
+        bool compactVertices{ true };           // store vertices as kT::VertexFormat::COMPACT
+        bool generateLods{ true };              // build levels of detail with kT::MeshSimplifier
+        bool buildMeshlets{ true };             // split meshes into clusters culled on their own, see kT::MeshletBuilder
+        bool generateTangents{ true };          // build tangent frames for meshes with a normal map, see kT::TangentGenerator
+        bool nativeImporters{ true };           // import OBJ and glTF files with kT::ObjLoader and kT::GltfLoader instead of assimp
+        bool streamTextures{ true };            // keep in video memory only the texture levels the camera needs, see kT::TextureStreamer
+
+        // resident bytes the import tries to stay under. Vertices are encoded, textures decoded and client copies
+        // freed one mesh at a time as they are uploaded instead of all at once. Meshes imported from the source file
+        // are also converted and processed then, and no bake is written. Zero disables streaming. It is a target and
+        // not a limit: the next mesh uploaded is always processed, and going over it is only reported
+        std::size_t memoryBudget{};
+    };
+
+    /**
+     * Memory used by the process at the end of one stage of an import
+     * */
+    struct ImportStage {
+        std::string_view    name{};
+        std::size_t         residentBytes{};
+        std::size_t         peakResidentBytes{};    // since the previous stage, or since the process started where the peak can not be reset
+    };
+
+    /**
+     * Model imported into client memory whose OpenGL objects are not created yet.
+     * See kT::Model::Prepare() and kT::Model::uploadNext()
+     * */
+    struct PreparedModel {
+        std::filesystem::path       path{};
+        ModelLoadOptions            options{};
+        std::optional<BakedModel>   baked{};        // set when loaded from a baked file
+        std::vector<MeshData>       imported{};     // set when imported from the source file
+        std::vector<MeshView>       meshes{};       // views into baked or imported
+        std::vector<MeshInstance>   instances{};    // placements of the meshes, sorted by mesh
+        SceneGraph                  scene{};        // nodes the instances are attached to, world transforms up to date
+        std::vector<QuantizedVertices> quantized{}; // compact vertices of every imported mesh, if enabled in the options
+        std::vector<std::vector<std::uint32_t>> tangents{}; // packed tangents of every imported mesh, empty for meshes without
+
+        // cache key of every texture of every mesh, and the decodes still in flight
+        std::vector<std::vector<TextureCache::Key>> textureKeys{};
+        std::unordered_map<TextureCache::Key, std::future<Texture::ImageData>, TextureCache::KeyHash> images{};
+
+        std::size_t                 uploaded{};     // meshes already turned into kT::Mesh
+
+        // streaming imports queue the texture decodes of upcoming meshes only while they fit in the memory budget
+        std::size_t                 scheduledMeshes{};
+        std::size_t                 decodingBytes{};    // estimated size of the queued images not uploaded yet
+        std::unordered_map<TextureCache::Key, std::size_t, TextureCache::KeyHash> imageBytes{};
+
+        // streaming imports of a source file process each mesh on the worker pool as its upload comes near, see
+        // kT::Model::scheduleStreamedMeshes(). Until then imported only holds the textures of assimp meshes
+        bool                        processOnUpload{};
+        std::shared_ptr<aiScene>    sourceScene{};      // assimp scene the meshes are converted from, each aiMesh is freed once converted
+        std::shared_ptr<const std::vector<TextureRef>> embedded{};  // images stored in the assimp scene
+        std::vector<std::uint32_t>  sourceMeshes{};     // index of the aiMesh of every mesh
+        std::vector<std::future<MeshData>> processing{};
+        std::size_t                 processedMeshes{};  // meshes whose processing is queued
+        std::vector<std::size_t>    meshBytes{};        // estimated working memory of every queued mesh
+        std::size_t                 processingBytes{};  // of the queued meshes not uploaded yet
+
+        std::vector<ImportStage>    stages{};
+
+        // arena range reserved for all the meshes on the first upload, and how much of it is filled
+        GeometryArena::Range        geometry{};
+        std::size_t                 uploadedVertices{};
+        std::size_t                 uploadedIndexBytes{};
+
+        [[nodiscard]]
+        auto isUploaded() const -> bool { return uploaded == meshes.size(); }
+
+        [[nodiscard]]
+        auto isStreaming() const -> bool { return options.memoryBudget != 0; }
+
+        /**
+         * Returns true if any mesh carries tangents, the whole model is then uploaded to a block with a tangent stream
+         * */
+        [[nodiscard]]
+        auto hasTangents() const -> bool {
+            for (std::size_t i{}; i < meshes.size(); i++) {
+                if (getGeometrySize(i).tangents != 0)
+                    return true;
+            }
+
+            return false;
+        }
+
+        [[nodiscard]]
+        auto getVertexFormat() const -> VertexFormat { return options.compactVertices ? VertexFormat::COMPACT : VertexFormat::STANDARD; }
+
+        /**
+         * Returns the vertices of the given mesh in the format they are uploaded with, see kT::Model::encodeVertices()
+         * */
+        [[nodiscard]]
+        auto getVertices(std::size_t mesh) const -> VertexView {
+            if (baked)
+                return baked->getVertices(mesh, getVertexFormat());
+
+            VertexView view{ options.compactVertices ? quantized[mesh].getView() : VertexView{ VertexFormat::STANDARD, std::as_bytes(meshes[mesh].vertices), {} } };
+            if (mesh < tangents.size())
+                view.tangents = std::as_bytes(std::span{ tangents[mesh] });
+
+            return view;
+        }
+
+        /**
+         * Returns the size of the geometry of the given mesh, also for meshes of compressed bakes not decoded yet
+         * */
+        [[nodiscard]]
+        auto getGeometrySize(std::size_t mesh) const -> BakedModel::GeometrySize {
+            if (baked)
+                return baked->getGeometrySize(mesh);
+
+            return BakedModel::GeometrySize{ meshes[mesh].vertices.size(), meshes[mesh].indices.size(), meshes[mesh].tangents.size() };
+        }
+
+        [[nodiscard]]
+        auto getVertexCount(std::size_t mesh) const -> std::size_t {
+            return getGeometrySize(mesh).vertices * sizeof(float) / Mesh::GetLayout().getStride();
+        }
+    };
+
     class Model {
     public:
+        /**
+         * Post processing steps applied by assimp on import. Part of the
+         * content hash of baked models
+         * */
+        static constexpr std::uint32_t s_ImportFlags{ aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices };
+
         explicit Model() = default;
         /**
          * Loads an object model from the given path. If the path is not valid
@@ -36,7 +183,7 @@ namespace kT {
          * @param path path to the model to be loaded
          * @throws std::runtime_error if the file does not exist or the path is invalid
          * */
-        explicit Model(const std::filesystem::path& path);
+        explicit Model(const std::filesystem::path& path, const ModelLoadOptions& options = {});
 
         /**
          * Copy constructor disabled. Use the default constructor
@@ -45,7 +192,27 @@ namespace kT {
         Model(const Model& other) = delete;
 
         auto getMeshes() -> std::vector<Mesh>& { return m_Meshes; }
-        auto LoadFromFile(const std::string path) -> void;
+        auto getMeshes() const -> const std::vector<Mesh>& { return m_Meshes; }
+
+        /**
+         * Returns the placements of the meshes sorted by mesh, so the instances of
+         * one mesh are contiguous. Meshes still being uploaded are already referenced
+         * */
+        auto getInstances() const -> std::span<const MeshInstance> { return m_Instances; }
+
+        /**
+         * Returns the node hierarchy of every file loaded into this model. Changed
+         * local transforms reach the instances on the next updateTransforms()
+         * */
+        auto getScene() -> SceneGraph& { return m_Scene; }
+        auto getScene() const -> const SceneGraph& { return m_Scene; }
+
+        /**
+         * Updates the scene and copies the world transforms of the nodes that changed
+         * into the instances attached to them. kT::Renderer calls it before drawing
+         * */
+        auto updateTransforms() -> void;
+        auto LoadFromFile(const std::string path, const ModelLoadOptions& options = {}) -> void;
 
         /**
          * Copy assigment disabled. Use the default constructor
@@ -70,51 +237,276 @@ namespace kT {
         auto getIndexCount() const -> std::size_t;
         auto getTextureCount() const -> std::size_t;
 
+        /**
+         * Imports the model in path into client memory: maps its baked file or runs
+         * assimp, and queues the decoding of the textures missing from kT::TextureCache.
+         * Does not touch any OpenGL state, so it may run on a worker thread
+         * @param path path to the model to be loaded
+         * @param options import settings
+         * @returns the imported model
+         * @throws std::runtime_error if the file does not exist or the path is invalid
+         * */
+        static auto Prepare(const std::filesystem::path& path, const ModelLoadOptions& options = {}) -> PreparedModel;
+
+        /**
+         * Creates the OpenGL objects of the next mesh of a prepared model and appends
+         * it to this Model. The first call reserves one kT::GeometryArena range for all the meshes,
+         * so the whole model draws from a single block. Must be called from the thread owning the OpenGL context
+         * @param prepared model returned by kT::Model::Prepare()
+         * @param wait if false, returns without uploading when the mesh textures are still being decoded
+         * @returns true if a mesh was uploaded
+         * */
+        auto uploadNext(PreparedModel& prepared, bool wait = true) -> bool;
+
+        /**
+         * Returns the hash of the import settings a baked file depends on. Bakes written
+         * with other settings hold different data and are considered stale
+         * @param options import settings
+         * @returns hash of the settings changing the imported data
+         * */
+        [[nodiscard]]
+        static auto GetBakeSettings(const ModelLoadOptions& options) -> std::uint64_t;
+
+        /**
+         * Returns the files the import of a model reads: the model file first, then the material
+         * libraries or buffers the native importers load besides it. Files read by assimp are not known
+         * @param path path to the model
+         * @param options import settings, they pick the importer
+         * @returns paths of the source files
+         * @throws std::runtime_error if the model file could not be read
+         * */
+        [[nodiscard]]
+        static auto GetSourceFiles(const std::filesystem::path& path, const ModelLoadOptions& options) -> std::vector<std::filesystem::path>;
+
+        /**
+         * Returns the hash a baked file of the given model is checked against: the contents of
+         * every existing source file chained through the import settings
+         * @param path path to the model
+         * @param options import settings
+         * @returns hash of the sources and settings
+         * @throws std::runtime_error if the model file could not be read
+         * */
+        [[nodiscard]]
+        static auto HashSources(const std::filesystem::path& path, const ModelLoadOptions& options) -> std::uint64_t;
+
     private:
+        /**
+         * Decodes the image a texture reference points to, from its kT::BakedTexture file when baked is true
+         * @param ref texture file or embedded image, raw texels are not handled
+         * @param baked true to go through the baked texture cache
+         * @returns decoded image
+         * @throws std::runtime_error if the image could not be decoded
+         * */
+        static auto decodeImage(const TextureRef& ref, bool baked) -> Texture::ImageData;
+
+        /**
+         * Runs kT::MeshOptimizer on every imported mesh and logs the cache efficiency gained
+         * @param path path to the model, for logging
+         * @param meshes imported meshes
+         * */
+        static auto optimize(const std::filesystem::path& path, std::vector<MeshData>& meshes) -> void;
+
+        /**
+         * Computes the bounds and the levels of detail of every imported mesh
+         * @param path path to the model, for logging
+         * @param meshes imported meshes
+         * @param generate if false every mesh keeps only its full resolution level
+         * */
+        static auto generateLods(const std::filesystem::path& path, std::vector<MeshData>& meshes, bool generate) -> void;
+
+        /**
+         * Splits every imported mesh into meshlets
+         * @param path path to the model, for logging
+         * @param meshes imported meshes
+         * */
+        static auto buildMeshlets(const std::filesystem::path& path, std::vector<MeshData>& meshes) -> void;
+
+        /**
+         * Generates the tangents of every imported mesh with a normal map
+         * @param path path to the model, for logging
+         * @param meshes imported meshes, some of them get more vertices
+         * */
+        static auto generateTangents(const std::filesystem::path& path, std::vector<MeshData>& meshes) -> void;
+
+        /**
+         * Runs the import stages of kT::Model::Prepare() on a single mesh: optimization, tangents, meshlets and levels of detail.
+         * Used by streaming imports, it may run on a worker thread
+         * @param mesh imported mesh
+         * @param options import settings picking the stages
+         * */
+        static auto processImported(MeshData& mesh, const ModelLoadOptions& options) -> void;
+
+        /**
+         * Logs the GPU memory and vertex fetch bandwidth the compact vertex format and 16 bit indices save
+         * @param prepared imported model
+         * */
+        static auto reportGeometrySize(const PreparedModel& prepared) -> void;
+
+        /**
+         * Quantizes the vertices and packs the tangents of one mesh into the format they are uploaded with. Baked meshes
+         * have them stored that way already and are only decoded when the bake is compressed. Runs for every mesh while preparing, or right before the upload of each mesh when streaming
+         * @param prepared imported model
+         * @param mesh index of the mesh, already encoded meshes are left alone
+         * */
+        static auto encodeVertices(PreparedModel& prepared, std::size_t mesh) -> void;
+
+        /**
+         * Frees the client side copies of an uploaded mesh of a streaming import,
+         * along with the decoded images no mesh is waiting for anymore
+         * @param prepared imported model
+         * @param mesh index of the uploaded mesh
+         * */
+        static auto releaseMesh(PreparedModel& prepared, std::size_t mesh) -> void;
+
+        /**
+         * Queues the texture decodes of upcoming meshes for as long as the decoded
+         * images fit in the memory budget next to what the process already holds
+         * @param prepared imported model
+         * */
+        static auto scheduleStreamedTextures(PreparedModel& prepared) -> void;
+
+        /**
+         * Queues the conversion and processing of upcoming meshes of a streaming import for as long as their
+         * estimated working memory fits in the memory budget. The mesh uploaded next is always queued
+         * @param prepared imported model
+         * */
+        static auto scheduleStreamedMeshes(PreparedModel& prepared) -> void;
+
+        /**
+         * Records the memory used at the end of an import stage and restarts the peak for the next one
+         * @param prepared imported model
+         * @param stage name of the stage, a string literal
+         * */
+        static auto recordStage(PreparedModel& prepared, std::string_view stage) -> void;
+
+        /**
+         * Logs the peak resident memory of every stage of an import and warns if it went over the memory budget
+         * @param prepared uploaded model
+         * */
+        static auto reportMemory(const PreparedModel& prepared) -> void;
+
         /**
          * Helper function to load model resources from given path
          * @param path path to the model to be loaded
+         * @param options import settings
          * @throws std::runtime_error if the file does not exist or the path is invalid
          * */
-        auto load(const std::filesystem::path& path) -> void;
+        auto load(const std::filesystem::path& path, const ModelLoadOptions& options) -> void;
+
+        /**
+         * Imports the model in path through assimp. Meshes referenced by several nodes are kept once
+         * @param path path to the model to be loaded
+         * @param scene receives the aiNode hierarchy
+         * @param instances receives one instance per node reference to a mesh, transforms are left to the scene
+         * @returns CPU side data of every distinct mesh
+         * @throws std::runtime_error if assimp could not import the file
+         * */
+        static auto import(const std::filesystem::path& path, SceneGraph& scene, std::vector<MeshInstance>& instances) -> std::vector<MeshData>;
+
+        /**
+         * Reads the model in path through assimp for a streaming import. Only the scene and the materials are read,
+         * the scene is kept so each mesh is converted right before its upload, see kT::Model::scheduleStreamedMeshes()
+         * @param prepared receives the scene, the instances and the textures of every distinct mesh
+         * @throws std::runtime_error if assimp could not import the file
+         * */
+        static auto importStreamed(PreparedModel& prepared) -> void;
+
+        /**
+         * Computes the cache keys of the textures of the prepared meshes. The ones
+         * missing from kT::TextureCache are decoded on the worker pool unless disabled in the options
+         * @param prepared imported model
+         * */
+        static auto scheduleTextures(PreparedModel& prepared) -> void;
 
 
         // ASSIMP INTERFACE HELPER FUNCTIONS
 
         /**
-         * Retrieves each one of the meshes contained within the scene
-         * into this Model. This process starts from the given node
-         * traversing all of its children nodes
+         * Reads the file in path with the given importer, which keeps ownership of the scene
+         * @param path path to the model to be loaded
+         * @param importer importer to read with
+         * @returns the imported scene
+         * @throws std::runtime_error if assimp could not import the file
+         * */
+        static auto readScene(const std::filesystem::path& path, Assimp::Importer& importer) -> const aiScene*;
+
+        /**
+         * Collects each one of the mesh references contained within the scene in depth first
+         * order, which is the order meshes are kept in. This process starts from the given node
+         * traversing all of its children nodes, which are added to the scene graph. The meshes are processed afterwards, in parallel
          * @param root contains components of the given scene
-         * @param scene represents a complete scene, which contains aiNodes and the associated meshes, materials, etc.
+         * @param parent scene graph node of the parent of root
+         * @param scene receives a node for root and for each of its descendants
+         * @param instances receives one instance per reference, holding the index of the aiMesh in the scene
+         * */
+        static auto processNode(const aiNode* root, std::uint32_t parent, SceneGraph& scene, std::vector<MeshInstance>& instances) -> void;
+
+        /**
+         * Turns the meshes of instances into compact indices of distinct meshes, numbered in order of first
+         * reference, and sorts the instances by mesh. Logs how many meshes are shared
+         * @param path path to the model, for logging
+         * @param instances instances whose mesh is any unique id
+         * @returns the original id of every distinct mesh
          * */
-        auto processNode(aiNode* root, const aiScene* scene) -> void;
+        static auto deduplicate(const std::filesystem::path& path, std::vector<MeshInstance>& instances) -> std::vector<std::uint32_t>;
 
         /**
          * Retrieves the components of the Mesh contained within
          * the given node from the given scene
          * @param node contains components of the Mesh
          * @param scene represents a complete scene, which contains aiNodes and the associated meshes, materials, etc.
-         * @returns mesh containing the retrieved data
+         * @param directory directory containing the model, textures are looked up relative to it
+         * @param embedded textures stored in the scene, see kT::Model::loadEmbeddedTexture()
+         * @returns mesh data containing the retrieved data
          * */
-        auto processMesh(aiMesh* node, const aiScene* scene) -> Mesh;
+        static auto processMesh(aiMesh* node, const aiScene* scene, const std::filesystem::path& directory,
+                                std::span<const TextureRef> embedded) -> MeshData;
 
         /**
-         * Retrieves texture materials from the given aiMaterial
+         * Retrieves the diffuse, specular and normal maps of the material of the given mesh
+         * @param mesh mesh of the scene
+         * @param scene scene holding the mesh and its material
+         * @param directory directory containing the model, textures are looked up relative to it
+         * @param embedded textures stored in the scene, see kT::Model::loadEmbeddedTexture()
+         * @returns textures of the mesh, diffuse maps first
+         * */
+        static auto processMaterial(const aiMesh* mesh, const aiScene* scene, const std::filesystem::path& directory,
+                                    std::span<const TextureRef> embedded) -> std::vector<TextureRef>;
+
+        /**
+         * Retrieves texture materials from the given aiMaterial. Textures named "*N", or after an
+         * image the scene embeds, come from the embedded ones instead of the filesystem
          * @param mat container of the materials
          * @param type type of texture to be processed
          * @param tType specifies the type of texture for the <b>kT::Texture</b> object
          * @param scene represents a complete scene, which contains aiNodes and the associated meshes, materials, etc.
-         * @returns a list of textures from the given material of type <code>type</code>
+         * @param directory directory containing the model, textures are looked up relative to it
+         * @param embedded textures stored in the scene, indexed like aiScene::mTextures
+         * @returns a list of texture files from the given material of type <code>type</code>
          * */
-        auto loadMaterialTextures(aiMaterial* mat, aiTextureType type, kT::Texture::TextureType tType,
-                                  const aiScene* scene) -> std::vector<kT::Texture>;
+        static auto loadMaterialTextures(aiMaterial* mat, aiTextureType type, kT::Texture::TextureType tType, const aiScene* scene,
+                                         const std::filesystem::path& directory, std::span<const TextureRef> embedded) -> std::vector<TextureRef>;
+
+        /**
+         * Copies an image stored in the scene out of it. Compressed images keep their encoded bytes and
+         * are decoded like image files, raw texels are turned into the RGBA rows kT::Texture::decode() would produce
+         * @param texture image of the scene
+         * @param path path to the model, embedded images are named after it for the texture cache
+         * @param index index of the image in aiScene::mTextures
+         * @returns reference to the image, with no bytes if the texture is empty
+         * */
+        static auto loadEmbeddedTexture(const aiTexture* texture, const std::filesystem::path& path, std::size_t index) -> TextureRef;
 
 
 
 
         std::vector<Mesh>       m_Meshes{};
+        std::vector<MeshInstance> m_Instances{};
+        SceneGraph              m_Scene{};
         std::filesystem::path   m_ModelPath{};
+
+        // arena ranges holding the geometry of the meshes, one per loaded file
+        std::vector<GeometryArena::Allocation> m_Geometry{};
     };
 
 }
@@ -0,0 +1,32 @@
+/**
+ * @file NormalGenerator.hh
+ * @author kT
+ * @brief Defines the generation of missing vertex normals
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef NORMAL_GENERATOR_HH
+#define NORMAL_GENERATOR_HH
+
+// Project Libraries
+#include "MeshData.hh"
+
+namespace kT {
+    /**
+     * Fills in the normals of meshes imported without any, like aiProcess_GenSmoothNormals
+     * does for the assimp import. Works on client memory only, so it may run on any thread
+     * */
+    class NormalGenerator {
+    public:
+        /**
+         * Replaces the normals of every vertex with the area weighted average of the normals
+         * of the triangles around its position. Vertices split at texture seams share the
+         * same position, so they get the same normal and the seam does not show
+         * @param mesh imported mesh laid out as kT::Mesh::GetLayout()
+         * */
+        static auto GenerateSmooth(MeshData& mesh) -> void;
+    };
+}
+
+#endif // NORMAL_GENERATOR_HH
@@ -0,0 +1,63 @@
+/**
+ * @file ObjLoader.hh
+ * @author kT
+ * @brief Defines the native Wavefront OBJ importer
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef OBJ_LOADER_HH
+#define OBJ_LOADER_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+// Project Libraries
+#include "MeshData.hh"
+
+namespace kT {
+    /**
+     * Imports Wavefront OBJ files and their MTL libraries without going through assimp. The file
+     * is mapped into memory, split into chunks at line boundaries and every chunk is parsed on the
+     * worker pool. Corners sharing position, texture coordinate and normal are welded into one vertex
+     * laid out as kT::Mesh::GetLayout(). The result matches what assimp gives with the flags of
+     * kT::Model: polygons are triangulated, texture coordinates flipped and smooth normals generated
+     * for meshes without any. A new mesh starts on every object, group or material change.
+     * Works on client memory only, so it may run on any thread
+     * */
+    class ObjLoader {
+    public:
+        /**
+         * Chunks are at least this big, smaller ones cost more to merge than they save
+         * */
+        static constexpr std::size_t s_MinChunkSize{ 64 * 1024 };
+
+        /**
+         * Imports the meshes of the given file
+         * @param path path to the OBJ file, textures are looked up relative to its directory
+         * @returns meshes in the order they appear in the file
+         * @throws std::runtime_error if the file can not be read or references missing elements
+         * */
+        static auto Load(const std::filesystem::path& path) -> std::vector<MeshData>;
+
+        /**
+         * Returns the files besides the model the meshes are read from, its MTL libraries. Texture files are not included
+         * @param path path to the OBJ file
+         * @returns paths of the material libraries referenced by the file, existing or not
+         * @throws std::runtime_error if the file can not be read
+         * */
+        [[nodiscard]]
+        static auto GetDependencies(const std::filesystem::path& path) -> std::vector<std::filesystem::path>;
+
+        /**
+         * Returns true if the given file is handled by this loader
+         * @param path path to a model file
+         * */
+        [[nodiscard]]
+        static auto IsSupported(const std::filesystem::path& path) -> bool;
+    };
+}
+
+#endif // OBJ_LOADER_HH
@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
 
 // Third-Party Libraries
 #include <GL/glew.h>
@@ -33,7 +34,10 @@
 #include <backends/imgui_impl_opengl3.h>
 
 // Project Libraries
+#include <OpenGL/Camera.hh>
+#include <OpenGL/Frustum.hh>
 #include <OpenGL/Mesh.hh>
+#include <OpenGL/MeshSimplifier.hh>
 #include <OpenGL/Model.hh>
 #include <OpenGL/Shader.hh>
 #include <OpenGL/ElementBuffer.hh>
@@ -41,6 +45,23 @@
 namespace kT {
     class Renderer {
     public:
+        /**
+         * What the last kT::Renderer::DrawModel() calls with a camera submitted
+         * */
+        struct Stats {
+            std::size_t meshesDrawn{};          // mesh instances, a mesh placed several times counts once per placement
+            std::size_t meshesCulled{};         // off screen or projected smaller than the cull threshold
+            std::size_t drawCalls{};
+            std::size_t instancesBatched{};     // drawn together with other instances of the same mesh and level
+            std::size_t meshletsDrawn{};
+            std::size_t meshletsFrustumCulled{};
+            std::size_t meshletsBackfaceCulled{};
+            std::size_t trianglesDrawn{};       // submitted to OpenGL
+            std::size_t trianglesClusterCulled{};
+            std::size_t trianglesFullDetail{};  // triangles the drawn meshes have at level 0
+            std::array<std::size_t, MeshSimplifier::s_MaxLevels> meshesPerLod{};
+        };
+
         static auto Init() -> void;
         static auto ShutDown() -> void;
 
@@ -49,6 +70,18 @@ namespace kT {
 
         static auto DrawMesh(Shader& shader, const Mesh& mesh) -> void;
         static auto DrawModel(Shader& shader, Model& model) -> void;
+
+        /**
+         * Draws the model picking for every mesh instance the coarsest level of detail whose error projects
+         * to fewer pixels than the LOD threshold. Instances off screen or projecting smaller than the cull threshold are skipped.
+         * Visible instances of the same mesh at the same level are drawn with one instanced call, an instance
+         * drawn alone at full resolution only submits its meshlets that are on screen and not facing away
+         * @param shader shader the model is drawn with
+         * @param model model to be drawn
+         * @param camera camera the model is seen from
+         * @param transform model matrix the shader is using
+         * */
+        static auto DrawModel(Shader& shader, Model& model, const Camera& camera, const glm::mat4& transform) -> void;
         static auto DrawGeometry(Shader& shader, const VertexBuffer& vertexBuffer) -> void;
         static auto DrawGeometry(Shader& shader, const VertexBuffer& vertexBuffer, const ElementBuffer& indexBuffer) -> void;
         static auto DrawGeometry(Shader &shader, std::initializer_list<float> &&vertexBuffer) -> void;
@@ -59,8 +92,108 @@ namespace kT {
 
         static auto ResetViewport(std::int32_t width, std::int32_t height) -> void;
 
+        /**
+         * Sets the screen space error in pixels a level of detail may show
+         * */
+        static auto SetLodPixelError(float pixels) -> void { s_LodPixelError = pixels; }
+        static auto GetLodPixelError() -> float { return s_LodPixelError; }
+
+        /**
+         * Sets the size in pixels under which meshes are not drawn
+         * */
+        static auto SetCullPixelSize(float pixels) -> void { s_CullPixelSize = pixels; }
+        static auto GetCullPixelSize() -> float { return s_CullPixelSize; }
+
+        /**
+         * Enables culling meshes drawn at full resolution per meshlet
+         * */
+        static auto SetMeshletCulling(bool enable) -> void { s_MeshletCulling = enable; }
+        static auto GetMeshletCulling() -> bool { return s_MeshletCulling; }
+
+        static auto GetStats() -> const Stats&;
+        static auto ResetStats() -> void;
+
     private:
+        /**
+         * Binds the textures of the mesh and draws its arena range, expects the arena block of the mesh
+         * to be bound and the instance transforms to be set, see SetInstanceTransform() and BindInstances()
+         * */
+        static auto DrawMeshRange(Shader& shader, const Mesh& mesh, std::size_t lod = 0, std::size_t instances = 1) -> void;
+
+        /**
+         * Draws everything in s_Batches, uploading s_InstanceTransforms first
+         * @param camera if set, lone instances at full resolution are culled per meshlet as seen from it
+         * */
+        static auto DrawBatches(Shader& shader, const Model& model, const Camera* camera) -> void;
+
+        /**
+         * Makes the bound vertex array read the instance transform from the given matrix for every vertex
+         * */
+        static auto SetInstanceTransform(const glm::mat4& transform) -> void;
+
+        /**
+         * Sets the value the instance attributes read while their arrays are disabled. It is context
+         * state, not vertex array state, so it needs no vertex array bound
+         * */
+        static auto LoadInstanceTransform(const glm::mat4& transform) -> void;
+
+        /**
+         * Makes the positions of plain float vertices pass through the position transform of compact
+         * vertices unchanged. Shaders without it are left as they are
+         * */
+        static auto ResetPositionTransform(const Shader& shader) -> void;
+
+        /**
+         * Makes the bound vertex array read one instance transform per instance from the instance buffer
+         * @param first index in s_InstanceTransforms of the transform of instance 0
+         * */
+        static auto BindInstances(std::size_t first) -> void;
+
+        /**
+         * Draws the meshlets of the full resolution level that survive culling with a single multi draw,
+         * expects the arena block of the mesh to be bound
+         * @param frustum view frustum in model space
+         * @param eye camera position in model space
+         * @returns amount of triangles submitted
+         * */
+        static auto DrawMeshlets(Shader& shader, const Mesh& mesh, const Frustum& frustum, const glm::vec3& eye) -> std::size_t;
+
+        /**
+         * Binds the textures of the mesh and sets its uniforms
+         * */
+        static auto BindMaterial(Shader& shader, const Mesh& mesh) -> void;
+
+        /**
+         * Returns the offset in the bound element buffer of the given index of a mesh
+         * */
+        static auto GetIndexOffset(const Mesh& mesh, std::uint32_t firstIndex) -> void*;
+
         inline static std::shared_ptr<VertexArray> s_VertexArray{};
+        inline static float s_LodPixelError{ 1.0f };
+        inline static float s_CullPixelSize{ 2.0f };
+        inline static bool s_MeshletCulling{ true };
+        static Stats s_Stats;
+
+        // draw lists built by kT::Renderer::DrawMeshlets(), kept to reuse their memory
+        static std::vector<GLsizei> s_DrawCounts;
+        static std::vector<void*> s_DrawOffsets;
+        static std::vector<GLint> s_DrawBaseVertices;
+
+        // instances of one mesh drawn at the same level of detail, their transforms are contiguous in s_InstanceTransforms
+        struct Batch {
+            std::uint32_t   mesh{};
+            std::uint32_t   lod{};
+            std::size_t     firstInstance{};
+            std::size_t     instanceCount{};
+            glm::mat4       transform{ 1.0f };      // model matrix of the first instance, for meshlet culling
+        };
+
+        // per instance vertex attributes at locations 3 to 6, a column of the transform each
+        static constexpr GLuint s_InstanceAttribute{ 3 };
+
+        inline static std::unique_ptr<VertexBuffer> s_InstanceBuffer{};
+        static std::vector<Batch> s_Batches;
+        static std::vector<glm::mat4> s_InstanceTransforms;
 
     };
 
@@ -0,0 +1,114 @@
+/**
+ * @file SceneGraph.hh
+ * @author kT
+ * @brief Defines the node hierarchy of a model
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SCENE_GRAPH_HH
+#define SCENE_GRAPH_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Third-Party Libraries
+#include <glm/glm.hpp>
+
+namespace kT {
+    /**
+     * Hierarchy of transform nodes, like the aiNode tree of an imported scene. Every property lives in its
+     * own array indexed by node, and a parent always comes before its children, so computing the world
+     * transforms is a single linear pass. Changing a local transform only marks the node, the next
+     * update() recomputes the world transform of the marked nodes and of their subtrees and nothing else
+     * */
+    class SceneGraph {
+    public:
+        /**
+         * Parent of the root nodes
+         * */
+        static constexpr std::uint32_t s_NoParent{ 0xFFFFFFFF };
+
+        /**
+         * Appends a node, its world transform is computed on the next update()
+         * @param parent index of an existing node or s_NoParent
+         * @param local node to parent transform
+         * @param name name of the node, may be empty
+         * @returns index of the new node
+         * @throws std::runtime_error if the parent does not exist
+         * */
+        auto addNode(std::uint32_t parent, const glm::mat4& local, std::string_view name = {}) -> std::uint32_t;
+
+        /**
+         * Appends every node of other, its roots becoming children of parent
+         * @param other graph whose nodes are copied
+         * @param parent index of an existing node or s_NoParent
+         * @returns index the first node of other got, add it to the indices of other to get the new ones
+         * @throws std::runtime_error if the parent does not exist
+         * */
+        auto append(const SceneGraph& other, std::uint32_t parent = s_NoParent) -> std::uint32_t;
+
+        /**
+         * Replaces the local transform of a node, its subtree is updated on the next update()
+         * */
+        auto setLocalTransform(std::uint32_t node, const glm::mat4& local) -> void;
+
+        /**
+         * Recomputes the world transforms of the nodes changed since the last call and of their descendants
+         * @returns amount of world transforms recomputed
+         * */
+        auto update() -> std::size_t;
+
+        /**
+         * Returns true if the last update() recomputed the world transform of the node
+         * */
+        [[nodiscard]]
+        auto wasUpdated(std::uint32_t node) const -> bool { return m_Updated[node] != 0; }
+
+        [[nodiscard]]
+        auto getSize() const -> std::size_t { return m_Parents.size(); }
+
+        [[nodiscard]]
+        auto isEmpty() const -> bool { return m_Parents.empty(); }
+
+        [[nodiscard]]
+        auto getParent(std::uint32_t node) const -> std::uint32_t { return m_Parents[node]; }
+
+        [[nodiscard]]
+        auto getName(std::uint32_t node) const -> std::string_view { return m_Names[node]; }
+
+        [[nodiscard]]
+        auto getLocalTransform(std::uint32_t node) const -> const glm::mat4& { return m_Local[node]; }
+
+        /**
+         * Returns the node to model transform as of the last update()
+         * */
+        [[nodiscard]]
+        auto getWorldTransform(std::uint32_t node) const -> const glm::mat4& { return m_World[node]; }
+
+        [[nodiscard]]
+        auto getParents() const -> std::span<const std::uint32_t> { return m_Parents; }
+
+        [[nodiscard]]
+        auto getLocalTransforms() const -> std::span<const glm::mat4> { return m_Local; }
+
+    private:
+        std::vector<std::uint32_t>  m_Parents{};
+        std::vector<glm::mat4>      m_Local{};
+        std::vector<glm::mat4>      m_World{};
+        std::vector<std::string>    m_Names{};
+        std::vector<std::uint8_t>   m_Dirty{};      // local transform changed since the last update
+        std::vector<std::uint8_t>   m_Updated{};    // world transform recomputed by the last update
+
+        // nodes before the first dirty one cannot change, the update pass starts there
+        std::size_t m_FirstDirty{};
+        std::size_t m_LastUpdated{};
+    };
+}
+
+#endif // SCENE_GRAPH_HH
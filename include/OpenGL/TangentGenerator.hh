@@ -0,0 +1,49 @@
+/**
+ * @file TangentGenerator.hh
+ * @author kT
+ * @brief Defines the generation of tangent frames for normal mapping
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef TANGENT_GENERATOR_HH
+#define TANGENT_GENERATOR_HH
+
+// C++ Standard Library
+#include <cstddef>
+
+// Project Libraries
+#include "MeshData.hh"
+
+namespace kT {
+    /**
+     * Builds per vertex tangent frames following the MikkTSpace conventions, the ones normal
+     * maps baked by most tools and the glTF specification expect: triangle tangents come from
+     * the texture coordinate derivatives, are projected onto the plane of the vertex normal and
+     * weighted by the angle of the triangle at the vertex, and the bitangent is rebuilt in the
+     * shader as cross(normal, tangent.xyz) * tangent.w. Works on client memory only, so it may run on any thread
+     * */
+    class TangentGenerator {
+    public:
+        /**
+         * Amount of floats per vertex in kT::MeshData::tangents
+         * */
+        static constexpr std::size_t s_Components{ 4 };
+
+        /**
+         * Fills in the tangents of the mesh. Vertices shared by triangles whose texture is
+         * mirrored relative to each other cannot have a single frame, so they are split
+         * @param mesh imported mesh laid out as kT::Mesh::GetLayout(), with normals and texture coordinates
+         * @returns amount of vertices added by splitting
+         * */
+        static auto Generate(MeshData& mesh) -> std::size_t;
+
+        /**
+         * Returns true if the mesh material has a normal map, the only case tangents are used for
+         * */
+        [[nodiscard]]
+        static auto IsNeeded(const MeshData& mesh) -> bool;
+    };
+}
+
+#endif // TANGENT_GENERATOR_HH
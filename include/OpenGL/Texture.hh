@@ -17,6 +17,8 @@
 #include <cstdlib>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <span>
 #include <stdexcept>
 #include <vector>
 #include <utility>
@@ -43,11 +45,39 @@ namespace kT {
             NORMAL,
         };
 
+        /**
+         * Layout of the texels of a texture in video memory
+         * */
+        enum class PixelFormat {
+            UNCOMPRESSED,   // one 8-bit component per channel of the image
+            BC1,            // RGB, 4x4 blocks of 8 bytes
+            BC3,            // RGBA, BC1 color plus an 8 byte alpha block
+            BC5,            // RG, two 8 byte single channel blocks, used for tangent space normals
+            BC7,            // RGBA, 4x4 blocks of 16 bytes
+        };
+
         /**
          * Represents image dimensions, first value is width and second is height
          * */
         using Dimensions = std::pair<std::int32_t, std::int32_t>;
 
+        /**
+         * Decoded image pixels living in client memory. Pixels keep the channels of the
+         * image file, one 8-bit component each: gray, gray and alpha, RGB or RGBA. Block compressed
+         * images, see kT::TextureCompressor, carry their blocks instead and may have no pixels
+         * */
+        struct ImageData {
+            std::int32_t width{};       // Image width
+            std::int32_t height{};      // Image height
+            std::int32_t channels{};    // components per texel, as in the image file
+            std::unique_ptr<std::uint8_t, void(*)(void*)> pixels{ nullptr, stbi_image_free };
+            std::vector<std::uint8_t> mips{};   // levels after the base one back to back, see kT::MipGenerator. Empty to generate them on upload
+            PixelFormat format{ PixelFormat::UNCOMPRESSED };
+            std::vector<std::uint8_t> blocks{}; // every level of a compressed format back to back, the base one first
+            std::filesystem::path bake{};       // baked file holding these levels, see kT::BakedTexture::Decode. Empty if there is none
+            std::uint64_t sourceHash{};         // content hash of the source the bake was made from
+        };
+
         /**
          * Initializes this Texture creating a new
          * Texture object
@@ -118,7 +148,7 @@ namespace kT {
         auto getId() const -> std::uint32_t;
 
         /**
-         * Returns the number of image components in loaded file
+         * Returns the number of components per texel, as uploaded
          * @return channels of this Texture
          * */
         [[nodiscard]]
@@ -131,6 +161,64 @@ namespace kT {
         [[nodiscard]]
         auto getType() const -> TextureType;
 
+        /**
+         * Returns true if this Texture holds sRGB encoded colors, sampled as linear values.
+         * Diffuse maps are, except BC5 ones whose two channels are not colors
+         * */
+        [[nodiscard]]
+        auto isSrgb() const -> bool;
+
+        /**
+         * Returns true if sampling this sRGB Texture decodes its colors. Gray diffuse maps are stored as GL_R8
+         * when EXT_texture_sRGB_R8 is missing, shaders decode them instead
+         * */
+        [[nodiscard]]
+        auto isSrgbSampled() const -> bool;
+
+        /**
+         * Returns the GPU memory used by the levels of this Texture in video memory
+         * @return size in bytes
+         * */
+        [[nodiscard]]
+        auto getSizeInBytes() const -> std::size_t;
+
+        /**
+         * Returns the GPU memory this Texture would use with the given level resident
+         * @param residentLevel first level in video memory, see kT::Texture::getResidentLevel()
+         * @return size in bytes
+         * */
+        [[nodiscard]]
+        auto getSizeInBytes(std::int32_t residentLevel) const -> std::size_t;
+
+        /**
+         * Returns the amount of levels of the full mip chain of this Texture
+         * */
+        [[nodiscard]]
+        auto getLevelCount() const -> std::int32_t;
+
+        /**
+         * Returns the largest level of the mip chain in video memory, 0 when the texture is fully resident.
+         * Level 0 of the OpenGL texture holds this level of the image
+         * */
+        [[nodiscard]]
+        auto getResidentLevel() const -> std::int32_t { return m_ResidentLevel; }
+
+        /**
+         * Returns true if the residency of this Texture can change. Its levels are read again from its baked
+         * file when raised, textures without one keep their image in client memory
+         * */
+        [[nodiscard]]
+        auto isStreamed() const -> bool { return m_Source != nullptr || !m_Bake.empty(); }
+
+        /**
+         * Changes the largest level of the mip chain in video memory. The storage is reallocated to the new size,
+         * the levels already resident are copied on the GPU and the missing ones are queued for kT::TextureUploader.
+         * The name of the texture changes. Must be called from the thread owning the OpenGL context
+         * @param level new resident level, clamped to the mip chain
+         * @throws std::runtime_error if the texture is not streamed
+         * */
+        auto setResidentLevel(std::int32_t level) -> void;
+
         /**
          * Creates a new Texture object and fills it with the data
          * from Texture file in path. If no data is provided it simply creates
@@ -149,6 +237,69 @@ namespace kT {
          * */
         static auto fromFile(const std::filesystem::path& path, kT::Texture::TextureType type) -> kT::Texture;
 
+        /**
+         * Decodes the image file in path into client memory. This function
+         * does not touch any OpenGL state, so it is safe to call it from worker threads
+         * @param path path to the texture file
+         * @return decoded image
+         * @throws std::runtime_error if the file could not be decoded
+         * */
+        static auto decode(const std::filesystem::path& path) -> ImageData;
+
+        /**
+         * Decodes an image file already in memory, like the ones embedded in model files.
+         * Safe to call from worker threads as well
+         * @param encoded contents of an image file
+         * @return decoded image
+         * @throws std::runtime_error if the data could not be decoded
+         * */
+        static auto decode(std::span<const std::byte> encoded) -> ImageData;
+
+        /**
+         * Reads the dimensions of an image file from its header without decoding it,
+         * used to tell how much memory the decoded image will take. Safe to call from worker threads
+         * @param path path to the texture file
+         * @return width and height, zero if the file could not be read
+         * */
+        static auto probe(const std::filesystem::path& path) -> Dimensions;
+
+        /**
+         * Reads the dimensions of an image file already in memory without decoding it
+         * @param encoded contents of an image file
+         * @return width and height, zero if the data could not be read
+         * */
+        static auto probe(std::span<const std::byte> encoded) -> Dimensions;
+
+        /**
+         * Returns true if the current OpenGL context can sample textures of the given format.
+         * Only reads the extensions found at startup, so it is safe to call from worker threads
+         * @param format texel layout
+         * */
+        [[nodiscard]]
+        static auto isFormatSupported(PixelFormat format) -> bool;
+
+        /**
+         * Creates a new Texture and uploads the given decoded image to it, compressed
+         * images through glCompressedTexImage2D. Must be called from the thread owning the OpenGL context
+         * @param image decoded image, see kT::Texture::decode()
+         * @param type type of texture
+         * @return newly created Texture
+         * */
+        static auto fromImage(const ImageData& image, kT::Texture::TextureType type) -> kT::Texture;
+
+        /**
+         * Creates a new Texture and queues the given decoded image for kT::TextureUploader, which sends its levels
+         * over the next frames, the smallest first. The texture is sampled blurry until its base level arrives.
+         * Must be called from the thread owning the OpenGL context
+         * @param image decoded image, its mips are generated if missing
+         * @param type type of texture
+         * @param streamed if true only the levels up to kT::TextureStreamer::s_InitialSize texels wide are sent, so
+         * kT::TextureStreamer can raise or lower its residency later. Larger levels are read again from the baked file
+         * of the image, images without one are kept in client memory
+         * @return newly created Texture
+         * */
+        static auto fromImageAsync(ImageData&& image, kT::Texture::TextureType type, bool streamed = false) -> kT::Texture;
+
         static auto fromData(const void *data, kT::Texture::TextureType type, std::int32_t width,
                              std::int32_t height) -> kT::Texture;
 
@@ -173,14 +324,40 @@ namespace kT {
     private:
         /**
          * Setup this bound texture
+         * @param data texels of the base level, with the one to four channels of the texture
+         * @param mips texels of every smaller level back to back, with the same channels, generated by OpenGL if empty
+         * */
+        auto setupTexture(const void* data, std::span<const std::uint8_t> mips = {}) const -> void;
+
+        /**
+         * Setup this texture with block compressed levels
+         * @param blocks every level back to back, the base one first, see kT::TextureCompressor
+         * */
+        auto setupCompressedTexture(std::span<const std::uint8_t> blocks) const -> void;
+
+        /**
+         * Allocates every resident level of this bound texture without filling them
+         * @param internalFormat layout of the texels in video memory
+         * @param format layout of the client texels, ignored for compressed formats
+         * */
+        auto allocateStorage(GLenum internalFormat, GLenum format) const -> void;
+
+        /**
+         * Returns the image the levels of this streamed texture are sent from, read again from its baked file when not kept
+         * @returns the image, or null if the baked file is gone or no longer matches this texture
          * */
-        auto setupTexture(const void* data) const -> void;
+        auto loadSource() const -> std::shared_ptr<const ImageData>;
 
         std::uint32_t   m_Id{};         // Identifier of this Vertex buffer object
         std::int32_t    m_Height{};     // Texture height
         std::int32_t    m_Width{};      // Texture width
-        std::int32_t    m_Channels{};   // components in image file
+        std::int32_t    m_Channels{};   // components of the uploaded texels, gray and alpha diffuse maps are expanded to RGBA
         TextureType     m_Type{};       // type of Texture
+        PixelFormat     m_Format{};     // layout of the texels in video memory
+        std::int32_t    m_ResidentLevel{};  // level of the image held by level 0 of the texture
+        std::shared_ptr<const ImageData> m_Source{};    // image of streamed textures without a baked file, the levels not resident are sent from it
+        std::filesystem::path m_Bake{};                 // baked file of streamed textures, read again whenever levels are raised
+        std::uint64_t   m_SourceHash{};                 // content hash the baked file is expected to have
     };
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,124 @@
+/**
+ * @file TextureCache.hh
+ * @author kT
+ * @brief Defines the TextureCache interface
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef TEXTURE_CACHE_HH
+#define TEXTURE_CACHE_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Project Libraries
+#include "Texture.hh"
+
+namespace kT {
+    /**
+     * Process wide cache of textures. Every image is decoded and uploaded
+     * once and shared by all the meshes and models that reference it.
+     * Lookups may happen from any thread, Insert(), Load(), Purge() and Clear()
+     * create or destroy textures and must be called from the thread owning the OpenGL context
+     * */
+    class TextureCache {
+    public:
+        /**
+         * Identifies a cached texture, the path is stored in canonical form
+         * */
+        struct Key {
+            std::string             path{};
+            Texture::TextureType    type{};
+
+            auto operator==(const Key& other) const -> bool = default;
+        };
+
+        struct KeyHash {
+            auto operator()(const Key& key) const -> std::size_t {
+                return std::hash<std::string>{}(key.path) ^ (static_cast<std::size_t>(key.type) << 1);
+            }
+        };
+
+        /**
+         * Cache usage counters
+         * */
+        struct Stats {
+            std::size_t hits{};             // lookups served from the cache
+            std::size_t misses{};           // textures decoded and uploaded
+            std::size_t bytesSaved{};       // GPU memory duplicated textures would have used
+            std::size_t bytesResident{};    // GPU memory held by cached textures
+        };
+
+        /**
+         * Builds the cache key for the texture file in path
+         * @param path path to the texture file
+         * @param type type of texture
+         * @returns key of the texture
+         * */
+        static auto MakeKey(const std::filesystem::path& path, Texture::TextureType type) -> Key;
+
+        /**
+         * Returns true if the texture identified by key is cached. Does not count as a lookup
+         * @param key key of the texture
+         * */
+        [[nodiscard]]
+        static auto Contains(const Key& key) -> bool;
+
+        /**
+         * Returns the cached texture for key and counts a hit
+         * @param key key of the texture
+         * @returns shared texture or nullptr if it is not cached
+         * */
+        static auto Find(const Key& key) -> std::shared_ptr<Texture>;
+
+        /**
+         * Adds a texture to the cache and counts a miss. If key is already
+         * cached the existing texture is kept and returned
+         * @param key key of the texture
+         * @param texture newly created texture
+         * @returns shared texture
+         * */
+        static auto Insert(const Key& key, Texture&& texture) -> std::shared_ptr<Texture>;
+
+        /**
+         * Returns the cached texture for the file in path, decoding
+         * and uploading it if it was not cached yet
+         * @param path path to the texture file
+         * @param type type of texture
+         * @returns shared texture
+         * @throws std::runtime_error if the file could not be decoded
+         * */
+        static auto Load(const std::filesystem::path& path, Texture::TextureType type) -> std::shared_ptr<Texture>;
+
+        /**
+         * Releases the textures no longer referenced outside the cache
+         * @returns amount of released textures
+         * */
+        static auto Purge() -> std::size_t;
+
+        /**
+         * Drops every cached texture and resets the counters
+         * */
+        static auto Clear() -> void;
+
+        [[nodiscard]]
+        static auto GetStats() -> Stats;
+
+        [[nodiscard]]
+        static auto GetSize() -> std::size_t;
+
+    private:
+        static std::mutex s_Mutex;
+        static std::unordered_map<Key, std::shared_ptr<Texture>, KeyHash> s_Textures;
+        static Stats s_Stats;
+    };
+}
+
+#endif // TEXTURE_CACHE_HH
@@ -0,0 +1,82 @@
+/**
+ * @file TextureCompressor.hh
+ * @author kT
+ * @brief Defines the block compression texture encoder
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef TEXTURE_COMPRESSOR_HH
+#define TEXTURE_COMPRESSOR_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Project Libraries
+#include "Texture.hh"
+
+namespace kT {
+    /**
+     * Encodes decoded images into the BC formats GPUs sample directly, so textures take a quarter
+     * to an eighth of the video memory of GL_RGBA8. Meant to run offline while baking, see kT::BakedTexture:
+     * every block fits its endpoints along the principal axis of its texels, refined by least squares
+     * for BC1. Palette matching runs four texels at a time with SSE2 where available and the blocks of
+     * an image are spread over the worker pool. BC7 blocks only use mode 6, a single RGBA line with
+     * sixteen levels, which covers most images well. Works on client memory only
+     * */
+    class TextureCompressor {
+    public:
+        /**
+         * Picks the format an image is compressed with. Normal maps keep their x and y in BC5,
+         * opaque images use BC1. Images with alpha use BC7, or BC3 when the alpha is only fully
+         * opaque or fully transparent: cutouts do not follow the color, which the single line of BC7 mode 6 needs
+         * @param image decoded RGBA image
+         * @param type what the texture is sampled as
+         * @returns a block compressed format
+         * */
+        [[nodiscard]]
+        static auto ChooseFormat(const Texture::ImageData& image, Texture::TextureType type) -> Texture::PixelFormat;
+
+        /**
+         * Compresses the base level and every mip of an image into kT::Texture::ImageData::blocks,
+         * generating the mips first if missing. The pixels and mips are kept
+         * @param image decoded image, images with fewer than four channels are read as RGBA
+         * @param format block compressed format
+         * @throws std::runtime_error if the format is not block compressed or the image is empty
+         * */
+        static auto Compress(Texture::ImageData& image, Texture::PixelFormat format) -> void;
+
+        /**
+         * Compresses one block of 4x4 texels
+         * @param texels sixteen RGBA texels, row by row
+         * @param format block compressed format
+         * @param block receives GetBlockBytes() bytes
+         * */
+        static auto CompressBlock(std::span<const std::uint8_t, 64> texels, Texture::PixelFormat format, std::uint8_t* block) -> void;
+
+        /**
+         * Returns the size of one 4x4 block of the given format, or of one texel of an uncompressed image
+         * @param channels components per texel of uncompressed images
+         * */
+        [[nodiscard]]
+        static auto GetBlockBytes(Texture::PixelFormat format, std::int32_t channels = 4) -> std::size_t;
+
+        /**
+         * Returns the size in bytes of one level of the given dimensions
+         * @param channels components per texel of uncompressed images
+         * */
+        [[nodiscard]]
+        static auto GetLevelBytes(Texture::PixelFormat format, std::int32_t width, std::int32_t height, std::int32_t channels = 4) -> std::size_t;
+
+        /**
+         * Returns the size in bytes of a full mip chain, the base level included
+         * @param channels components per texel of uncompressed images
+         * */
+        [[nodiscard]]
+        static auto GetChainBytes(Texture::PixelFormat format, std::int32_t width, std::int32_t height, std::int32_t channels = 4) -> std::size_t;
+    };
+}
+
+#endif // TEXTURE_COMPRESSOR_HH
@@ -0,0 +1,108 @@
+/**
+ * @file TextureStreamer.hh
+ * @author kT
+ * @brief Defines the texture residency manager
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef TEXTURE_STREAMER_HH
+#define TEXTURE_STREAMER_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+
+// Project Libraries
+#include "Mesh.hh"
+#include "Texture.hh"
+
+namespace kT {
+    /**
+     * Decides how much of the mip chain of every streamed texture lives in video memory. Textures start with
+     * their small levels only, the renderer reports the level the camera needs for the meshes it draws and the
+     * residency of their textures is raised to it. Raising past the budget evicts the large levels of the textures
+     * that went unseen the longest first. Must only be used from the thread owning the OpenGL context
+     * */
+    class TextureStreamer {
+    public:
+        /**
+         * Residency counters
+         * */
+        struct Stats {
+            std::size_t textures{};         // streamed textures alive
+            std::size_t fullyResident{};    // with their base level in video memory
+            std::size_t residentBytes{};
+            std::size_t requestedBytes{};   // what the levels asked for in the last frame would take
+            std::size_t raisedLevels{};     // since the start
+            std::size_t evictedLevels{};    // since the start
+            std::size_t deferredRaises{};   // in the last frame, for lack of budget or while still uploading
+        };
+
+        /**
+         * Largest dimension of the levels a streamed texture starts with, and keeps when evicted
+         * */
+        static constexpr std::int32_t s_InitialSize{ 128 };
+
+        /**
+         * Textures whose residency may be raised in one frame, each one reallocates its storage
+         * */
+        static constexpr std::size_t s_MaxRaisesPerFrame{ 8 };
+
+        /**
+         * Returns the first level at most kT::TextureStreamer::s_InitialSize texels wide and tall
+         * @param width width of the base level
+         * @param height height of the base level
+         * */
+        [[nodiscard]]
+        static auto GetInitialLevel(std::int32_t width, std::int32_t height) -> std::int32_t;
+
+        /**
+         * Starts managing the residency of a texture, ignored unless it is streamed, see kT::Texture::isStreamed().
+         * The texture is dropped once the last reference to it goes away
+         * @param texture shared texture, as returned by kT::TextureCache
+         * */
+        static auto Register(const std::shared_ptr<Texture>& texture) -> void;
+
+        /**
+         * Reports that a mesh is drawn this frame
+         * @param mesh mesh whose textures are sampled
+         * @param coordinatesPerPixel texture coordinate units covered by one pixel where the mesh is closest to the camera, 0 for full detail
+         * */
+        static auto Request(const Mesh& mesh, float coordinatesPerPixel) -> void;
+
+        /**
+         * Raises and evicts levels according to the requests of the last frame, call it once per frame before kT::TextureUploader::Update()
+         * */
+        static auto Update() -> void;
+
+        /**
+         * Sets the video memory streamed textures may take, the small levels they start with are always kept
+         * @param bytes budget in bytes
+         * */
+        static auto SetBudget(std::size_t bytes) -> void { s_Budget = bytes; }
+
+        [[nodiscard]]
+        static auto GetBudget() -> std::size_t { return s_Budget; }
+
+        [[nodiscard]]
+        static auto GetStats() -> const Stats& { return s_Stats; }
+
+    private:
+        struct Entry {
+            std::weak_ptr<Texture>  texture{};
+            std::int32_t            requested{ std::numeric_limits<std::int32_t>::max() };     // finest level asked for this frame
+            std::uint64_t           lastUsed{};     // frame it was last requested in
+        };
+
+        static std::unordered_map<const Texture*, Entry> s_Entries;
+        static std::uint64_t s_Frame;
+        static std::size_t s_Budget;
+        static Stats s_Stats;
+    };
+}
+
+#endif // TEXTURE_STREAMER_HH
@@ -0,0 +1,143 @@
+/**
+ * @file TextureUploader.hh
+ * @author kT
+ * @brief Defines the asynchronous texture upload queue
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef TEXTURE_UPLOADER_HH
+#define TEXTURE_UPLOADER_HH
+
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+// Project Libraries
+#include "Texture.hh"
+
+namespace kT {
+    /**
+     * Sends the levels of new textures to video memory a little every frame instead of all at once.
+     * Texels are copied into a ring of pixel buffer objects, persistently mapped when the driver allows it,
+     * and glTexSubImage2D sources them from there, so the transfer runs asynchronously instead of stalling
+     * the calling thread. A fence per buffer tells when the GPU is done reading it; a buffer still in use
+     * skips the frame rather than waiting. Levels go from the smallest one up and the base level of the
+     * texture follows them, so it is sampled blurry first and sharpens as the larger levels arrive.
+     * Must only be used from the thread owning the OpenGL context
+     * */
+    class TextureUploader {
+    public:
+        /**
+         * Levels of a texture whose storage is allocated, see kT::Texture::fromImageAsync()
+         * */
+        struct Request {
+            std::uint32_t       texture{};
+            std::shared_ptr<const Texture::ImageData> image{};     // with its full mip chain, released once every level is sent
+            GLenum              format{};       // of the client texels, or the internal format of compressed images
+            std::int32_t        firstLevel{};   // level of the image stored at level 0 of the texture, see kT::Texture::getResidentLevel()
+            std::int32_t        lastLevel{ -1 };    // last level of the image to send, -1 for the smallest one
+        };
+
+        /**
+         * Queue usage counters
+         * */
+        struct Stats {
+            std::size_t pendingTextures{};      // textures with levels not sent yet
+            std::size_t pendingBytes{};
+            std::size_t uploadedBytes{};        // since the start
+            std::size_t stalledFrames{};        // frames skipped because the GPU still read the next buffer
+        };
+
+        /**
+         * Pixel buffer objects in the ring, one frame of uploads each
+         * */
+        static constexpr std::size_t s_BufferCount{ 3 };
+
+        /**
+         * Smallest frame budget, enough for a row of the widest texture OpenGL allows
+         * */
+        static constexpr std::size_t s_MinFrameBytes{ 1 << 20 };
+
+        /**
+         * Queues the levels of a texture. When the request reaches the smallest level, that one is sent right away
+         * from client memory, it is a single texel or block and the texture is never sampled undefined
+         * @param request texture and the image to fill it with
+         * */
+        static auto Enqueue(Request&& request) -> void;
+
+        /**
+         * Drops the levels not sent yet of the given texture, called when it is destroyed or reallocated
+         * @param texture name of the texture
+         * */
+        static auto Cancel(std::uint32_t texture) -> void;
+
+        /**
+         * Returns the level of the given texture being sent, the ones after it are complete
+         * @param texture name of the texture
+         * @returns level of the texture, -1 if nothing is queued for it
+         * */
+        [[nodiscard]]
+        static auto GetPendingLevel(std::uint32_t texture) -> std::int32_t;
+
+        /**
+         * Sends queued levels until the frame budget is spent, call it once per frame
+         * */
+        static auto Update() -> void;
+
+        /**
+         * Sends every queued level now, waiting for the buffers as needed
+         * */
+        static auto Flush() -> void;
+
+        /**
+         * Sets the bytes Update() may send per frame, at least kT::TextureUploader::s_MinFrameBytes.
+         * Each buffer of the ring holds one frame worth, they are reallocated on the next update
+         * @param bytes upload size per frame
+         * */
+        static auto SetFrameBudget(std::size_t bytes) -> void { s_FrameBudget = std::max(bytes, s_MinFrameBytes); }
+
+        [[nodiscard]]
+        static auto GetFrameBudget() -> std::size_t { return s_FrameBudget; }
+
+        [[nodiscard]]
+        static auto GetStats() -> Stats;
+
+    private:
+        struct Job {
+            Request         request{};
+            std::int32_t    level{};            // of the image being sent, counting down to the first level of the request
+            std::int32_t    row{};              // texel rows of the level already sent
+        };
+
+        struct Buffer {
+            std::uint32_t   id{};
+            std::byte*      mapped{};           // null unless persistently mapped
+            GLsync          fence{};            // commands reading the buffer, checked before filling it again
+        };
+
+        /**
+         * Creates the ring, or recreates it when the frame budget changed
+         * */
+        static auto createBuffers() -> void;
+
+        /**
+         * Fills the next buffer of the ring and issues the uploads reading it
+         * @param wait if true, waits for the buffer instead of skipping the frame when the GPU still reads it
+         * */
+        static auto send(bool wait) -> void;
+
+        static std::deque<Job> s_Jobs;
+        static std::array<Buffer, s_BufferCount> s_Buffers;
+        static std::size_t s_BufferBytes;
+        static std::size_t s_NextBuffer;
+        static std::size_t s_FrameBudget;
+        static Stats s_Stats;
+    };
+}
+
+#endif // TEXTURE_UPLOADER_HH
@@ -77,7 +77,12 @@ namespace kT {
          * */
         static auto unbind() -> void;
 
-        auto useVertexBuffer(const VertexBuffer &buffer) -> void;
+        /**
+         * Sources the attributes of the buffer layout from the given buffer, one location each
+         * @param buffer vertex buffer to read from
+         * @param firstAttribute location of the first attribute of the layout
+         * */
+        auto useVertexBuffer(const VertexBuffer &buffer, std::uint32_t firstAttribute = 0) -> void;
 
         ~VertexArray();
 
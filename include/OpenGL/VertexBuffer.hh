@@ -12,6 +12,8 @@
 
 // C++ Standard Library
 #include <vector>
+#include <span>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -35,6 +37,10 @@ namespace kT {
         INT3_TYPE,      // Represents a three int data type
         INT4_TYPE,      // Represents a four int data type
         BOOL_TYPE,      // Represents a single boolean data type
+
+        USHORT4_TYPE,               // Represents four 16 bit unsigned integers, used normalized for quantized data
+        HALF2_TYPE,                 // Represents two 16 bit floats
+        INT_2_10_10_10_REV_TYPE,    // Represents three 10 bit and one 2 bit signed integers packed in 32 bits
         COUNT,
     };
 
@@ -70,6 +76,8 @@ namespace kT {
         static constexpr std::uint32_t s_DefaultShaderIntSize{ 4 };
         // Size in bytes for float
         static constexpr std::uint32_t s_DefaultShaderFloatSize{ 4 };
+        // Size in bytes for 16 bit types
+        static constexpr std::uint32_t s_DefaultShaderShortSize{ 2 };
 
         std::string     m_Name{};
         ShaderDataType  m_Type{};
@@ -96,6 +104,10 @@ namespace kT {
                 case ShaderDataType::INT3_TYPE:     return s_DefaultShaderIntSize * 3;
                 case ShaderDataType::INT4_TYPE:     return s_DefaultShaderIntSize * 4;
                 case ShaderDataType::BOOL_TYPE:     return 1;
+
+                case ShaderDataType::USHORT4_TYPE:  return s_DefaultShaderShortSize * 4;
+                case ShaderDataType::HALF2_TYPE:    return s_DefaultShaderShortSize * 2;
+                case ShaderDataType::INT_2_10_10_10_REV_TYPE: return 4;
             }
 
             return 0;
@@ -120,6 +132,10 @@ namespace kT {
                 case ShaderDataType::INT3_TYPE:     return 3;
                 case ShaderDataType::INT4_TYPE:     return 4;
                 case ShaderDataType::BOOL_TYPE:     return 1;
+
+                case ShaderDataType::USHORT4_TYPE:  return 4;
+                case ShaderDataType::HALF2_TYPE:    return 2;
+                case ShaderDataType::INT_2_10_10_10_REV_TYPE: return 4;
             }
 
             return 0;
@@ -140,6 +156,10 @@ namespace kT {
                 case ShaderDataType::INT3_TYPE: return GL_INT;
                 case ShaderDataType::INT4_TYPE: return GL_INT;
                 case ShaderDataType::BOOL_TYPE: return GL_BOOL;
+
+                case ShaderDataType::USHORT4_TYPE: return GL_UNSIGNED_SHORT;
+                case ShaderDataType::HALF2_TYPE: return GL_HALF_FLOAT;
+                case ShaderDataType::INT_2_10_10_10_REV_TYPE: return GL_INT_2_10_10_10_REV;
             }
 
             return GL_NONE;
@@ -195,6 +215,7 @@ namespace kT {
     public:
         explicit VertexBuffer() = default;
         VertexBuffer(const std::vector<float>& vertices, const BufferLayout& bufferLayout = s_DefaultLayout, GLenum usage = GL_STATIC_DRAW);
+        VertexBuffer(std::span<const float> vertices, const BufferLayout& bufferLayout = s_DefaultLayout, GLenum usage = GL_STATIC_DRAW);
         VertexBuffer(VertexBuffer && other) noexcept;
 
         auto getId() const -> std::uint32_t { return m_Id; }
@@ -209,6 +230,29 @@ namespace kT {
         auto unbind() const -> void { glBindBuffer(GL_ARRAY_BUFFER, 0); }
 
         auto load(const std::vector<float>& vertices, GLenum usage = GL_STATIC_DRAW) -> void;
+        auto load(std::span<const float> vertices, GLenum usage = GL_STATIC_DRAW) -> void;
+
+        /**
+         * Allocates immutable storage of the given size, left uninitialized.
+         * Its contents can only be written through update() afterwards, or through getMapped() if mapped
+         * @param bytes size of the storage in bytes
+         * @param mapped keep the storage persistently mapped for writing, if ARB_buffer_storage is available
+         * */
+        auto reserve(std::size_t bytes, bool mapped = false) -> void;
+
+        /**
+         * Returns the persistently mapped storage, empty if the buffer is not mapped. The mapping is
+         * coherent, so writes are seen by OpenGL without flushing, from any thread
+         * */
+        auto getMapped() const -> std::span<std::byte> { return { m_Mapped, m_Mapped != nullptr ? m_Size : 0 }; }
+
+        /**
+         * Overwrites part of the buffer contents
+         * @param offset offset in bytes from the start of the buffer
+         * @param vertices data to be copied
+         * */
+        auto update(std::size_t offset, std::span<const float> vertices) const -> void;
+        auto update(std::size_t offset, std::span<const std::byte> vertices) const -> void;
 
         auto setBufferLayout(const BufferLayout& layout) -> void { m_Layout = layout; }
         auto getBufferLayout() const -> const BufferLayout& { return m_Layout; }
@@ -223,6 +267,7 @@ namespace kT {
         std::uint32_t m_Size{};
         BufferLayout m_Layout{};
         bool m_ValidId{};
+        std::byte* m_Mapped{};
     };
 }
 
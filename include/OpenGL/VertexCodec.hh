@@ -0,0 +1,71 @@
+/**
+ * @file VertexCodec.hh
+ * @author kT
+ * @brief Defines the vertex and index stream compressor
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef VERTEX_CODEC_HH
+#define VERTEX_CODEC_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace kT {
+    /**
+     * Lossless compressor for the geometry of baked models, in the spirit of the meshoptimizer codec.
+     * Vertices are split in blocks, every byte of the vertex is delta encoded against the same byte of the
+     * previous vertex and the deltas of each byte are stored together, sixteen at a time with as few bits
+     * as the largest of them needs. Indices are delta encoded against the previous index and stored as
+     * varints. Both compress best on meshes optimized for vertex fetch, where neighbouring vertices and
+     * indices are close. Decoding uses SSE2 where available. Works on client memory only, so it may run on any thread
+     * */
+    class VertexCodec {
+    public:
+        /**
+         * Largest vertex size in bytes the codec handles
+         * */
+        static constexpr std::size_t s_MaxStride{ 256 };
+
+        /**
+         * Compresses interleaved vertices
+         * @param vertices vertex data, a whole amount of vertices
+         * @param stride bytes per vertex, a multiple of four up to s_MaxStride
+         * @returns the encoded stream
+         * @throws std::runtime_error if the stride is not supported
+         * */
+        static auto EncodeVertices(std::span<const std::byte> vertices, std::size_t stride) -> std::vector<std::byte>;
+
+        /**
+         * Decompresses vertices written by EncodeVertices()
+         * @param encoded the encoded stream
+         * @param stride bytes per vertex, the one used to encode them
+         * @param vertices receives the vertices, its size tells how many there are
+         * @returns false if the stream is corrupted or does not hold that many vertices
+         * */
+        [[nodiscard]]
+        static auto DecodeVertices(std::span<const std::byte> encoded, std::size_t stride, std::span<std::byte> vertices) -> bool;
+
+        /**
+         * Compresses indices
+         * @param indices index data
+         * @returns the encoded stream
+         * */
+        static auto EncodeIndices(std::span<const std::uint32_t> indices) -> std::vector<std::byte>;
+
+        /**
+         * Decompresses indices written by EncodeIndices()
+         * @param encoded the encoded stream
+         * @param indices receives the indices, its size tells how many there are
+         * @returns false if the stream is corrupted or does not hold that many indices
+         * */
+        [[nodiscard]]
+        static auto DecodeIndices(std::span<const std::byte> encoded, std::span<std::uint32_t> indices) -> bool;
+    };
+}
+
+#endif // VERTEX_CODEC_HH
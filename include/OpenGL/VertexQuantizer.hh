@@ -0,0 +1,87 @@
+/**
+ * @file VertexQuantizer.hh
+ * @author kT
+ * @brief Defines the compact vertex encoder
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef VERTEX_QUANTIZER_HH
+#define VERTEX_QUANTIZER_HH
+
+// C++ Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Third-Party Libraries
+#include <glm/glm.hpp>
+
+// Project Libraries
+#include "MeshData.hh"
+
+namespace kT {
+    /**
+     * Vertices encoded as kT::VertexFormat::COMPACT
+     * */
+    struct QuantizedVertices {
+        std::vector<std::byte>  data{};
+        PositionTransform       transform{};
+
+        [[nodiscard]]
+        auto getView() const -> VertexView { return { VertexFormat::COMPACT, data, transform }; }
+    };
+
+    /**
+     * Encodes vertices laid out as kT::VertexFormat::STANDARD into kT::VertexFormat::COMPACT,
+     * halving their size. Works on client memory only, so it may run on any thread
+     * */
+    class VertexQuantizer {
+    public:
+        /**
+         * Quantizes the given vertices. Positions are stored relative to the bounds of the
+         * mesh, which the returned transform maps back to model space
+         * @param vertices interleaved vertices laid out as kT::VertexFormat::STANDARD
+         * @returns the compact vertices
+         * */
+        static auto Quantize(std::span<const float> vertices) -> QuantizedVertices;
+
+        /**
+         * Converts a float to IEEE 754 half precision, rounding to nearest even
+         * @param value value to be converted
+         * @returns bits of the half float
+         * */
+        static auto FloatToHalf(float value) -> std::uint16_t;
+
+        /**
+         * Converts IEEE 754 half precision bits back to a float, exactly
+         * @param half bits of the half float
+         * @returns value of the half float
+         * */
+        static auto HalfToFloat(std::uint16_t half) -> float;
+
+        /**
+         * Packs a unit vector as GL_INT_2_10_10_10_REV, read back normalized by OpenGL
+         * @param normal vector to be packed, normalized first
+         * @returns packed vector, w is zero
+         * */
+        static auto PackNormal(const glm::vec3& normal) -> std::uint32_t;
+
+        /**
+         * Packs a tangent and its handedness as GL_INT_2_10_10_10_REV, the layout of kT::Mesh::GetTangentLayout()
+         * @param tangent xyz direction, normalized first, and w the sign of the bitangent
+         * @returns packed tangent
+         * */
+        static auto PackTangent(const glm::vec4& tangent) -> std::uint32_t;
+
+        /**
+         * Packs every tangent of a mesh, see kT::VertexQuantizer::PackTangent()
+         * @param tangents four floats per vertex, as kT::MeshData::tangents
+         * @returns one packed tangent per vertex
+         * */
+        static auto PackTangents(std::span<const float> tangents) -> std::vector<std::uint32_t>;
+    };
+}
+
+#endif // VERTEX_QUANTIZER_HH
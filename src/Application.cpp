@@ -9,7 +9,11 @@
 #include <Core/TimeManager.hh>
 #include <Core/ImGuiLayer.hh>
 
+#include <OpenGL/AsyncModelLoader.hh>
 #include <OpenGL/Renderer.hh>
+#include <OpenGL/TextureCache.hh>
+#include <OpenGL/TextureStreamer.hh>
+#include <OpenGL/TextureUploader.hh>
 
 namespace kT {
     auto Application::Init() -> void {
@@ -33,6 +37,9 @@ namespace kT {
         }
 
         TimeManager::UpdateDeltaTime();
+        AsyncModelLoader::Update();
+        TextureStreamer::Update();
+        TextureUploader::Update();
 
         for (auto& layer : *m_LayerStack)
             layer->OnUpdate(m_Window);
@@ -46,6 +53,19 @@ namespace kT {
         KATE_LOGGER_INFO("Time since start: {}", TimeManager::GetTime());
     }
 
+    auto Application::ShutDown() -> void {
+        for (auto& layer : *m_LayerStack)
+            layer->OnDetach();
+
+        // statics are destroyed after the window, their OpenGL objects must be gone by then
+        AsyncModelLoader::ShutDown();
+        TextureCache::Clear();
+
+        m_LayerStack.reset();
+        Renderer::ShutDown();
+        m_Window.reset();
+    }
+
     auto Application::PushLayer(std::shared_ptr<Layer> layer) -> void {
         layer->OnAttach(m_Window);
         m_LayerStack->addLayer(layer);
@@ -0,0 +1,42 @@
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <span>
+#include <string>
+
+// Project Libraries
+#include "Core/AssetFiles.hh"
+
+namespace kT {
+    namespace {
+        // extensions assimp and the native importers read
+        constexpr std::array<std::string_view, 6> s_ModelExtensions{ ".obj", ".fbx", ".gltf", ".glb", ".dae", ".blend" };
+        // extensions stb_image decodes and the asset textures use
+        constexpr std::array<std::string_view, 6> s_ImageExtensions{ ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd" };
+
+        auto hasExtension(const std::filesystem::path& path, std::span<const std::string_view> extensions) -> bool {
+            std::string extension{ path.extension().string() };
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) -> char { return static_cast<char>(std::tolower(c)); });
+            return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+        }
+    }
+
+    auto isModelFile(const std::filesystem::path& path) -> bool {
+        return hasExtension(path, s_ModelExtensions);
+    }
+
+    auto isImageFile(const std::filesystem::path& path) -> bool {
+        return hasExtension(path, s_ImageExtensions);
+    }
+
+    auto findModelFiles(const std::filesystem::path& root) -> std::vector<std::filesystem::path> {
+        std::vector<std::filesystem::path> models{};
+        for (const auto& entry : std::filesystem::recursive_directory_iterator{ root })
+            if (entry.is_regular_file() && isModelFile(entry.path()))
+                models.push_back(entry.path());
+
+        std::sort(models.begin(), models.end());
+        return models;
+    }
+}
@@ -0,0 +1,191 @@
+// C++ Standard Library
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+// Project Libraries
+#include "Core/AssetManifest.hh"
+#include "Core/Hash.hh"
+#include "Core/MappedFile.hh"
+
+namespace kT {
+    namespace {
+        constexpr std::string_view s_Header{ "kTAssetManifest" };
+
+        auto getWriteTime(const std::filesystem::path& path) -> std::int64_t {
+            return static_cast<std::int64_t>(std::filesystem::last_write_time(path).time_since_epoch().count());
+        }
+
+        // paths may hold spaces, so they are the rest of their line after the other fields
+        auto readPath(std::istringstream& line) -> std::filesystem::path {
+            std::string path{};
+            std::getline(line >> std::ws, path);
+            return std::filesystem::path{ std::u8string{ path.begin(), path.end() } };
+        }
+
+        auto writePath(std::ostream& stream, const std::filesystem::path& path) -> void {
+            const std::u8string utf8{ path.generic_u8string() };
+            stream << std::string_view{ reinterpret_cast<const char*>(utf8.data()), utf8.size() } << '\n';
+        }
+    }
+
+    AssetManifest::AssetManifest(const std::filesystem::path& path) {
+        std::ifstream file{ path };
+        if (!file)
+            return;
+
+        std::string line{};
+        std::getline(file, line);
+
+        std::istringstream header{ line };
+        std::string magic{};
+        std::uint32_t version{};
+        header >> magic >> version;
+
+        // an older manifest only means every asset is checked again from scratch
+        if (magic != s_Header || version != s_Version)
+            return;
+
+        while (std::getline(file, line)) {
+            std::istringstream output{ line };
+            std::string tag{};
+            Output entry{};
+            std::size_t sourceCount{};
+
+            output >> tag >> std::hex >> entry.settings >> std::dec >> entry.version >> sourceCount;
+            if (tag != "output" || !output)
+                throw std::runtime_error("Corrupted asset manifest " + path.string());
+
+            const std::filesystem::path outputPath{ readPath(output) };
+            entry.sources.resize(sourceCount);
+
+            for (auto& source : entry.sources) {
+                if (!std::getline(file, line))
+                    throw std::runtime_error("Corrupted asset manifest " + path.string());
+
+                std::istringstream stream{ line };
+                stream >> tag >> std::hex >> source.hash >> std::dec >> source.size >> source.writeTime;
+                if (tag != "source" || !stream)
+                    throw std::runtime_error("Corrupted asset manifest " + path.string());
+
+                source.path = readPath(stream);
+            }
+
+            m_Outputs.insert_or_assign(outputPath.generic_string(), std::move(entry));
+        }
+    }
+
+    auto AssetManifest::HashFile(const std::filesystem::path& path) -> AssetSource {
+        AssetSource source{};
+        source.path = path;
+        source.size = std::filesystem::file_size(path);
+        source.writeTime = getWriteTime(path);
+
+        // mapping an empty file fails, and there is nothing to hash anyway
+        if (source.size == 0)
+            source.hash = HashSeed;
+        else
+            source.hash = hashBytes(MappedFile{ path }.getData());
+
+        return source;
+    }
+
+    auto AssetManifest::save(const std::filesystem::path& path) const -> void {
+        std::filesystem::path temporary{ path };
+        temporary += ".tmp";
+
+        {
+            std::ofstream file{ temporary, std::ios::trunc };
+            if (!file)
+                throw std::runtime_error("Could not create asset manifest " + temporary.string());
+
+            std::lock_guard lock{ m_Mutex };
+            file << s_Header << ' ' << s_Version << '\n';
+
+            for (const auto& [output, entry] : m_Outputs) {
+                file << "output " << std::hex << entry.settings << std::dec << ' ' << entry.version << ' ' << entry.sources.size() << ' ';
+                writePath(file, output);
+
+                for (const auto& source : entry.sources) {
+                    file << "source " << std::hex << source.hash << std::dec << ' ' << source.size << ' ' << source.writeTime << ' ';
+                    writePath(file, source.path);
+                }
+            }
+
+            if (!file)
+                throw std::runtime_error("Could not write asset manifest " + temporary.string());
+        }
+
+        std::filesystem::rename(temporary, path);
+    }
+
+    auto AssetManifest::isUpToDate(const std::filesystem::path& output, const std::vector<std::filesystem::path>& sources,
+                                   std::uint64_t settings, std::uint32_t version) -> bool {
+        std::vector<AssetSource> recorded{};
+        bool refreshed{};
+
+        {
+            std::lock_guard lock{ m_Mutex };
+            const auto it{ m_Outputs.find(output.generic_string()) };
+            if (it == m_Outputs.end())
+                return false;
+
+            it->second.visited = true;
+            if (it->second.settings != settings || it->second.version != version)
+                return false;
+
+            recorded = it->second.sources;
+        }
+
+        std::error_code error{};
+        if (!std::filesystem::exists(output, error) || recorded.size() != sources.size())
+            return false;
+
+        for (std::size_t i{}; i < sources.size(); i++) {
+            if (recorded[i].path != sources[i] || !std::filesystem::exists(sources[i], error))
+                return false;
+
+            // a file with the same size and write time is assumed unchanged, anything else is hashed to be sure
+            if (std::filesystem::file_size(sources[i]) == recorded[i].size && getWriteTime(sources[i]) == recorded[i].writeTime)
+                continue;
+
+            AssetSource current{ HashFile(sources[i]) };
+            if (current.hash != recorded[i].hash)
+                return false;
+
+            // touched or copied without changing, the new size and write time let the next run skip the hash
+            recorded[i] = std::move(current);
+            refreshed = true;
+        }
+
+        if (refreshed) {
+            std::lock_guard lock{ m_Mutex };
+            if (const auto it{ m_Outputs.find(output.generic_string()) }; it != m_Outputs.end() && it->second.sources.size() == recorded.size())
+                it->second.sources = std::move(recorded);
+        }
+
+        return true;
+    }
+
+    auto AssetManifest::record(const std::filesystem::path& output, const std::vector<std::filesystem::path>& sources,
+                               std::uint64_t settings, std::uint32_t version) -> void {
+        Output entry{};
+        entry.settings = settings;
+        entry.version = version;
+        entry.visited = true;
+        entry.sources.reserve(sources.size());
+
+        for (const auto& source : sources)
+            entry.sources.push_back(HashFile(source));
+
+        std::lock_guard lock{ m_Mutex };
+        m_Outputs.insert_or_assign(output.generic_string(), std::move(entry));
+    }
+
+    auto AssetManifest::prune() -> std::size_t {
+        std::lock_guard lock{ m_Mutex };
+        return std::erase_if(m_Outputs, [](const auto& output) -> bool { return !output.second.visited; });
+    }
+}
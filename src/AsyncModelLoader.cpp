@@ -0,0 +1,88 @@
+// C++ Standard Library
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+// Project Libraries
+#include "Core/Logger.hh"
+#include "Core/ProcessMemory.hh"
+#include "Core/ThreadPool.hh"
+#include "OpenGL/AsyncModelLoader.hh"
+
+namespace kT {
+    auto ModelLoadHandle::getProgress() const -> float {
+        switch (m_State) {
+            case State::IMPORTING: return 0.0f;
+            case State::READY: return 1.0f;
+            case State::FAILED: return 0.0f;
+            case State::UPLOADING:
+                if (!m_Prepared || m_Prepared->meshes.empty())
+                    return 1.0f;
+
+                return static_cast<float>(m_Prepared->uploaded) / static_cast<float>(m_Prepared->meshes.size());
+        }
+
+        return 0.0f;
+    }
+
+    auto AsyncModelLoader::Load(const std::filesystem::path& path, const ModelLoadOptions& options) -> std::shared_ptr<ModelLoadHandle> {
+        auto handle{ std::make_shared<ModelLoadHandle>() };
+        handle->m_Path = path;
+        handle->m_Model = std::make_shared<Model>();
+        handle->m_Start = std::chrono::steady_clock::now();
+        handle->m_Import = ThreadPool::Get().submit([path, options]() -> PreparedModel { return Model::Prepare(path, options); });
+
+        s_Loads.push_back(handle);
+        return handle;
+    }
+
+    auto AsyncModelLoader::Update() -> void {
+        const auto deadline{ std::chrono::steady_clock::now() + s_FrameBudget };
+        bool uploaded{ false };
+
+        for (auto& handle : s_Loads) {
+            try {
+                if (handle->m_State == ModelLoadHandle::State::IMPORTING &&
+                    handle->m_Import.wait_for(std::chrono::seconds::zero()) == std::future_status::ready) {
+                    handle->m_Prepared.emplace(handle->m_Import.get());
+                    handle->m_State = ModelLoadHandle::State::UPLOADING;
+                }
+
+                if (handle->m_State != ModelLoadHandle::State::UPLOADING)
+                    continue;
+
+                // meshes whose textures are still decoding are retried next frame
+                while ((!uploaded || std::chrono::steady_clock::now() < deadline) &&
+                       handle->m_Model->uploadNext(*handle->m_Prepared, false))
+                    uploaded = true;
+
+                if (handle->m_Prepared->isUploaded()) {
+                    handle->m_State = ModelLoadHandle::State::READY;
+                    handle->m_Prepared.reset();
+
+                    const std::chrono::duration<double, std::milli> elapsed{ std::chrono::steady_clock::now() - handle->m_Start };
+                    KATE_LOGGER_INFO("Loaded model {} in {:.2f} ms, peak RSS {:.2f} MB", handle->m_Path.string(), elapsed.count(),
+                                     static_cast<double>(getPeakResidentBytes()) / (1024.0 * 1024.0));
+                }
+            }
+            catch (const std::exception& e) {
+                handle->m_State = ModelLoadHandle::State::FAILED;
+                handle->m_Error = e.what();
+                handle->m_Prepared.reset();
+
+                KATE_LOGGER_ERROR("Could not load model {}: {}", handle->m_Path.string(), e.what());
+            }
+        }
+
+        std::erase_if(s_Loads, [](const auto& handle) -> bool { return handle->isDone(); });
+    }
+
+    auto AsyncModelLoader::ShutDown() -> void {
+        for (auto& handle : s_Loads) {
+            if (handle->m_Import.valid())
+                handle->m_Import.wait();
+        }
+
+        s_Loads.clear();
+    }
+}
@@ -0,0 +1,528 @@
+// C++ Standard Library
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+// Project Libraries
+#include "Core/Hash.hh"
+#include "Core/Logger.hh"
+#include "Core/ThreadPool.hh"
+#include "OpenGL/BakedModel.hh"
+#include "OpenGL/Mesh.hh"
+#include "OpenGL/TangentGenerator.hh"
+#include "OpenGL/VertexCodec.hh"
+#include "OpenGL/VertexQuantizer.hh"
+
+namespace kT {
+    namespace {
+        auto alignUp(std::uint64_t value, std::uint64_t alignment) -> std::uint64_t {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        template<typename T>
+        auto readRecord(std::span<const std::byte> data, std::uint64_t offset) -> std::optional<T> {
+            if (offset > data.size() || data.size() - offset < sizeof(T))
+                return std::nullopt;
+
+            // records are not guaranteed to be aligned inside the mapping
+            T record{};
+            std::memcpy(&record, data.data() + offset, sizeof(T));
+            return record;
+        }
+
+        auto isInside(std::span<const std::byte> data, std::uint64_t offset, std::uint64_t bytes) -> bool {
+            return offset <= data.size() && bytes <= data.size() - offset;
+        }
+    }
+
+    auto BakedModel::GetBakePath(const std::filesystem::path& source) -> std::filesystem::path {
+        std::filesystem::path result{ source };
+        result += s_Extension;
+        return result;
+    }
+
+    auto BakedModel::HashSource(const std::filesystem::path& source, std::uint64_t seed) -> std::uint64_t {
+        MappedFile file{ source };
+        return hashBytes(file.getData(), seed);
+    }
+
+    auto BakedModel::Write(const std::filesystem::path& path, std::uint64_t sourceHash, std::span<const MeshData> meshes,
+                           std::span<const MeshInstance> instances, const SceneGraph& scene, const std::filesystem::path& modelDirectory,
+                           bool encodeGeometry) -> void {
+        FileHeader header{};
+        header.magic = s_Magic;
+        header.version = s_Version;
+        header.sourceHash = sourceHash;
+        header.meshCount = static_cast<std::uint32_t>(meshes.size());
+        header.vertexStride = Mesh::GetLayout().getStride();
+        header.geometryEncoding = encodeGeometry ? s_EncodedGeometry : s_RawGeometry;
+
+        std::vector<MeshRecord> meshRecords{};
+        std::vector<TextureRecord> textureRecords{};
+        std::vector<LodRecord> lodRecords{};
+        std::vector<MeshletRecord> meshletRecords{};
+        std::vector<InstanceRecord> instanceRecords{};
+        std::vector<NodeRecord> nodeRecords{};
+        std::string strings{};
+
+        // texture records of embedded images, every image is written once however many materials use it
+        std::vector<std::pair<std::size_t, const std::vector<std::byte>*>> embeddedRefs{};
+        std::vector<const std::vector<std::byte>*> images{};
+        std::unordered_map<const std::vector<std::byte>*, std::uint64_t> imageOffsets{};
+
+        for (const auto& mesh : meshes) {
+            MeshRecord record{};
+            record.firstTexture = static_cast<std::uint32_t>(textureRecords.size());
+            record.textureCount = static_cast<std::uint32_t>(mesh.textures.size());
+            record.vertexCount = mesh.vertices.size();
+            record.indexCount = mesh.indices.size();
+            record.tangentCount = mesh.tangents.size();
+            record.firstLod = static_cast<std::uint32_t>(lodRecords.size());
+            record.lodCount = static_cast<std::uint32_t>(mesh.lods.size());
+            record.firstMeshlet = static_cast<std::uint32_t>(meshletRecords.size());
+            record.meshletCount = static_cast<std::uint32_t>(mesh.meshlets.size());
+            record.boundsCenter[0] = mesh.bounds.center.x;
+            record.boundsCenter[1] = mesh.bounds.center.y;
+            record.boundsCenter[2] = mesh.bounds.center.z;
+            record.boundsRadius = mesh.bounds.radius;
+
+            for (const auto& lod : mesh.lods)
+                lodRecords.push_back({ lod.firstIndex, lod.indexCount, lod.error, 0 });
+
+            for (const auto& meshlet : mesh.meshlets) {
+                meshletRecords.push_back({ meshlet.firstIndex, meshlet.indexCount,
+                                           { meshlet.bounds.center.x, meshlet.bounds.center.y, meshlet.bounds.center.z }, meshlet.bounds.radius,
+                                           { meshlet.coneAxis.x, meshlet.coneAxis.y, meshlet.coneAxis.z }, meshlet.coneCutoff });
+            }
+
+            for (const auto& ref : mesh.textures) {
+                const std::string relative{ ref.path.lexically_relative(modelDirectory).generic_string() };
+
+                textureRecords.push_back({ static_cast<std::uint32_t>(ref.type), static_cast<std::uint32_t>(strings.size()),
+                                           static_cast<std::uint32_t>(relative.size()), 0, ref.rawSize.first, ref.rawSize.second });
+                strings.append(relative);
+
+                if (ref.embedded)
+                    embeddedRefs.push_back({ textureRecords.size() - 1, ref.embedded.get() });
+            }
+
+            meshRecords.push_back(record);
+        }
+
+        for (const auto& instance : instances)
+            instanceRecords.push_back({ instance.mesh, instance.node });
+
+        for (std::uint32_t i{}; i < scene.getSize(); i++) {
+            const std::string_view name{ scene.getName(i) };
+            NodeRecord& record{ nodeRecords.emplace_back() };
+            record.parent = scene.getParent(i);
+            record.nameOffset = static_cast<std::uint32_t>(strings.size());
+            record.nameLength = static_cast<std::uint32_t>(name.size());
+            strings.append(name);
+
+            const glm::mat4& local{ scene.getLocalTransform(i) };
+            for (int column{}; column < 4; column++) {
+                for (int row{}; row < 4; row++)
+                    record.local[column * 4 + row] = local[column][row];
+            }
+        }
+
+        header.textureCount = static_cast<std::uint32_t>(textureRecords.size());
+        header.lodCount = static_cast<std::uint32_t>(lodRecords.size());
+        header.meshletCount = static_cast<std::uint32_t>(meshletRecords.size());
+        header.instanceCount = static_cast<std::uint32_t>(instanceRecords.size());
+        header.nodeCount = static_cast<std::uint32_t>(nodeRecords.size());
+        header.stringBytes = static_cast<std::uint32_t>(strings.size());
+
+        // the vertices and tangents are also stored as they are uploaded, so loading the bake does not encode them again
+        const std::size_t compactStride{ Mesh::GetLayout(VertexFormat::COMPACT).getStride() };
+        const std::size_t packedTangentStride{ Mesh::GetTangentLayout().getStride() };
+        std::vector<QuantizedVertices> compact(meshes.size());
+        std::vector<std::vector<std::uint32_t>> packedTangents(meshes.size());
+
+        // vertices, indices, tangents, compact vertices and packed tangents of every mesh, compressed or viewed as they are
+        std::vector<std::array<std::vector<std::byte>, 5>> encoded(encodeGeometry ? meshes.size() : 0);
+        ThreadPool::Get().parallelFor(meshes.size(), [&](std::size_t i) -> void {
+            compact[i] = VertexQuantizer::Quantize(meshes[i].vertices);
+            packedTangents[i] = VertexQuantizer::PackTangents(meshes[i].tangents);
+
+            if (!encodeGeometry)
+                return;
+
+            encoded[i][0] = VertexCodec::EncodeVertices(std::as_bytes(std::span{ meshes[i].vertices }), header.vertexStride);
+            encoded[i][1] = VertexCodec::EncodeIndices(meshes[i].indices);
+            encoded[i][2] = VertexCodec::EncodeVertices(std::as_bytes(std::span{ meshes[i].tangents }), TangentGenerator::s_Components * sizeof(float));
+            encoded[i][3] = VertexCodec::EncodeVertices(compact[i].data, compactStride);
+            encoded[i][4] = VertexCodec::EncodeVertices(std::as_bytes(std::span{ packedTangents[i] }), packedTangentStride);
+        });
+
+        std::vector<std::array<std::span<const std::byte>, 5>> streams(meshes.size());
+        for (std::size_t i{}; i < meshes.size(); i++) {
+            if (encodeGeometry)
+                streams[i] = { encoded[i][0], encoded[i][1], encoded[i][2], encoded[i][3], encoded[i][4] };
+            else
+                streams[i] = { std::as_bytes(std::span{ meshes[i].vertices }), std::as_bytes(std::span{ meshes[i].indices }),
+                               std::as_bytes(std::span{ meshes[i].tangents }), compact[i].data, std::as_bytes(std::span{ packedTangents[i] }) };
+
+            meshRecords[i].vertexBytes = streams[i][0].size();
+            meshRecords[i].indexBytes = streams[i][1].size();
+            meshRecords[i].tangentBytes = streams[i][2].size();
+            meshRecords[i].compactBytes = streams[i][3].size();
+            meshRecords[i].packedTangentBytes = streams[i][4].size();
+
+            for (int axis{}; axis < 3; axis++) {
+                meshRecords[i].positionOffset[axis] = compact[i].transform.offset[axis];
+                meshRecords[i].positionScale[axis] = compact[i].transform.scale[axis];
+            }
+        }
+
+        // blobs start after the tables, each one aligned so the
+        // mapped data can be viewed as floats and integers directly
+        std::uint64_t offset{ sizeof(FileHeader) + meshRecords.size() * sizeof(MeshRecord) +
+                              textureRecords.size() * sizeof(TextureRecord) + lodRecords.size() * sizeof(LodRecord) +
+                              meshletRecords.size() * sizeof(MeshletRecord) + instanceRecords.size() * sizeof(InstanceRecord) +
+                              nodeRecords.size() * sizeof(NodeRecord) + strings.size() };
+
+        for (std::size_t i{}; i < meshes.size(); i++) {
+            meshRecords[i].vertexOffset = offset = alignUp(offset, s_BlobAlignment);
+            offset += meshRecords[i].vertexBytes;
+
+            meshRecords[i].indexOffset = offset = alignUp(offset, s_BlobAlignment);
+            offset += meshRecords[i].indexBytes;
+
+            meshRecords[i].tangentOffset = offset = alignUp(offset, s_BlobAlignment);
+            offset += meshRecords[i].tangentBytes;
+
+            meshRecords[i].compactOffset = offset = alignUp(offset, s_BlobAlignment);
+            offset += meshRecords[i].compactBytes;
+
+            meshRecords[i].packedTangentOffset = offset = alignUp(offset, s_BlobAlignment);
+            offset += meshRecords[i].packedTangentBytes;
+        }
+
+        for (const auto& [record, image] : embeddedRefs) {
+            if (!imageOffsets.contains(image)) {
+                imageOffsets[image] = offset = alignUp(offset, s_BlobAlignment);
+                offset += image->size();
+                images.push_back(image);
+            }
+
+            textureRecords[record].embeddedOffset = imageOffsets[image];
+            textureRecords[record].embeddedBytes = image->size();
+        }
+
+        // write to a temporary file first so a crash never leaves a truncated bake behind
+        std::filesystem::path temporary{ path };
+        temporary += ".tmp";
+
+        {
+            std::ofstream file{ temporary, std::ios::binary | std::ios::trunc };
+            if (!file)
+                throw std::runtime_error("Could not create baked model " + temporary.string());
+
+            static constexpr std::array<char, s_BlobAlignment> padding{};
+            auto pad{ [&file]() -> void {
+                const auto position{ static_cast<std::uint64_t>(file.tellp()) };
+                file.write(padding.data(), static_cast<std::streamsize>(alignUp(position, s_BlobAlignment) - position));
+            } };
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(meshRecords.data()), static_cast<std::streamsize>(meshRecords.size() * sizeof(MeshRecord)));
+            file.write(reinterpret_cast<const char*>(textureRecords.data()), static_cast<std::streamsize>(textureRecords.size() * sizeof(TextureRecord)));
+            file.write(reinterpret_cast<const char*>(lodRecords.data()), static_cast<std::streamsize>(lodRecords.size() * sizeof(LodRecord)));
+            file.write(reinterpret_cast<const char*>(meshletRecords.data()), static_cast<std::streamsize>(meshletRecords.size() * sizeof(MeshletRecord)));
+            file.write(reinterpret_cast<const char*>(instanceRecords.data()), static_cast<std::streamsize>(instanceRecords.size() * sizeof(InstanceRecord)));
+            file.write(reinterpret_cast<const char*>(nodeRecords.data()), static_cast<std::streamsize>(nodeRecords.size() * sizeof(NodeRecord)));
+            file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+            for (const auto& mesh : streams) {
+                for (const auto& stream : mesh) {
+                    pad();
+                    file.write(reinterpret_cast<const char*>(stream.data()), static_cast<std::streamsize>(stream.size()));
+                }
+            }
+
+            for (const auto* image : images) {
+                pad();
+                file.write(reinterpret_cast<const char*>(image->data()), static_cast<std::streamsize>(image->size()));
+            }
+
+            if (!file)
+                throw std::runtime_error("Could not write baked model " + temporary.string());
+        }
+
+        std::filesystem::rename(temporary, path);
+    }
+
+    auto BakedModel::Open(const std::filesystem::path& path, std::uint64_t sourceHash,
+                          const std::filesystem::path& modelDirectory) -> std::optional<BakedModel> {
+        std::error_code error{};
+        if (!std::filesystem::is_regular_file(path, error))
+            return std::nullopt;
+
+        BakedModel result{};
+
+        try {
+            result.m_File = MappedFile{ path };
+        }
+        catch (const std::runtime_error& e) {
+            KATE_LOGGER_WARN("Ignoring baked model {}: {}", path.string(), e.what());
+            return std::nullopt;
+        }
+
+        const auto data{ result.m_File.getData() };
+        const auto header{ readRecord<FileHeader>(data, 0) };
+
+        if (!header || header->magic != s_Magic || header->version != s_Version || header->vertexStride != Mesh::GetLayout().getStride() ||
+            (header->geometryEncoding != s_RawGeometry && header->geometryEncoding != s_EncodedGeometry))
+            return std::nullopt;
+
+        // the source changed since it was baked
+        if (header->sourceHash != sourceHash)
+            return std::nullopt;
+
+        const std::uint64_t meshTable{ sizeof(FileHeader) };
+        const std::uint64_t textureTable{ meshTable + header->meshCount * sizeof(MeshRecord) };
+        const std::uint64_t lodTable{ textureTable + header->textureCount * sizeof(TextureRecord) };
+        const std::uint64_t meshletTable{ lodTable + header->lodCount * sizeof(LodRecord) };
+        const std::uint64_t instanceTable{ meshletTable + header->meshletCount * sizeof(MeshletRecord) };
+        const std::uint64_t nodeTable{ instanceTable + header->instanceCount * sizeof(InstanceRecord) };
+        const std::uint64_t stringTable{ nodeTable + header->nodeCount * sizeof(NodeRecord) };
+
+        if (!isInside(data, stringTable, header->stringBytes))
+            return std::nullopt;
+
+        const std::string_view strings{ reinterpret_cast<const char*>(data.data() + stringTable), header->stringBytes };
+
+        // embedded images are copied out of the mapping, they outlive it in the texture decode tasks
+        std::unordered_map<std::uint64_t, std::shared_ptr<const std::vector<std::byte>>> images{};
+
+        result.m_Textures.reserve(header->textureCount);
+        for (std::uint32_t i{}; i < header->textureCount; i++) {
+            const auto record{ readRecord<TextureRecord>(data, textureTable + i * sizeof(TextureRecord)) };
+            if (!record || record->pathOffset > strings.size() || record->pathLength > strings.size() - record->pathOffset ||
+                !isInside(data, record->embeddedOffset, record->embeddedBytes) || record->rawWidth < 0 || record->rawHeight < 0 ||
+                (record->rawWidth != 0 && static_cast<std::uint64_t>(record->rawWidth) * static_cast<std::uint64_t>(record->rawHeight) * 4 != record->embeddedBytes))
+                return std::nullopt;
+
+            TextureRef& ref{ result.m_Textures.emplace_back(modelDirectory / strings.substr(record->pathOffset, record->pathLength),
+                                                            static_cast<Texture::TextureType>(record->type)) };
+
+            if (record->embeddedBytes != 0) {
+                auto& image{ images[record->embeddedOffset] };
+                if (!image) {
+                    const auto bytes{ data.subspan(record->embeddedOffset, record->embeddedBytes) };
+                    image = std::make_shared<const std::vector<std::byte>>(bytes.begin(), bytes.end());
+                }
+
+                ref.embedded = image;
+                ref.rawSize = { record->rawWidth, record->rawHeight };
+            }
+        }
+
+        result.m_Lods.reserve(header->lodCount);
+        for (std::uint32_t i{}; i < header->lodCount; i++) {
+            const auto record{ readRecord<LodRecord>(data, lodTable + i * sizeof(LodRecord)) };
+            if (!record)
+                return std::nullopt;
+
+            result.m_Lods.push_back({ record->firstIndex, record->indexCount, record->error });
+        }
+
+        result.m_Meshlets.reserve(header->meshletCount);
+        for (std::uint32_t i{}; i < header->meshletCount; i++) {
+            const auto record{ readRecord<MeshletRecord>(data, meshletTable + i * sizeof(MeshletRecord)) };
+            if (!record)
+                return std::nullopt;
+
+            result.m_Meshlets.push_back({ record->firstIndex, record->indexCount,
+                                          BoundingSphere{ glm::vec3(record->boundsCenter[0], record->boundsCenter[1], record->boundsCenter[2]), record->boundsRadius },
+                                          glm::vec3(record->coneAxis[0], record->coneAxis[1], record->coneAxis[2]), record->coneCutoff });
+        }
+
+        const bool encoded{ header->geometryEncoding == s_EncodedGeometry };
+        const std::size_t compactStride{ Mesh::GetLayout(VertexFormat::COMPACT).getStride() };
+        const std::size_t packedTangentStride{ Mesh::GetTangentLayout().getStride() };
+        result.m_Meshes.reserve(header->meshCount);
+        result.m_Decoded.resize(encoded ? header->meshCount : 0);
+        result.m_Records.reserve(header->meshCount);
+        result.m_VertexStride = header->vertexStride;
+
+        for (std::uint32_t i{}; i < header->meshCount; i++) {
+            const auto record{ readRecord<MeshRecord>(data, meshTable + i * sizeof(MeshRecord)) };
+
+            // mapped streams are viewed in place, so they have to be exactly as big as their data and aligned for it
+            if (!record || (!encoded && (record->vertexOffset % alignof(float) != 0 || record->indexOffset % alignof(std::uint32_t) != 0 ||
+                                         record->tangentOffset % alignof(float) != 0 || record->vertexBytes != record->vertexCount * sizeof(float) ||
+                                         record->indexBytes != record->indexCount * sizeof(std::uint32_t) ||
+                                         record->tangentBytes != record->tangentCount * sizeof(float) ||
+                                         record->compactBytes != record->vertexCount * sizeof(float) / header->vertexStride * compactStride ||
+                                         record->packedTangentBytes != record->tangentCount / TangentGenerator::s_Components * packedTangentStride)) ||
+                (record->tangentCount != 0 && record->tangentCount * header->vertexStride != record->vertexCount * sizeof(float) * TangentGenerator::s_Components) ||
+                !isInside(data, record->vertexOffset, record->vertexBytes) ||
+                !isInside(data, record->indexOffset, record->indexBytes) ||
+                !isInside(data, record->tangentOffset, record->tangentBytes) ||
+                !isInside(data, record->compactOffset, record->compactBytes) ||
+                !isInside(data, record->packedTangentOffset, record->packedTangentBytes) ||
+                record->firstTexture > result.m_Textures.size() || record->textureCount > result.m_Textures.size() - record->firstTexture ||
+                record->firstLod > result.m_Lods.size() || record->lodCount > result.m_Lods.size() - record->firstLod ||
+                record->firstMeshlet > result.m_Meshlets.size() || record->meshletCount > result.m_Meshlets.size() - record->firstMeshlet)
+                return std::nullopt;
+
+            const auto lods{ std::span<const LodLevel>{ result.m_Lods }.subspan(record->firstLod, record->lodCount) };
+            for (const auto& lod : lods) {
+                if (lod.firstIndex > record->indexCount || lod.indexCount > record->indexCount - lod.firstIndex)
+                    return std::nullopt;
+            }
+
+            const auto meshlets{ std::span<const Meshlet>{ result.m_Meshlets }.subspan(record->firstMeshlet, record->meshletCount) };
+            for (const auto& meshlet : meshlets) {
+                if (meshlet.firstIndex > record->indexCount || meshlet.indexCount > record->indexCount - meshlet.firstIndex)
+                    return std::nullopt;
+            }
+
+            // encoded meshes have no geometry to view until they are decoded
+            std::span<const float> vertices{};
+            std::span<const std::uint32_t> indices{};
+            std::span<const float> tangents{};
+            if (!encoded) {
+                vertices = { reinterpret_cast<const float*>(data.data() + record->vertexOffset), record->vertexCount };
+                indices = { reinterpret_cast<const std::uint32_t*>(data.data() + record->indexOffset), record->indexCount };
+                tangents = { reinterpret_cast<const float*>(data.data() + record->tangentOffset), record->tangentCount };
+            }
+
+            result.m_Records.push_back(*record);
+            result.m_Meshes.emplace_back(vertices, indices, tangents,
+                std::span<const TextureRef>{ result.m_Textures }.subspan(record->firstTexture, record->textureCount),
+                lods, meshlets, BoundingSphere{ glm::vec3(record->boundsCenter[0], record->boundsCenter[1], record->boundsCenter[2]), record->boundsRadius });
+        }
+
+        // parents must come first, which is what lets the scene update in one pass
+        for (std::uint32_t i{}; i < header->nodeCount; i++) {
+            const auto record{ readRecord<NodeRecord>(data, nodeTable + i * sizeof(NodeRecord)) };
+            if (!record || (record->parent != SceneGraph::s_NoParent && record->parent >= i) ||
+                record->nameOffset > strings.size() || record->nameLength > strings.size() - record->nameOffset)
+                return std::nullopt;
+
+            glm::mat4 local{ 1.0f };
+            for (int column{}; column < 4; column++) {
+                for (int row{}; row < 4; row++)
+                    local[column][row] = record->local[column * 4 + row];
+            }
+
+            result.m_Scene.addNode(record->parent, local, strings.substr(record->nameOffset, record->nameLength));
+        }
+
+        result.m_Instances.reserve(header->instanceCount);
+        for (std::uint32_t i{}; i < header->instanceCount; i++) {
+            const auto record{ readRecord<InstanceRecord>(data, instanceTable + i * sizeof(InstanceRecord)) };
+            if (!record || record->mesh >= header->meshCount || record->node >= header->nodeCount)
+                return std::nullopt;
+
+            result.m_Instances.push_back(MeshInstance{ record->mesh, record->node });
+        }
+
+        return result;
+    }
+
+    auto BakedModel::getGeometrySize(std::size_t mesh) const -> GeometrySize {
+        const MeshRecord& record{ m_Records.at(mesh) };
+        return GeometrySize{ record.vertexCount, record.indexCount, record.tangentCount };
+    }
+
+    auto BakedModel::getVertices(std::size_t mesh, VertexFormat format) const -> VertexView {
+        const MeshRecord& record{ m_Records.at(mesh) };
+        const auto data{ m_File.getData() };
+
+        VertexView view{};
+        view.format = format;
+        view.data = std::as_bytes(m_Meshes[mesh].vertices);
+
+        if (format == VertexFormat::COMPACT) {
+            view.transform.offset = glm::vec3(record.positionOffset[0], record.positionOffset[1], record.positionOffset[2]);
+            view.transform.scale = glm::vec3(record.positionScale[0], record.positionScale[1], record.positionScale[2]);
+        }
+
+        if (!m_Decoded.empty()) {
+            if (format == VertexFormat::COMPACT)
+                view.data = m_Decoded[mesh].compact;
+
+            view.tangents = std::as_bytes(std::span{ m_Decoded[mesh].packedTangents });
+            return view;
+        }
+
+        if (format == VertexFormat::COMPACT)
+            view.data = data.subspan(record.compactOffset, record.compactBytes);
+
+        view.tangents = data.subspan(record.packedTangentOffset, record.packedTangentBytes);
+        return view;
+    }
+
+    auto BakedModel::decode(std::size_t mesh, VertexFormat format) -> void {
+        if (m_Decoded.empty() || m_Decoded.at(mesh).decoded)
+            return;
+
+        // only this mesh is held decoded, the others stay compressed in the mapping until their turn. The float
+        // tangents are left in the file, the packed ones are what gets uploaded
+        const MeshRecord& record{ m_Records[mesh] };
+        const std::size_t vertexCount{ record.vertexCount * sizeof(float) / m_VertexStride };
+        const std::size_t compactStride{ Mesh::GetLayout(VertexFormat::COMPACT).getStride() };
+        DecodedMesh& decoded{ m_Decoded[mesh] };
+
+        const auto data{ m_File.getData() };
+        const auto vertexBytes{ format == VertexFormat::COMPACT ? data.subspan(record.compactOffset, record.compactBytes)
+                                                                : data.subspan(record.vertexOffset, record.vertexBytes) };
+        const auto indexBytes{ data.subspan(record.indexOffset, record.indexBytes) };
+        const auto tangentBytes{ data.subspan(record.packedTangentOffset, record.packedTangentBytes) };
+
+        bool valid{};
+        if (format == VertexFormat::COMPACT) {
+            decoded.compact.resize(vertexCount * compactStride);
+            valid = VertexCodec::DecodeVertices(vertexBytes, compactStride, decoded.compact);
+        }
+        else {
+            decoded.vertices.resize(record.vertexCount);
+            valid = VertexCodec::DecodeVertices(vertexBytes, m_VertexStride, std::as_writable_bytes(std::span{ decoded.vertices }));
+        }
+
+        decoded.indices.resize(record.indexCount);
+        decoded.packedTangents.resize(record.tangentCount / TangentGenerator::s_Components);
+
+        if (!valid || !VertexCodec::DecodeIndices(indexBytes, decoded.indices) ||
+            !VertexCodec::DecodeVertices(tangentBytes, Mesh::GetTangentLayout().getStride(), std::as_writable_bytes(std::span{ decoded.packedTangents })))
+            throw std::runtime_error("Corrupted geometry in mesh " + std::to_string(mesh) + " of a baked model");
+
+        // the compressed bytes are not read again
+        m_File.evict(vertexBytes);
+        m_File.evict(indexBytes);
+        m_File.evict(tangentBytes);
+
+        MeshView& view{ m_Meshes[mesh] };
+        view.vertices = decoded.vertices;
+        view.indices = decoded.indices;
+        decoded.decoded = true;
+    }
+
+    auto BakedModel::evict(std::size_t mesh) -> void {
+        MeshView& view{ m_Meshes.at(mesh) };
+
+        if (!m_Decoded.empty()) {
+            m_Decoded[mesh] = DecodedMesh{};
+            m_Decoded[mesh].decoded = true;
+            view = MeshView{};
+            return;
+        }
+
+        const MeshRecord& record{ m_Records[mesh] };
+        const auto data{ m_File.getData() };
+
+        m_File.evict(std::as_bytes(view.vertices));
+        m_File.evict(std::as_bytes(view.indices));
+        m_File.evict(std::as_bytes(view.tangents));
+        m_File.evict(data.subspan(record.compactOffset, record.compactBytes));
+        m_File.evict(data.subspan(record.packedTangentOffset, record.packedTangentBytes));
+    }
+}
@@ -0,0 +1,226 @@
+// C++ Standard Library
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Project Libraries
+#include "Core/Hash.hh"
+#include "Core/Logger.hh"
+#include "Core/MappedFile.hh"
+#include "OpenGL/BakedTexture.hh"
+#include "OpenGL/MipGenerator.hh"
+#include "OpenGL/TextureCompressor.hh"
+
+namespace kT {
+    auto BakedTexture::GetBakePath(const std::filesystem::path& source, Texture::TextureType type) -> std::filesystem::path {
+        std::filesystem::path result{ source };
+        result += ".";
+        result += Texture::getStrType(type);
+        result += s_Extension;
+        return result;
+    }
+
+    auto BakedTexture::HashSource(const std::filesystem::path& source) -> std::uint64_t {
+        MappedFile file{ source };
+        return hashBytes(file.getData());
+    }
+
+    auto BakedTexture::Write(const std::filesystem::path& path, std::uint64_t sourceHash, Texture::ImageData& image, bool srgb) -> void {
+        if (image.width <= 0 || image.height <= 0 || image.channels < 1 || image.channels > 4 || (image.format == Texture::PixelFormat::UNCOMPRESSED && !image.pixels))
+            throw std::runtime_error("Could not bake texture " + path.string() + ", the image is empty");
+
+        if (image.format != Texture::PixelFormat::UNCOMPRESSED && image.blocks.size() != TextureCompressor::GetChainBytes(image.format, image.width, image.height))
+            throw std::runtime_error("Could not bake texture " + path.string() + ", the image blocks do not match its size");
+
+        if (image.format == Texture::PixelFormat::UNCOMPRESSED && image.mips.size() != MipGenerator::GetMipBytes(image.width, image.height, image.channels))
+            MipGenerator::Generate(image, srgb);
+
+        FileHeader header{};
+        header.magic = s_Magic;
+        header.version = s_Version;
+        header.sourceHash = sourceHash;
+        header.width = image.width;
+        header.height = image.height;
+        header.channels = image.channels;
+        header.levels = MipGenerator::GetLevelCount(image.width, image.height);
+        header.format = static_cast<std::uint32_t>(image.format);
+        header.srgb = srgb ? 1 : 0;
+
+        // uncompressed levels come from the pixels and the mips, compressed ones from the blocks
+        std::vector<const std::uint8_t*> levelData(static_cast<std::size_t>(header.levels));
+        std::vector<LevelRecord> records(static_cast<std::size_t>(header.levels));
+        std::size_t offset{ sizeof(FileHeader) + records.size() * sizeof(LevelRecord) };
+        std::size_t sourceOffset{};
+
+        for (std::int32_t level{}, width{ image.width }, height{ image.height }; level < header.levels; level++) {
+            const std::size_t bytes{ TextureCompressor::GetLevelBytes(image.format, width, height, image.channels) };
+
+            if (image.format != Texture::PixelFormat::UNCOMPRESSED)
+                levelData[level] = image.blocks.data() + sourceOffset;
+            else
+                levelData[level] = level == 0 ? image.pixels.get() : image.mips.data() + sourceOffset;
+
+            if (image.format != Texture::PixelFormat::UNCOMPRESSED || level > 0)
+                sourceOffset += bytes;
+
+            offset = (offset + s_LevelAlignment - 1) / s_LevelAlignment * s_LevelAlignment;
+            records[level] = { offset, bytes };
+            offset += bytes;
+
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+        }
+
+        // write to a temporary file first so a crash never leaves a truncated bake behind. Loading may
+        // bake the same image from two workers, each writes its own file and the last rename wins
+        std::filesystem::path temporary{ path };
+        temporary += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+        {
+            std::ofstream file{ temporary, std::ios::binary | std::ios::trunc };
+            if (!file)
+                throw std::runtime_error("Could not create baked texture " + temporary.string());
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(LevelRecord)));
+
+            static constexpr std::array<char, s_LevelAlignment> padding{};
+            std::size_t written{ sizeof(FileHeader) + records.size() * sizeof(LevelRecord) };
+
+            for (std::size_t level{}; level < records.size(); level++) {
+                file.write(padding.data(), static_cast<std::streamsize>(records[level].offset - written));
+                file.write(reinterpret_cast<const char*>(levelData[level]), static_cast<std::streamsize>(records[level].bytes));
+                written = records[level].offset + records[level].bytes;
+            }
+
+            if (!file)
+                throw std::runtime_error("Could not write baked texture " + temporary.string());
+        }
+
+        std::filesystem::rename(temporary, path);
+    }
+
+    auto BakedTexture::Open(const std::filesystem::path& path, std::uint64_t sourceHash, bool srgb) -> std::optional<Texture::ImageData> {
+        std::error_code error{};
+        if (!std::filesystem::is_regular_file(path, error))
+            return std::nullopt;
+
+        MappedFile file{};
+        try {
+            file = MappedFile{ path };
+        }
+        catch (const std::runtime_error& e) {
+            KATE_LOGGER_WARN("Ignoring baked texture {}: {}", path.string(), e.what());
+            return std::nullopt;
+        }
+
+        const auto data{ file.getData() };
+        if (data.size() < sizeof(FileHeader))
+            return std::nullopt;
+
+        FileHeader header{};
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        if (header.magic != s_Magic || header.version != s_Version || header.sourceHash != sourceHash || (header.srgb != 0) != srgb || header.width <= 0 || header.height <= 0 ||
+            header.channels < 1 || header.channels > 4 || header.levels != MipGenerator::GetLevelCount(header.width, header.height) || header.format > static_cast<std::uint32_t>(Texture::PixelFormat::BC7))
+            return std::nullopt;
+
+        const auto format{ static_cast<Texture::PixelFormat>(header.format) };
+        std::vector<LevelRecord> records(static_cast<std::size_t>(header.levels));
+        if (data.size() - sizeof(FileHeader) < records.size() * sizeof(LevelRecord))
+            return std::nullopt;
+
+        std::memcpy(records.data(), data.data() + sizeof(FileHeader), records.size() * sizeof(LevelRecord));
+
+        for (std::int32_t level{}, width{ header.width }, height{ header.height }; level < header.levels; level++) {
+            const LevelRecord& record{ records[level] };
+            if (record.bytes != TextureCompressor::GetLevelBytes(format, width, height, header.channels) || record.offset > data.size() || data.size() - record.offset < record.bytes)
+                return std::nullopt;
+
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+        }
+
+        const auto* bytes{ reinterpret_cast<const std::uint8_t*>(data.data()) };
+
+        Texture::ImageData image{};
+        image.width = header.width;
+        image.height = header.height;
+        image.channels = header.channels;
+        image.format = format;
+        image.bake = path;
+        image.sourceHash = sourceHash;
+
+        if (format != Texture::PixelFormat::UNCOMPRESSED) {
+            image.blocks.reserve(TextureCompressor::GetChainBytes(format, header.width, header.height));
+            for (const LevelRecord& record : records)
+                image.blocks.insert(image.blocks.end(), bytes + record.offset, bytes + record.offset + record.bytes);
+
+            return image;
+        }
+
+        // the base level is owned like the pixels stb_image returns, so both free the same way
+        image.pixels = { static_cast<std::uint8_t*>(std::malloc(records[0].bytes)), std::free };
+        if (!image.pixels)
+            throw std::runtime_error("Could not allocate baked texture " + path.string());
+
+        std::memcpy(image.pixels.get(), bytes + records[0].offset, records[0].bytes);
+
+        image.mips.reserve(MipGenerator::GetMipBytes(header.width, header.height, header.channels));
+        for (std::size_t level{ 1 }; level < records.size(); level++)
+            image.mips.insert(image.mips.end(), bytes + records[level].offset, bytes + records[level].offset + records[level].bytes);
+
+        return image;
+    }
+
+    auto BakedTexture::Decode(const std::filesystem::path& source, Texture::TextureType type) -> Texture::ImageData {
+        const bool srgb{ type == Texture::TextureType::DIFFUSE };
+        const std::filesystem::path bakePath{ GetBakePath(source, type) };
+        const std::uint64_t sourceHash{ HashSource(source) };
+
+        // a rejected bake of this use is stale or corrupted, bakes of the other uses live in files of their own
+        std::optional<Texture::ImageData> baked{ Open(bakePath, sourceHash, srgb) };
+        if (baked && Texture::isFormatSupported(baked->format))
+            return std::move(*baked);
+
+        // drivers without the block format of a valid bake get the texels decoded from the source, the bake stays
+        Texture::ImageData image{ Texture::decode(source) };
+        MipGenerator::Generate(image, srgb);
+
+        if (!baked) {
+            try {
+                Write(bakePath, sourceHash, image, srgb);
+                image.bake = bakePath;
+                image.sourceHash = sourceHash;
+            }
+            catch (const std::exception& e) {
+                KATE_LOGGER_WARN("Could not cache the mips of texture {}: {}", source.string(), e.what());
+            }
+        }
+
+        return image;
+    }
+
+    auto BakedTexture::Bake(const std::filesystem::path& source, Texture::TextureType type, bool compress) -> Texture::PixelFormat {
+        const bool srgb{ type == Texture::TextureType::DIFFUSE };
+        const std::uint64_t sourceHash{ HashSource(source) };
+        Texture::ImageData image{ Texture::decode(source) };
+
+        // offline the sharper filter is worth its cost, loading falls back to the box filter
+        MipGenerator::Generate(image, srgb, MipGenerator::Filter::KAISER);
+
+        if (compress)
+            TextureCompressor::Compress(image, TextureCompressor::ChooseFormat(image, type));
+
+        Write(GetBakePath(source, type), sourceHash, image, srgb);
+        return image.format;
+    }
+}
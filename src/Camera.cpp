@@ -101,6 +101,7 @@ namespace kT {
 
         m_Projection = glm::perspective(glm::radians(static_cast<float>(m_Fov)),
                                         static_cast<float>(window.GetWidth()) / static_cast<float>(window.GetHeight()), nearPlane, farPlane);
+        m_ViewportHeight = static_cast<float>(window.GetHeight());
     }
 
     auto Camera::getFieldOfView() const -> double {
@@ -114,6 +115,7 @@ namespace kT {
     auto Camera::updateProjection(double width, double height) -> void {
         m_Projection = glm::perspective(glm::radians(static_cast<float>(m_Fov)),
                                         static_cast<float>(width) / static_cast<float>(height),nearPlane, farPlane);
+        m_ViewportHeight = static_cast<float>(height);
     }
 
     auto Camera::setFieldOfView(double offset) -> void {
@@ -127,6 +129,11 @@ namespace kT {
         return m_CameraPos;
     }
 
+    auto Camera::getScreenSize(float worldSize, float distance) const -> float {
+        // projection[1][1] is the cotangent of half the vertical field of view
+        return worldSize * m_Projection[1][1] * 0.5f * m_ViewportHeight / distance;
+    }
+
     auto Camera::Init(const Window &window, const glm::vec3 &startPos) -> void {
         // yaw is initialized to -90.0 degrees since a yaw of
         // 0.0 results in a direction vector pointing to the right,
@@ -146,5 +153,6 @@ namespace kT {
 
         m_Projection = glm::perspective(glm::radians(static_cast<float>(m_Fov)),
                                         static_cast<float>(window.GetWidth()) / static_cast<float>(window.GetHeight()), nearPlane, farPlane);
+        m_ViewportHeight = static_cast<float>(window.GetHeight());
     }
 }
\ No newline at end of file
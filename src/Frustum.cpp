@@ -0,0 +1,31 @@
+// C++ Standard Library
+#include <algorithm>
+
+// Project Libraries
+#include "OpenGL/Frustum.hh"
+
+namespace kT {
+    Frustum::Frustum(const glm::mat4& matrix) {
+        auto row{ [&matrix](int i) -> glm::vec4 { return glm::vec4(matrix[0][i], matrix[1][i], matrix[2][i], matrix[3][i]); } };
+
+        const glm::vec4 x{ row(0) };
+        const glm::vec4 y{ row(1) };
+        const glm::vec4 z{ row(2) };
+        const glm::vec4 w{ row(3) };
+
+        m_Planes = { w + x, w - x, w + y, w - y, w + z, w - z };
+
+        // normalized so the plane equation gives distances
+        for (auto& plane : m_Planes) {
+            const float length{ glm::length(glm::vec3(plane)) };
+            if (length > 0.0f)
+                plane = plane * (1.0f / length);
+        }
+    }
+
+    auto Frustum::intersects(const BoundingSphere& sphere) const -> bool {
+        return std::all_of(m_Planes.begin(), m_Planes.end(), [&sphere](const glm::vec4& plane) -> bool {
+            return glm::dot(glm::vec3(plane), sphere.center) + plane.w >= -sphere.radius;
+        });
+    }
+}
@@ -0,0 +1,289 @@
+// C++ Standard Library
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+// Project Libraries
+#include "Core/Logger.hh"
+#include "OpenGL/GeometryArena.hh"
+#include "OpenGL/Mesh.hh"
+
+namespace kT {
+    std::vector<std::unique_ptr<GeometryArena::Block>> GeometryArena::s_Blocks{};
+
+    GeometryArena::Allocation::Allocation(Allocation&& other) noexcept
+        :   m_Range{ other.m_Range }, m_Valid{ std::exchange(other.m_Valid, false) } {}
+
+    auto GeometryArena::Allocation::operator=(Allocation&& other) noexcept -> Allocation& {
+        if (this != &other) {
+            if (m_Valid)
+                release(m_Range);
+
+            m_Range = other.m_Range;
+            m_Valid = std::exchange(other.m_Valid, false);
+        }
+
+        return *this;
+    }
+
+    GeometryArena::Allocation::~Allocation() {
+        if (m_Valid)
+            release(m_Range);
+    }
+
+    auto GeometryArena::FreeList::allocate(std::size_t count) -> std::optional<std::size_t> {
+        if (count == 0)
+            return 0;
+
+        // first fit keeps allocations packed towards the start of the block
+        for (auto it{ m_Ranges.begin() }; it != m_Ranges.end(); ++it) {
+            const auto [offset, size] { *it };
+            if (size < count)
+                continue;
+
+            m_Ranges.erase(it);
+            if (size > count)
+                m_Ranges.emplace(offset + count, size - count);
+
+            return offset;
+        }
+
+        return std::nullopt;
+    }
+
+    auto GeometryArena::FreeList::release(std::size_t offset, std::size_t count) -> void {
+        if (count == 0)
+            return;
+
+        auto it{ m_Ranges.emplace(offset, count).first };
+
+        // merge with the following range
+        if (auto next{ std::next(it) }; next != m_Ranges.end() && it->first + it->second == next->first) {
+            it->second += next->second;
+            m_Ranges.erase(next);
+        }
+
+        // merge with the preceding range
+        if (it != m_Ranges.begin()) {
+            if (auto previous{ std::prev(it) }; previous->first + previous->second == it->first) {
+                previous->second += it->second;
+                m_Ranges.erase(it);
+            }
+        }
+    }
+
+    auto GeometryArena::FreeList::getFree() const -> std::size_t {
+        std::size_t total{};
+        for (const auto& [offset, size] : m_Ranges)
+            total += size;
+
+        return total;
+    }
+
+    auto GeometryArena::FreeList::getFragmentation() const -> float {
+        std::size_t total{};
+        std::size_t largest{};
+
+        for (const auto& [offset, size] : m_Ranges) {
+            total += size;
+            largest = std::max(largest, size);
+        }
+
+        return total == 0 ? 0.0f : 1.0f - static_cast<float>(largest) / static_cast<float>(total);
+    }
+
+    GeometryArena::Block::Block(VertexFormat vertexFormat, std::size_t vertexCount, std::size_t indexBytes, bool hasTangents)
+        :   format{ vertexFormat }, stride{ Mesh::GetLayout(vertexFormat).getStride() },
+            tangentStride{ hasTangents ? Mesh::GetTangentLayout().getStride() : 0 }, vertices{}, tangents{}, indices{}, vertexArray{},
+            freeVertices{ vertexCount }, freeIndices{ indexBytes }
+    {
+        // reserving the element buffer binds it, which must not touch the bound vertex array
+        VertexArray::unbind();
+
+        vertices.setBufferLayout(Mesh::GetLayout(format));
+        vertices.reserve(vertexCount * stride, s_PersistentMapping);
+        indices.reserve(indexBytes / sizeof(std::uint32_t), s_PersistentMapping);
+
+        // the vertex array remembers the attribute setup and the element
+        // buffer, drawing from this block only needs the vertex array bound
+        vertexArray.useVertexBuffer(vertices);
+
+        if (hasTangents) {
+            VertexArray::unbind();
+            tangents.setBufferLayout(Mesh::GetTangentLayout());
+            tangents.reserve(vertexCount * tangentStride, s_PersistentMapping);
+            vertexArray.useVertexBuffer(tangents, Mesh::s_TangentAttribute);
+        }
+
+        indices.bind();
+        VertexArray::unbind();
+    }
+
+    GeometryArena::Block::~Block() {
+        if (releaseFence != nullptr)
+            glDeleteSync(releaseFence);
+    }
+
+    auto GeometryArena::Allocate(VertexFormat format, std::size_t vertexCount, std::size_t indexBytes, bool tangents) -> Allocation {
+        indexBytes = (indexBytes + s_IndexAlignment - 1) / s_IndexAlignment * s_IndexAlignment;
+
+        auto reserve{ [vertexCount, indexBytes](std::size_t index) -> std::optional<Allocation> {
+            Block& block{ *s_Blocks[index] };
+
+            const auto firstVertex{ block.freeVertices.allocate(vertexCount) };
+            if (!firstVertex)
+                return std::nullopt;
+
+            const auto indexOffset{ block.freeIndices.allocate(indexBytes) };
+            if (!indexOffset) {
+                block.freeVertices.release(*firstVertex, vertexCount);
+                return std::nullopt;
+            }
+
+            ++block.allocations;
+            return Allocation{ Range{ static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(*firstVertex), static_cast<std::uint32_t>(vertexCount),
+                                      static_cast<std::uint32_t>(*indexOffset), static_cast<std::uint32_t>(indexBytes) } };
+        } };
+
+        for (std::size_t i{}; i < s_Blocks.size(); i++) {
+            if (s_Blocks[i] == nullptr || s_Blocks[i]->format != format || (s_Blocks[i]->tangentStride != 0) != tangents)
+                continue;
+
+            if (auto allocation{ reserve(i) })
+                return std::move(*allocation);
+        }
+
+        const std::size_t blockVertices{ std::max(vertexCount, s_BlockVertexBytes / Mesh::GetLayout(format).getStride()) };
+        const std::size_t blockIndexBytes{ std::max(indexBytes, s_BlockIndexBytes) };
+
+        if (blockVertices > UINT32_MAX || blockIndexBytes > UINT32_MAX)
+            throw std::runtime_error("Geometry does not fit in a single arena block");
+
+        // reuse the slot of a block destroyed by Trim() before growing the list
+        auto slot{ std::find(s_Blocks.begin(), s_Blocks.end(), nullptr) };
+        if (slot == s_Blocks.end())
+            slot = s_Blocks.insert(s_Blocks.end(), nullptr);
+
+        *slot = std::make_unique<Block>(format, blockVertices, blockIndexBytes, tangents);
+        KATE_LOGGER_INFO("Created geometry arena block with room for {} vertices{} and {} index bytes", blockVertices,
+                         tangents ? " with tangents" : "", blockIndexBytes);
+
+        return std::move(*reserve(static_cast<std::size_t>(std::distance(s_Blocks.begin(), slot))));
+    }
+
+    auto GeometryArena::Upload(const Range& range, std::span<const std::byte> vertices, std::span<const std::byte> tangents,
+                               std::span<const std::uint32_t> indices, GLenum indexType) -> void {
+        Block& block{ *s_Blocks.at(range.block) };
+        const bool hasTangents{ block.tangentStride != 0 && !tangents.empty() };
+
+        if (block.isMapped()) {
+            // a released range may still be read by frames in flight, wait for them before overwriting it
+            if (block.releaseFence != nullptr) {
+                glClientWaitSync(block.releaseFence, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+                glDeleteSync(block.releaseFence);
+                block.releaseFence = nullptr;
+            }
+
+            std::memcpy(block.vertices.getMapped().data() + range.firstVertex * block.stride, vertices.data(), vertices.size());
+            if (hasTangents)
+                std::memcpy(block.tangents.getMapped().data() + range.firstVertex * block.tangentStride, tangents.data(), tangents.size());
+
+            std::byte* destination{ block.indices.getMapped().data() + range.indexOffset };
+            if (indexType == GL_UNSIGNED_SHORT) {
+                for (std::size_t i{}; i < indices.size(); i++) {
+                    const auto narrow{ static_cast<std::uint16_t>(indices[i]) };
+                    std::memcpy(destination + i * sizeof(std::uint16_t), &narrow, sizeof(narrow));
+                }
+            }
+            else
+                std::memcpy(destination, indices.data(), indices.size_bytes());
+
+            return;
+        }
+
+        // same as on creation, keep the element buffer binding of the vertex arrays intact
+        VertexArray::unbind();
+
+        block.vertices.update(range.firstVertex * block.stride, vertices);
+        if (hasTangents)
+            block.tangents.update(range.firstVertex * block.tangentStride, tangents);
+
+        if (indexType == GL_UNSIGNED_SHORT) {
+            std::vector<std::uint16_t> narrow(indices.begin(), indices.end());
+            block.indices.update(range.indexOffset, std::span<const std::uint16_t>{ narrow });
+        }
+        else
+            block.indices.update(range.indexOffset, indices);
+    }
+
+    auto GeometryArena::Bind(std::uint32_t block) -> void {
+        s_Blocks.at(block)->vertexArray.bind();
+    }
+
+    auto GeometryArena::GetStats() -> Stats {
+        Stats stats{};
+        std::size_t freeVertexBytes{};
+        std::size_t freeIndexBytes{};
+        float vertexFragmentation{};
+        float indexFragmentation{};
+
+        for (const auto& block : s_Blocks) {
+            if (block == nullptr)
+                continue;
+
+            ++stats.blocks;
+            stats.allocations += block->allocations;
+
+            stats.vertexBytesCapacity += block->freeVertices.getCapacity() * (block->stride + block->tangentStride);
+            stats.indexBytesCapacity += block->freeIndices.getCapacity();
+
+            // weight the fragmentation of every block by its free space
+            const std::size_t blockFreeVertices{ block->freeVertices.getFree() };
+            const std::size_t blockFreeIndices{ block->freeIndices.getFree() };
+
+            freeVertexBytes += blockFreeVertices * (block->stride + block->tangentStride);
+            freeIndexBytes += blockFreeIndices;
+            vertexFragmentation += block->freeVertices.getFragmentation() * static_cast<float>(blockFreeVertices * (block->stride + block->tangentStride));
+            indexFragmentation += block->freeIndices.getFragmentation() * static_cast<float>(blockFreeIndices);
+        }
+
+        stats.vertexBytesUsed = stats.vertexBytesCapacity - freeVertexBytes;
+        stats.indexBytesUsed = stats.indexBytesCapacity - freeIndexBytes;
+        stats.vertexFragmentation = freeVertexBytes == 0 ? 0.0f : vertexFragmentation / static_cast<float>(freeVertexBytes);
+        stats.indexFragmentation = freeIndexBytes == 0 ? 0.0f : indexFragmentation / static_cast<float>(freeIndexBytes);
+
+        return stats;
+    }
+
+    auto GeometryArena::Trim() -> void {
+        // slots are kept so the block indices of live allocations stay valid
+        for (auto& block : s_Blocks) {
+            if (block != nullptr && block->allocations == 0)
+                block.reset();
+        }
+    }
+
+    auto GeometryArena::ShutDown() -> void {
+        s_Blocks.clear();
+    }
+
+    auto GeometryArena::release(const Range& range) -> void {
+        if (range.block >= s_Blocks.size() || s_Blocks[range.block] == nullptr)
+            return;
+
+        Block& block{ *s_Blocks[range.block] };
+        block.freeVertices.release(range.firstVertex, range.vertexCount);
+        block.freeIndices.release(range.indexOffset, range.indexBytes);
+        --block.allocations;
+
+        if (block.isMapped()) {
+            if (block.releaseFence != nullptr)
+                glDeleteSync(block.releaseFence);
+
+            block.releaseFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+    }
+}
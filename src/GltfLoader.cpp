@@ -0,0 +1,616 @@
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+// Project Libraries
+#include "Core/Json.hh"
+#include "Core/Logger.hh"
+#include "Core/MappedFile.hh"
+#include "Core/ThreadPool.hh"
+#include "OpenGL/GltfLoader.hh"
+#include "OpenGL/NormalGenerator.hh"
+
+namespace kT {
+    namespace {
+        constexpr std::uint32_t s_JsonChunk{ 0x4E4F534A };    // "JSON"
+        constexpr std::uint32_t s_BinaryChunk{ 0x004E4942 };  // "BIN\0"
+
+        // component types and primitive modes, named like in the specification
+        constexpr std::uint32_t s_Byte{ 5120 };
+        constexpr std::uint32_t s_UnsignedByte{ 5121 };
+        constexpr std::uint32_t s_Short{ 5122 };
+        constexpr std::uint32_t s_UnsignedShort{ 5123 };
+        constexpr std::uint32_t s_UnsignedInt{ 5125 };
+        constexpr std::uint32_t s_Float{ 5126 };
+
+        constexpr std::uint32_t s_Triangles{ 4 };
+        constexpr std::uint32_t s_TriangleStrip{ 5 };
+        constexpr std::uint32_t s_TriangleFan{ 6 };
+
+        // marks primitives that import as no triangles at all
+        constexpr std::uint32_t s_Dropped{ 0xFFFFFFFF };
+
+        // elements of one accessor, already bounds checked against its buffer
+        struct Accessor {
+            std::span<const std::byte> data{};
+            std::size_t     count{};
+            std::size_t     stride{};
+            std::size_t     components{};
+            std::uint32_t   componentType{};
+            bool            normalized{};
+
+            [[nodiscard]]
+            auto read(std::size_t element, std::size_t component) const -> float {
+                const std::byte* source{ data.data() + element * stride };
+
+                auto load{ [source, component]<typename T>(T) -> T {
+                    T value{};
+                    std::memcpy(&value, source + component * sizeof(T), sizeof(T));
+                    return value;
+                } };
+
+                // normalized integers map to [0, 1] or [-1, 1], see the accessor section of the specification
+                switch (componentType) {
+                    case s_Float: return load(float{});
+                    case s_UnsignedByte: return normalized ? load(std::uint8_t{}) / 255.0f : load(std::uint8_t{});
+                    case s_UnsignedShort: return normalized ? load(std::uint16_t{}) / 65535.0f : load(std::uint16_t{});
+                    case s_UnsignedInt: return static_cast<float>(load(std::uint32_t{}));
+                    case s_Byte: return normalized ? std::max(load(std::int8_t{}) / 127.0f, -1.0f) : load(std::int8_t{});
+                    case s_Short: return normalized ? std::max(load(std::int16_t{}) / 32767.0f, -1.0f) : load(std::int16_t{});
+                    default: return 0.0f;
+                }
+            }
+
+            [[nodiscard]]
+            auto readIndex(std::size_t element) const -> std::uint32_t {
+                const std::byte* source{ data.data() + element * stride };
+
+                switch (componentType) {
+                    case s_UnsignedByte: return static_cast<std::uint32_t>(source[0]);
+                    case s_UnsignedShort: {
+                        std::uint16_t value{};
+                        std::memcpy(&value, source, sizeof(value));
+                        return value;
+                    }
+                    default: {
+                        std::uint32_t value{};
+                        std::memcpy(&value, source, sizeof(value));
+                        return value;
+                    }
+                }
+            }
+        };
+
+        // parsed document and the memory its buffers live in
+        struct Document {
+            JsonValue                                   json{};
+            std::vector<MappedFile>                     files{};        // the model itself and external buffers
+            std::vector<std::vector<std::byte>>         decoded{};      // buffers given as data URIs
+            std::vector<std::span<const std::byte>>     buffers{};
+        };
+
+        // one primitive of one mesh, in the order they end up in the model
+        struct Primitive {
+            std::size_t mesh{};
+            std::size_t primitive{};
+        };
+
+        [[noreturn]]
+        auto fail(const std::filesystem::path& path, std::string_view reason) -> void {
+            throw std::runtime_error("Invalid glTF file " + path.string() + ": " + std::string{ reason });
+        }
+
+        auto readU32(std::span<const std::byte> data, std::size_t offset) -> std::uint32_t {
+            std::uint32_t value{};
+            std::memcpy(&value, data.data() + offset, sizeof(value));
+            return value;
+        }
+
+        auto getIndex(const JsonValue& value) -> std::size_t {
+            const double index{ value.asNumber(-1.0) };
+            return index < 0.0 ? std::string_view::npos : static_cast<std::size_t>(index);
+        }
+
+        auto decodeBase64(std::string_view text) -> std::vector<std::byte> {
+            auto value{ [](char c) -> int {
+                if (c >= 'A' && c <= 'Z') return c - 'A';
+                if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+                if (c >= '0' && c <= '9') return c - '0' + 52;
+                if (c == '+' || c == '-') return 62;
+                if (c == '/' || c == '_') return 63;
+                return -1;
+            } };
+
+            std::vector<std::byte> bytes{};
+            bytes.reserve(text.size() / 4 * 3);
+
+            std::uint32_t bits{};
+            int count{};
+            for (const char c : text) {
+                const int digit{ value(c) };
+                if (digit < 0)
+                    continue;   // padding and line breaks
+
+                bits = (bits << 6) | static_cast<std::uint32_t>(digit);
+                count += 6;
+
+                if (count >= 8) {
+                    count -= 8;
+                    bytes.push_back(static_cast<std::byte>((bits >> count) & 0xFF));
+                }
+            }
+
+            return bytes;
+        }
+
+        // URIs are percent encoded, file names with spaces come as %20
+        auto decodeUri(std::string_view uri) -> std::string {
+            std::string result{};
+            result.reserve(uri.size());
+
+            for (std::size_t i{}; i < uri.size(); i++) {
+                if (uri[i] == '%' && i + 2 < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[i + 1])) &&
+                    std::isxdigit(static_cast<unsigned char>(uri[i + 2]))) {
+                    result.push_back(static_cast<char>(std::stoi(std::string{ uri.substr(i + 1, 2) }, nullptr, 16)));
+                    i += 2;
+                }
+                else {
+                    result.push_back(uri[i]);
+                }
+            }
+
+            return result;
+        }
+
+        auto isDataUri(std::string_view uri) -> bool {
+            return uri.starts_with("data:");
+        }
+
+        // payload of a data URI, only base64 ones are allowed by the specification
+        auto decodeDataUri(std::string_view uri) -> std::vector<std::byte> {
+            const std::size_t comma{ uri.find(',') };
+            if (comma == std::string_view::npos || uri.substr(0, comma).find(";base64") == std::string_view::npos)
+                throw std::runtime_error("Unsupported data URI in glTF file");
+
+            return decodeBase64(uri.substr(comma + 1));
+        }
+
+        auto parseDocument(const std::filesystem::path& path) -> Document {
+            Document document{};
+            const auto& file{ document.files.emplace_back(path) };
+            const auto data{ file.getData() };
+
+            std::span<const std::byte> binary{};
+            std::string_view json{ reinterpret_cast<const char*>(data.data()), data.size() };
+
+            // binary files are a header and chunks, the first one being the JSON document and the second the buffer
+            if (data.size() >= 12 && readU32(data, 0) == GltfLoader::s_BinaryMagic) {
+                if (readU32(data, 4) != 2)
+                    fail(path, "only version 2 is supported");
+
+                const std::size_t length{ std::min<std::size_t>(readU32(data, 8), data.size()) };
+                std::size_t offset{ 12 };
+                bool hasJson{};
+
+                while (offset + 8 <= length) {
+                    const std::size_t chunkLength{ readU32(data, offset) };
+                    const std::uint32_t chunkType{ readU32(data, offset + 4) };
+                    offset += 8;
+
+                    if (chunkLength > length - offset)
+                        fail(path, "chunk out of bounds");
+
+                    if (chunkType == s_JsonChunk && !hasJson) {
+                        json = { reinterpret_cast<const char*>(data.data() + offset), chunkLength };
+                        hasJson = true;
+                    }
+                    else if (chunkType == s_BinaryChunk && binary.empty()) {
+                        binary = data.subspan(offset, chunkLength);
+                    }
+
+                    offset += chunkLength;
+                }
+
+                if (!hasJson)
+                    fail(path, "missing JSON chunk");
+            }
+
+            document.json = JsonValue::Parse(json);
+
+            const std::string_view version{ document.json["asset"]["version"].asString() };
+            if (!version.starts_with("2."))
+                fail(path, "only version 2 is supported");
+
+            const auto& buffers{ document.json["buffers"] };
+            for (std::size_t i{}; i < buffers.size(); i++) {
+                const std::string_view uri{ buffers[i]["uri"].asString() };
+                std::span<const std::byte> buffer{};
+
+                if (uri.empty())
+                    buffer = binary;
+                else if (isDataUri(uri))
+                    buffer = document.decoded.emplace_back(decodeDataUri(uri));
+                else
+                    buffer = document.files.emplace_back(path.parent_path() / decodeUri(uri)).getData();
+
+                const auto byteLength{ static_cast<std::size_t>(buffers[i]["byteLength"].asNumber()) };
+                if (byteLength > buffer.size())
+                    fail(path, "buffer " + std::to_string(i) + " is shorter than its byteLength");
+
+                document.buffers.push_back(buffer.first(byteLength));
+            }
+
+            return document;
+        }
+
+        auto getAccessor(const Document& document, const std::filesystem::path& path, std::size_t index) -> Accessor {
+            const auto& json{ document.json["accessors"][index] };
+            if (!json.isObject())
+                fail(path, "missing accessor " + std::to_string(index));
+
+            static constexpr std::array<std::pair<std::string_view, std::size_t>, 4> types{ {
+                { "SCALAR", 1 }, { "VEC2", 2 }, { "VEC3", 3 }, { "VEC4", 4 }
+            } };
+
+            Accessor accessor{};
+            accessor.count = static_cast<std::size_t>(json["count"].asNumber());
+            accessor.componentType = static_cast<std::uint32_t>(json["componentType"].asNumber());
+            accessor.normalized = json["normalized"].asBool();
+
+            const auto type{ std::find_if(types.begin(), types.end(), [&json](const auto& entry) -> bool { return entry.first == json["type"].asString(); }) };
+            if (type == types.end())
+                fail(path, "unsupported type of accessor " + std::to_string(index));
+
+            accessor.components = type->second;
+
+            std::size_t componentSize{};
+            switch (accessor.componentType) {
+                case s_Byte: case s_UnsignedByte: componentSize = 1; break;
+                case s_Short: case s_UnsignedShort: componentSize = 2; break;
+                case s_UnsignedInt: case s_Float: componentSize = 4; break;
+                default: fail(path, "unsupported component type of accessor " + std::to_string(index));
+            }
+
+            if (!json["sparse"].isNull())
+                KATE_LOGGER_WARN("Sparse accessor {} of {} is read without its sparse values", index, path.string());
+
+            // accessors without a buffer view are all zeros
+            const auto& view{ document.json["bufferViews"][getIndex(json["bufferView"])] };
+            if (!view.isObject()) {
+                static const std::array<std::byte, 16> zeros{};
+                accessor.data = zeros;
+                accessor.stride = 0;
+                return accessor;
+            }
+
+            const std::size_t buffer{ getIndex(view["buffer"]) };
+            if (buffer >= document.buffers.size())
+                fail(path, "buffer view of accessor " + std::to_string(index) + " references a missing buffer");
+
+            const std::size_t elementSize{ componentSize * accessor.components };
+            const auto viewOffset{ static_cast<std::size_t>(view["byteOffset"].asNumber()) };
+            const auto viewLength{ static_cast<std::size_t>(view["byteLength"].asNumber()) };
+            const auto offset{ static_cast<std::size_t>(json["byteOffset"].asNumber()) };
+
+            accessor.stride = static_cast<std::size_t>(view["byteStride"].asNumber(static_cast<double>(elementSize)));
+
+            const std::size_t bytes{ accessor.count == 0 ? 0 : accessor.stride * (accessor.count - 1) + elementSize };
+            if (viewOffset > document.buffers[buffer].size() || viewLength > document.buffers[buffer].size() - viewOffset ||
+                offset > viewLength || bytes > viewLength - offset || accessor.stride < elementSize)
+                fail(path, "accessor " + std::to_string(index) + " is out of the bounds of its buffer");
+
+            accessor.data = document.buffers[buffer].subspan(viewOffset + offset, bytes);
+            return accessor;
+        }
+
+        auto loadImage(const Document& document, const std::filesystem::path& path, std::size_t index) -> TextureRef {
+            const auto& image{ document.json["images"][index] };
+            const std::string_view uri{ image["uri"].asString() };
+
+            if (!uri.empty() && !isDataUri(uri))
+                return TextureRef{ path.parent_path() / decodeUri(uri) };
+
+            // embedded images are named after the model so the texture cache tells them apart
+            std::filesystem::path name{ path };
+            name += "#image" + std::to_string(index);
+
+            if (!uri.empty())
+                return TextureRef{ name, {}, std::make_shared<const std::vector<std::byte>>(decodeDataUri(uri)) };
+
+            const auto& view{ document.json["bufferViews"][getIndex(image["bufferView"])] };
+            const std::size_t buffer{ getIndex(view["buffer"]) };
+            const auto offset{ static_cast<std::size_t>(view["byteOffset"].asNumber()) };
+            const auto length{ static_cast<std::size_t>(view["byteLength"].asNumber()) };
+
+            if (buffer >= document.buffers.size() || offset > document.buffers[buffer].size() || length > document.buffers[buffer].size() - offset)
+                fail(path, "image " + std::to_string(index) + " is out of the bounds of its buffer");
+
+            const auto bytes{ document.buffers[buffer].subspan(offset, length) };
+            return TextureRef{ name, {}, std::make_shared<const std::vector<std::byte>>(bytes.begin(), bytes.end()) };
+        }
+
+        // texture references of every material, in the order kT::Model::processMesh() gives them
+        auto loadMaterials(const Document& document, const std::filesystem::path& path) -> std::vector<std::vector<TextureRef>> {
+            const auto& materials{ document.json["materials"] };
+            const auto& textures{ document.json["textures"] };
+
+            // images used by several materials are decoded and stored once
+            std::vector<std::optional<TextureRef>> images(document.json["images"].size());
+
+            auto add{ [&](std::vector<TextureRef>& refs, const JsonValue& info, Texture::TextureType type) -> void {
+                const std::size_t image{ getIndex(textures[getIndex(info["index"])]["source"]) };
+                if (image >= images.size())
+                    return;
+
+                if (!images[image])
+                    images[image] = loadImage(document, path, image);
+
+                refs.push_back(*images[image]);
+                refs.back().type = type;
+            } };
+
+            std::vector<std::vector<TextureRef>> result(materials.size());
+            for (std::size_t i{}; i < materials.size(); i++) {
+                const auto& material{ materials[i] };
+                const auto& specularGlossiness{ material["extensions"]["KHR_materials_pbrSpecularGlossiness"] };
+
+                if (!material["pbrMetallicRoughness"]["baseColorTexture"].isNull())
+                    add(result[i], material["pbrMetallicRoughness"]["baseColorTexture"], Texture::TextureType::DIFFUSE);
+                else if (!specularGlossiness["diffuseTexture"].isNull())
+                    add(result[i], specularGlossiness["diffuseTexture"], Texture::TextureType::DIFFUSE);
+
+                if (!specularGlossiness["specularGlossinessTexture"].isNull())
+                    add(result[i], specularGlossiness["specularGlossinessTexture"], Texture::TextureType::SPECULAR);
+
+                if (!material["normalTexture"].isNull())
+                    add(result[i], material["normalTexture"], Texture::TextureType::NORMAL);
+            }
+
+            return result;
+        }
+
+        auto triangulate(std::uint32_t mode, std::vector<std::uint32_t>& indices) -> bool {
+            if (mode == s_Triangles)
+                return true;
+
+            if (mode != s_TriangleStrip && mode != s_TriangleFan)
+                return false;
+
+            std::vector<std::uint32_t> triangles{};
+            triangles.reserve(indices.size() < 3 ? 0 : (indices.size() - 2) * 3);
+
+            for (std::size_t i{ 2 }; i < indices.size(); i++) {
+                if (mode == s_TriangleFan)
+                    triangles.insert(triangles.end(), { indices[0], indices[i - 1], indices[i] });
+                else if (i % 2 == 0)
+                    triangles.insert(triangles.end(), { indices[i - 2], indices[i - 1], indices[i] });
+                else    // every other strip triangle is flipped to keep the winding
+                    triangles.insert(triangles.end(), { indices[i - 1], indices[i - 2], indices[i] });
+            }
+
+            indices = std::move(triangles);
+            return true;
+        }
+
+        auto loadPrimitive(const Document& document, const std::filesystem::path& path, const JsonValue& primitive,
+                           const std::vector<std::vector<TextureRef>>& materials) -> MeshData {
+            constexpr std::size_t floatsPerVertex{ 8 };
+
+            MeshData mesh{};
+            const auto& attributes{ primitive["attributes"] };
+
+            const Accessor positions{ getAccessor(document, path, getIndex(attributes["POSITION"])) };
+            if (positions.components != 3)
+                fail(path, "positions must be three component vectors");
+
+            const std::size_t vertexCount{ positions.count };
+            mesh.vertices.resize(vertexCount * floatsPerVertex);
+
+            auto fill{ [&mesh, vertexCount](const Accessor& accessor, std::size_t first, std::size_t components) -> void {
+                const std::size_t count{ std::min(accessor.count, vertexCount) };
+                for (std::size_t vertex{}; vertex < count; vertex++) {
+                    float* data{ mesh.vertices.data() + vertex * floatsPerVertex + first };
+                    for (std::size_t component{}; component < components; component++)
+                        data[component] = accessor.read(vertex, component);
+                }
+            } };
+
+            fill(positions, 0, 3);
+
+            const bool hasNormals{ !attributes["NORMAL"].isNull() };
+            if (hasNormals)
+                fill(getAccessor(document, path, getIndex(attributes["NORMAL"])), 3, 3);
+
+            // glTF puts the texture origin at the top left, which is what kT::Model gets from assimp after aiProcess_FlipUVs
+            if (!attributes["TEXCOORD_0"].isNull())
+                fill(getAccessor(document, path, getIndex(attributes["TEXCOORD_0"])), 6, 2);
+
+            if (!primitive["indices"].isNull()) {
+                const Accessor indices{ getAccessor(document, path, getIndex(primitive["indices"])) };
+                if (indices.components != 1 || indices.componentType == s_Float || indices.componentType == s_Byte || indices.componentType == s_Short)
+                    fail(path, "indices must be unsigned integer scalars");
+
+                mesh.indices.resize(indices.count);
+                for (std::size_t i{}; i < indices.count; i++)
+                    mesh.indices[i] = indices.readIndex(i);
+            }
+            else {
+                mesh.indices.resize(vertexCount);
+                for (std::size_t i{}; i < vertexCount; i++)
+                    mesh.indices[i] = static_cast<std::uint32_t>(i);
+            }
+
+            if (std::any_of(mesh.indices.begin(), mesh.indices.end(), [vertexCount](std::uint32_t index) -> bool { return index >= vertexCount; }))
+                fail(path, "primitive references missing vertices");
+
+            // points and lines are not drawn
+            if (!triangulate(static_cast<std::uint32_t>(primitive["mode"].asNumber(s_Triangles)), mesh.indices)) {
+                mesh.indices.clear();
+                return mesh;
+            }
+
+            mesh.indices.resize(mesh.indices.size() / 3 * 3);
+
+            if (!hasNormals)
+                NormalGenerator::GenerateSmooth(mesh);
+
+            const std::size_t material{ getIndex(primitive["material"]) };
+            if (material < materials.size())
+                mesh.textures = materials[material];
+
+            return mesh;
+        }
+
+        // node to parent transform, either a column major matrix or translation * rotation * scale
+        auto getLocalTransform(const JsonValue& node) -> glm::mat4 {
+            glm::mat4 result{ 1.0f };
+
+            if (const auto& matrix{ node["matrix"] }; matrix.size() == 16) {
+                for (int column{}; column < 4; column++) {
+                    for (int row{}; row < 4; row++)
+                        result[column][row] = static_cast<float>(matrix[static_cast<std::size_t>(column * 4 + row)].asNumber());
+                }
+
+                return result;
+            }
+
+            const auto& translation{ node["translation"] };
+            const auto& rotation{ node["rotation"] };
+            const auto& scale{ node["scale"] };
+
+            // rotation is a unit quaternion stored as x, y, z, w
+            const auto x{ static_cast<float>(rotation[0].asNumber(0.0)) };
+            const auto y{ static_cast<float>(rotation[1].asNumber(0.0)) };
+            const auto z{ static_cast<float>(rotation[2].asNumber(0.0)) };
+            const auto w{ static_cast<float>(rotation[3].asNumber(1.0)) };
+
+            result[0] = glm::vec4(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + w * z), 2.0f * (x * z - w * y), 0.0f);
+            result[1] = glm::vec4(2.0f * (x * y - w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + w * x), 0.0f);
+            result[2] = glm::vec4(2.0f * (x * z + w * y), 2.0f * (y * z - w * x), 1.0f - 2.0f * (x * x + y * y), 0.0f);
+
+            for (std::size_t column{}; column < 3; column++)
+                result[static_cast<int>(column)] *= static_cast<float>(scale[column].asNumber(1.0));
+
+            result[3] = glm::vec4(static_cast<float>(translation[0].asNumber(0.0)), static_cast<float>(translation[1].asNumber(0.0)),
+                                  static_cast<float>(translation[2].asNumber(0.0)), 1.0f);
+            return result;
+        }
+
+        // instances hold the index of the glTF mesh, not of an imported one
+        auto collectNode(const JsonValue& nodes, std::size_t index, std::size_t depth, std::uint32_t parent, SceneGraph& scene,
+                         std::vector<MeshInstance>& instances) -> void {
+            const auto& node{ nodes[index] };
+            if (!node.isObject() || depth > nodes.size())
+                return;
+
+            const std::uint32_t sceneNode{ scene.addNode(parent, getLocalTransform(node), node["name"].asString()) };
+
+            if (const std::size_t mesh{ getIndex(node["mesh"]) }; mesh != std::string_view::npos)
+                instances.push_back(MeshInstance{ static_cast<std::uint32_t>(mesh), sceneNode });
+
+            const auto& children{ node["children"] };
+            for (std::size_t i{}; i < children.size(); i++)
+                collectNode(nodes, getIndex(children[i]), depth + 1, sceneNode, scene, instances);
+        }
+    }
+
+    auto GltfLoader::Load(const std::filesystem::path& path, SceneGraph& scene, std::vector<MeshInstance>& instances) -> std::vector<MeshData> {
+        const Document document{ parseDocument(path) };
+        const auto& json{ document.json };
+
+        // every node referencing a mesh, a mesh used by several nodes is still imported once
+        std::vector<MeshInstance> nodes{};
+        const auto& scenes{ json["scenes"] };
+
+        if (scenes.size() == 0) {
+            const std::uint32_t root{ scene.addNode(SceneGraph::s_NoParent, glm::mat4(1.0f), path.filename().string()) };
+            for (std::size_t i{}; i < json["meshes"].size(); i++)
+                nodes.push_back(MeshInstance{ static_cast<std::uint32_t>(i), root });
+        }
+        else {
+            const std::size_t sceneIndex{ json["scene"].isNull() ? 0 : getIndex(json["scene"]) };
+            const auto& roots{ scenes[sceneIndex]["nodes"] };
+            for (std::size_t i{}; i < roots.size(); i++)
+                collectNode(json["nodes"], getIndex(roots[i]), 0, SceneGraph::s_NoParent, scene, nodes);
+        }
+
+        // primitives of every mesh, meshes in the order the nodes first reference them
+        std::vector<Primitive> primitives{};
+        std::unordered_map<std::size_t, std::pair<std::size_t, std::size_t>> meshPrimitives{};
+        for (const auto& node : nodes) {
+            const std::size_t count{ json["meshes"][node.mesh]["primitives"].size() };
+            if (!meshPrimitives.try_emplace(node.mesh, primitives.size(), count).second)
+                continue;
+
+            for (std::size_t i{}; i < count; i++)
+                primitives.push_back({ node.mesh, i });
+        }
+
+        const auto materials{ loadMaterials(document, path) };
+
+        std::vector<MeshData> meshes(primitives.size());
+        ThreadPool::Get().parallelFor(primitives.size(), [&](std::size_t i) -> void {
+            meshes[i] = loadPrimitive(document, path, json["meshes"][primitives[i].mesh]["primitives"][primitives[i].primitive], materials);
+        });
+
+        // points and lines leave empty meshes behind, the others are renumbered
+        std::vector<std::uint32_t> remap(meshes.size());
+        std::size_t kept{};
+        for (std::size_t i{}; i < meshes.size(); i++) {
+            if (meshes[i].indices.empty()) {
+                remap[i] = s_Dropped;
+                continue;
+            }
+
+            remap[i] = static_cast<std::uint32_t>(kept);
+            if (kept != i)
+                meshes[kept] = std::move(meshes[i]);
+            ++kept;
+        }
+        meshes.resize(kept);
+
+        // one instance per node and primitive, grouped by mesh so the renderer can batch them
+        for (const auto& node : nodes) {
+            const auto [first, count]{ meshPrimitives[node.mesh] };
+            for (std::size_t i{ first }; i < first + count; i++) {
+                if (remap[i] != s_Dropped)
+                    instances.push_back(MeshInstance{ remap[i], node.node });
+            }
+        }
+
+        std::stable_sort(instances.begin(), instances.end(), [](const MeshInstance& a, const MeshInstance& b) -> bool { return a.mesh < b.mesh; });
+
+        KATE_LOGGER_DEBUG("Parsed {}: {} buffers, {} nodes, {} meshes, {} instances", path.string(), document.buffers.size(), scene.getSize(),
+                          meshes.size(), instances.size());
+        return meshes;
+    }
+
+    auto GltfLoader::GetDependencies(const std::filesystem::path& path) -> std::vector<std::filesystem::path> {
+        const Document document{ parseDocument(path) };
+
+        std::vector<std::filesystem::path> files{};
+        const auto& buffers{ document.json["buffers"] };
+        for (std::size_t i{}; i < buffers.size(); i++) {
+            const std::string_view uri{ buffers[i]["uri"].asString() };
+            if (!uri.empty() && !isDataUri(uri))
+                files.push_back(path.parent_path() / decodeUri(uri));
+        }
+
+        return files;
+    }
+
+    auto GltfLoader::IsSupported(const std::filesystem::path& path) -> bool {
+        std::string extension{ path.extension().string() };
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) -> char { return static_cast<char>(std::tolower(c)); });
+        return extension == ".gltf" || extension == ".glb";
+    }
+}
@@ -0,0 +1,280 @@
+// C++ Standard Library
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+
+// Project Libraries
+#include "Core/Json.hh"
+
+namespace kT {
+    namespace {
+        const JsonValue s_Null{};
+        const JsonValue::Object s_NoMembers{};
+
+        // nesting deeper than this is not a real asset, stop before the stack runs out
+        constexpr std::size_t s_MaxDepth{ 256 };
+    }
+
+    class JsonParser {
+    public:
+        explicit JsonParser(std::string_view text) : m_Text{ text } {}
+
+        auto parseDocument() -> JsonValue {
+            JsonValue value{ parseValue(0) };
+            skipSpace();
+
+            if (m_Position != m_Text.size())
+                fail("unexpected trailing characters");
+
+            return value;
+        }
+
+    private:
+        [[noreturn]]
+        auto fail(std::string_view reason) const -> void {
+            throw std::runtime_error("Invalid JSON at offset " + std::to_string(m_Position) + ": " + std::string{ reason });
+        }
+
+        auto skipSpace() -> void {
+            while (m_Position < m_Text.size() && (m_Text[m_Position] == ' ' || m_Text[m_Position] == '\t' ||
+                                                  m_Text[m_Position] == '\n' || m_Text[m_Position] == '\r'))
+                ++m_Position;
+        }
+
+        auto peek() -> char {
+            skipSpace();
+            if (m_Position == m_Text.size())
+                fail("unexpected end of document");
+
+            return m_Text[m_Position];
+        }
+
+        auto expect(char c) -> void {
+            if (peek() != c)
+                fail(std::string{ "expected '" } + c + "'");
+
+            ++m_Position;
+        }
+
+        auto consume(std::string_view word) -> bool {
+            if (m_Text.substr(m_Position, word.size()) != word)
+                return false;
+
+            m_Position += word.size();
+            return true;
+        }
+
+        auto parseValue(std::size_t depth) -> JsonValue {
+            if (depth > s_MaxDepth)
+                fail("document nested too deeply");
+
+            JsonValue value{};
+
+            switch (peek()) {
+                case '{': value.m_Value = parseObject(depth); break;
+                case '[': value.m_Value = parseArray(depth); break;
+                case '"': value.m_Value = parseString(); break;
+                case 't':
+                    if (!consume("true"))
+                        fail("invalid literal");
+                    value.m_Value = true;
+                    break;
+                case 'f':
+                    if (!consume("false"))
+                        fail("invalid literal");
+                    value.m_Value = false;
+                    break;
+                case 'n':
+                    if (!consume("null"))
+                        fail("invalid literal");
+                    break;
+                default: value.m_Value = parseNumber(); break;
+            }
+
+            return value;
+        }
+
+        auto parseObject(std::size_t depth) -> JsonValue::Object {
+            JsonValue::Object object{};
+            expect('{');
+
+            if (peek() == '}') {
+                ++m_Position;
+                return object;
+            }
+
+            while (true) {
+                if (peek() != '"')
+                    fail("expected member name");
+
+                std::string key{ parseString() };
+                expect(':');
+                object.emplace_back(std::move(key), parseValue(depth + 1));
+
+                if (peek() == '}') {
+                    ++m_Position;
+                    return object;
+                }
+
+                expect(',');
+            }
+        }
+
+        auto parseArray(std::size_t depth) -> JsonValue::Array {
+            JsonValue::Array array{};
+            expect('[');
+
+            if (peek() == ']') {
+                ++m_Position;
+                return array;
+            }
+
+            while (true) {
+                array.push_back(parseValue(depth + 1));
+
+                if (peek() == ']') {
+                    ++m_Position;
+                    return array;
+                }
+
+                expect(',');
+            }
+        }
+
+        auto parseHex() -> std::uint32_t {
+            std::uint32_t code{};
+            const auto [end, error] { std::from_chars(m_Text.data() + m_Position, m_Text.data() + std::min(m_Position + 4, m_Text.size()), code, 16) };
+            if (error != std::errc{} || end != m_Text.data() + m_Position + 4)
+                fail("invalid unicode escape");
+
+            m_Position += 4;
+            return code;
+        }
+
+        static auto appendUtf8(std::string& out, std::uint32_t code) -> void {
+            if (code < 0x80) {
+                out.push_back(static_cast<char>(code));
+            }
+            else if (code < 0x800) {
+                out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            else if (code < 0x10000) {
+                out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            else {
+                out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+        }
+
+        auto parseString() -> std::string {
+            expect('"');
+            std::string result{};
+
+            while (true) {
+                if (m_Position == m_Text.size())
+                    fail("unterminated string");
+
+                const char c{ m_Text[m_Position++] };
+                if (c == '"')
+                    return result;
+
+                if (c != '\\') {
+                    result.push_back(c);
+                    continue;
+                }
+
+                if (m_Position == m_Text.size())
+                    fail("unterminated string");
+
+                switch (m_Text[m_Position++]) {
+                    case '"': result.push_back('"'); break;
+                    case '\\': result.push_back('\\'); break;
+                    case '/': result.push_back('/'); break;
+                    case 'b': result.push_back('\b'); break;
+                    case 'f': result.push_back('\f'); break;
+                    case 'n': result.push_back('\n'); break;
+                    case 'r': result.push_back('\r'); break;
+                    case 't': result.push_back('\t'); break;
+                    case 'u': {
+                        std::uint32_t code{ parseHex() };
+
+                        // characters outside the basic plane come as a surrogate pair
+                        if (code >= 0xD800 && code < 0xDC00 && consume("\\u")) {
+                            const std::uint32_t low{ parseHex() };
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        }
+
+                        appendUtf8(result, code);
+                        break;
+                    }
+                    default: fail("invalid escape sequence");
+                }
+            }
+        }
+
+        auto parseNumber() -> double {
+            double number{};
+            const auto [end, error] { std::from_chars(m_Text.data() + m_Position, m_Text.data() + m_Text.size(), number) };
+            if (error != std::errc{})
+                fail("invalid value");
+
+            m_Position = static_cast<std::size_t>(end - m_Text.data());
+            return number;
+        }
+
+        std::string_view    m_Text{};
+        std::size_t         m_Position{};
+    };
+
+    auto JsonValue::Parse(std::string_view text) -> JsonValue {
+        return JsonParser{ text }.parseDocument();
+    }
+
+    auto JsonValue::operator[](std::string_view key) const -> const JsonValue& {
+        for (const auto& [name, value] : getMembers()) {
+            if (name == key)
+                return value;
+        }
+
+        return s_Null;
+    }
+
+    auto JsonValue::operator[](std::size_t index) const -> const JsonValue& {
+        const auto* array{ std::get_if<Array>(&m_Value) };
+        return array != nullptr && index < array->size() ? (*array)[index] : s_Null;
+    }
+
+    auto JsonValue::size() const -> std::size_t {
+        if (const auto* array{ std::get_if<Array>(&m_Value) })
+            return array->size();
+
+        return getMembers().size();
+    }
+
+    auto JsonValue::asBool(bool fallback) const -> bool {
+        const auto* value{ std::get_if<bool>(&m_Value) };
+        return value != nullptr ? *value : fallback;
+    }
+
+    auto JsonValue::asNumber(double fallback) const -> double {
+        const auto* value{ std::get_if<double>(&m_Value) };
+        return value != nullptr ? *value : fallback;
+    }
+
+    auto JsonValue::asString(std::string_view fallback) const -> std::string_view {
+        const auto* value{ std::get_if<std::string>(&m_Value) };
+        return value != nullptr ? std::string_view{ *value } : fallback;
+    }
+
+    auto JsonValue::getMembers() const -> const Object& {
+        const auto* object{ std::get_if<Object>(&m_Value) };
+        return object != nullptr ? *object : s_NoMembers;
+    }
+}
@@ -0,0 +1,140 @@
+// C++ Standard Library
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+// Platform Libraries
+#if defined(_WIN64) || defined(WIN32)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Project Libraries
+#include "Core/MappedFile.hh"
+
+namespace kT {
+#if defined(_WIN64) || defined(WIN32)
+    MappedFile::MappedFile(const std::filesystem::path& path) {
+        m_File = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_File == INVALID_HANDLE_VALUE) {
+            m_File = nullptr;
+            throw std::runtime_error("Could not open file " + path.string());
+        }
+
+        LARGE_INTEGER size{};
+        GetFileSizeEx(m_File, &size);
+        m_Size = static_cast<std::size_t>(size.QuadPart);
+
+        // empty files can not be mapped, they are represented as an empty view
+        if (m_Size == 0)
+            return;
+
+        m_Mapping = CreateFileMappingW(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        m_Data = m_Mapping != nullptr ? MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+        if (m_Data == nullptr) {
+            release();
+            throw std::runtime_error("Could not map file " + path.string());
+        }
+    }
+
+    auto MappedFile::release() -> void {
+        if (m_Data != nullptr)
+            UnmapViewOfFile(m_Data);
+        if (m_Mapping != nullptr)
+            CloseHandle(m_Mapping);
+        if (m_File != nullptr)
+            CloseHandle(m_File);
+
+        m_Data = nullptr;
+        m_Mapping = nullptr;
+        m_File = nullptr;
+        m_Size = 0;
+    }
+#else
+    MappedFile::MappedFile(const std::filesystem::path& path) {
+        int file{ open(path.c_str(), O_RDONLY) };
+        if (file < 0)
+            throw std::runtime_error("Could not open file " + path.string());
+
+        struct stat info{};
+        if (fstat(file, &info) != 0) {
+            close(file);
+            throw std::runtime_error("Could not query file " + path.string());
+        }
+
+        m_Size = static_cast<std::size_t>(info.st_size);
+
+        // empty files can not be mapped, they are represented as an empty view
+        if (m_Size != 0) {
+            void* data{ mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0) };
+
+            if (data == MAP_FAILED) {
+                close(file);
+                m_Size = 0;
+                throw std::runtime_error("Could not map file " + path.string());
+            }
+
+            // the whole file is read front to back by the loaders
+            madvise(data, m_Size, MADV_SEQUENTIAL);
+            m_Data = data;
+        }
+
+        // the mapping keeps its own reference to the file
+        close(file);
+    }
+
+    auto MappedFile::release() -> void {
+        if (m_Data != nullptr)
+            munmap(const_cast<void*>(m_Data), m_Size);
+
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+#endif
+
+    auto MappedFile::evict(std::span<const std::byte> bytes) const -> void {
+        if (bytes.empty())
+            return;
+
+#if defined(_WIN64) || defined(WIN32)
+        // unlocking pages that are not locked removes them from the working set
+        VirtualUnlock(const_cast<std::byte*>(bytes.data()), bytes.size());
+#else
+        // only whole pages inside the range are dropped, the ones shared with neighbouring data stay
+        const auto pageSize{ static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE)) };
+        const auto first{ (reinterpret_cast<std::uintptr_t>(bytes.data()) + pageSize - 1) / pageSize * pageSize };
+        const auto last{ (reinterpret_cast<std::uintptr_t>(bytes.data()) + bytes.size()) / pageSize * pageSize };
+
+        if (first < last)
+            madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+#endif
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+        if (this != &other) {
+            release();
+
+            std::swap(m_Data, other.m_Data);
+            std::swap(m_Size, other.m_Size);
+#if defined(_WIN64) || defined(WIN32)
+            std::swap(m_File, other.m_File);
+            std::swap(m_Mapping, other.m_Mapping);
+#endif
+        }
+
+        return *this;
+    }
+
+    MappedFile::~MappedFile() {
+        release();
+    }
+}
@@ -1,22 +1,87 @@
 // C++ Standard Library
+#include <array>
+#include <cmath>
+#include <cstring>
 #include <string>
 #include <string_view>
 
 // Project Libraries
 #include "OpenGL/Mesh.hh"
+#include "OpenGL/VertexQuantizer.hh"
 #include <OpenGL/VertexBuffer.hh>
 
 namespace kT {
-    Mesh::Mesh(const std::vector<float> &vertices, const std::vector<std::uint32_t> &indices, std::vector<Texture> &&textures)
-        :   m_VertexBuffer{ vertices, s_Layout }, m_ElementBuffer{ indices }, m_Textures{ std::move(textures) } {}
+    namespace {
+        // model space position and texture coordinates of a vertex in either kT::VertexFormat
+        auto readVertex(const VertexView& vertices, std::uint32_t index) -> std::pair<glm::vec3, glm::vec2> {
+            if (vertices.format == VertexFormat::COMPACT) {
+                std::array<std::uint16_t, 8> stored{};
+                std::memcpy(stored.data(), vertices.data.data() + index * sizeof(stored), sizeof(stored));
+
+                const glm::vec3 position(stored[0], stored[1], stored[2]);
+                return { vertices.transform.offset + position / 65535.0f * vertices.transform.scale,
+                         { VertexQuantizer::HalfToFloat(stored[6]), VertexQuantizer::HalfToFloat(stored[7]) } };
+            }
+
+            std::array<float, 8> stored{};
+            std::memcpy(stored.data(), vertices.data.data() + index * sizeof(stored), sizeof(stored));
+            return { { stored[0], stored[1], stored[2] }, { stored[6], stored[7] } };
+        }
+
+        // square root of the texture area over the surface area, so it scales like a length
+        auto computeTexelDensity(const VertexView& vertices, std::span<const std::uint32_t> indices) -> float {
+            double surface{};
+            double texture{};
+
+            for (std::size_t i{}; i + 2 < indices.size(); i += 3) {
+                const auto [a, uvA]{ readVertex(vertices, indices[i]) };
+                const auto [b, uvB]{ readVertex(vertices, indices[i + 1]) };
+                const auto [c, uvC]{ readVertex(vertices, indices[i + 2]) };
+
+                const glm::vec2 uvAB{ uvB - uvA };
+                const glm::vec2 uvAC{ uvC - uvA };
+                surface += glm::length(glm::cross(b - a, c - a));
+                texture += std::abs(uvAB.x * uvAC.y - uvAB.y * uvAC.x);
+            }
+
+            return surface > 0.0 ? static_cast<float>(std::sqrt(texture / surface)) : 0.0f;
+        }
+    }
+
+    Mesh::Mesh(const GeometryArena::Range& geometry, const VertexView& vertices, std::span<const std::uint32_t> indices,
+               std::span<const LodLevel> lods, const BoundingSphere& bounds, std::span<const Meshlet> meshlets,
+               std::vector<std::shared_ptr<Texture>> &&textures)
+        :   m_Textures{ std::move(textures) }, m_Geometry{ geometry }, m_VertexFormat{ vertices.format }, m_PositionTransform{ vertices.transform },
+            m_IndexCount{ indices.size() }, m_Lods{ lods.begin(), lods.end() }, m_Bounds{ bounds },
+            m_Meshlets{ meshlets.begin(), meshlets.end() }, m_IndexType{ GeometryArena::GetIndexType(geometry.vertexCount) },
+            m_HasTangents{ !vertices.tangents.empty() }
+    {
+        if (m_Lods.empty())
+            m_Lods.push_back({ 0, static_cast<std::uint32_t>(indices.size()), 0.0f });
+
+        m_TexelDensity = computeTexelDensity(vertices, indices.subspan(m_Lods.front().firstIndex, m_Lods.front().indexCount));
+
+        GeometryArena::Upload(m_Geometry, vertices.data, vertices.tangents, indices, m_IndexType);
+    }
 
     Mesh::Mesh(Mesh&& other) noexcept
-        :   m_VertexBuffer{ std::move(other.m_VertexBuffer) }, m_ElementBuffer{ std::move(other.m_ElementBuffer) }, m_Textures{ std::move(other.m_Textures) } {}
+        :   m_Textures{ std::move(other.m_Textures) }, m_Geometry{ std::exchange(other.m_Geometry, {}) }, m_VertexFormat{ other.m_VertexFormat },
+            m_PositionTransform{ other.m_PositionTransform }, m_IndexCount{ std::exchange(other.m_IndexCount, 0) },
+            m_Lods{ std::move(other.m_Lods) }, m_Bounds{ other.m_Bounds }, m_TexelDensity{ other.m_TexelDensity }, m_Meshlets{ std::move(other.m_Meshlets) },
+            m_IndexType{ other.m_IndexType }, m_HasTangents{ other.m_HasTangents } {}
 
     auto Mesh::operator=(Mesh&& other) noexcept -> Mesh& {
-        m_VertexBuffer = std::move(other.m_VertexBuffer);
-        m_ElementBuffer = std::move(other.m_ElementBuffer);
         m_Textures = std::move(other.m_Textures);
+        m_Geometry = std::exchange(other.m_Geometry, {});
+        m_VertexFormat = other.m_VertexFormat;
+        m_PositionTransform = other.m_PositionTransform;
+        m_IndexCount = std::exchange(other.m_IndexCount, 0);
+        m_Lods = std::move(other.m_Lods);
+        m_Bounds = other.m_Bounds;
+        m_TexelDensity = other.m_TexelDensity;
+        m_Meshlets = std::move(other.m_Meshlets);
+        m_IndexType = other.m_IndexType;
+        m_HasTangents = other.m_HasTangents;
 
         return *this;
     }
@@ -0,0 +1,376 @@
+// C++ Standard Library
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+
+// Third-Party Libraries
+#include <glm/glm.hpp>
+
+// Project Libraries
+#include "OpenGL/Mesh.hh"
+#include "OpenGL/MeshOptimizer.hh"
+
+namespace kT {
+    namespace {
+        // Scoring parameters from Forsyth's article, tuned for a 32 entry LRU cache
+        constexpr std::size_t s_ScoringCacheSize{ 32 };
+        constexpr float s_CacheDecayPower{ 1.5f };
+        constexpr float s_LastTriangleScore{ 0.75f };
+        constexpr float s_ValenceBoostScale{ 2.0f };
+        constexpr float s_ValenceBoostPower{ 0.5f };
+
+        auto vertexScore(std::int32_t cachePosition, std::uint32_t liveTriangles) -> float {
+            // nothing left to draw with this vertex
+            if (liveTriangles == 0)
+                return -1.0f;
+
+            float score{};
+            if (cachePosition >= 0) {
+                // the vertices of the last triangle score the same no matter their order
+                if (cachePosition < 3)
+                    score = s_LastTriangleScore;
+                else
+                    score = std::pow(1.0f - static_cast<float>(cachePosition - 3) / static_cast<float>(s_ScoringCacheSize - 3), s_CacheDecayPower);
+            }
+
+            // boost vertices with few triangles left so they do not linger until the end
+            return score + s_ValenceBoostScale * std::pow(static_cast<float>(liveTriangles), -s_ValenceBoostPower);
+        }
+
+        /**
+         * FIFO post transform cache, as implemented by most GPUs
+         * */
+        class FifoCache {
+        public:
+            FifoCache(std::size_t vertexCount, std::uint32_t size)
+                :   m_Timestamps(vertexCount, 0), m_Size{ size }, m_Time{ size + 1 } {}
+
+            /**
+             * Returns true if the vertex missed the cache, which puts it in
+             * */
+            auto access(std::uint32_t vertex) -> bool {
+                if (m_Time - m_Timestamps[vertex] > m_Size) {
+                    m_Timestamps[vertex] = m_Time++;
+                    return true;
+                }
+
+                return false;
+            }
+
+            auto flush() -> void { m_Time += m_Size + 1; }
+
+        private:
+            std::vector<std::uint32_t>  m_Timestamps{};
+            std::uint32_t               m_Size{};
+            std::uint32_t               m_Time{};
+        };
+
+        auto accessTriangle(FifoCache& cache, std::span<const std::uint32_t> indices, std::size_t triangle) -> std::uint32_t {
+            return static_cast<std::uint32_t>(cache.access(indices[triangle * 3 + 0])) +
+                   static_cast<std::uint32_t>(cache.access(indices[triangle * 3 + 1])) +
+                   static_cast<std::uint32_t>(cache.access(indices[triangle * 3 + 2]));
+        }
+    }
+
+    auto MeshOptimizer::Optimize(MeshData& mesh) -> Report {
+        const std::size_t floatsPerVertex{ Mesh::GetLayout().getStride() / sizeof(float) };
+        const std::size_t vertexCount{ mesh.vertices.size() / floatsPerVertex };
+
+        Report report{};
+        report.before = report.after = AnalyzeVertexCache(mesh.indices, vertexCount);
+
+        const bool valid{ mesh.vertices.size() % floatsPerVertex == 0 && mesh.indices.size() % 3 == 0 &&
+                          std::all_of(mesh.indices.begin(), mesh.indices.end(), [vertexCount](std::uint32_t index) -> bool { return index < vertexCount; }) };
+
+        if (!valid || mesh.indices.empty())
+            return report;
+
+        mesh.indices = OptimizeVertexCache(mesh.indices, vertexCount);
+        mesh.indices = OptimizeOverdraw(mesh.indices, mesh.vertices, floatsPerVertex);
+        OptimizeVertexFetch(mesh, floatsPerVertex);
+
+        report.after = AnalyzeVertexCache(mesh.indices, mesh.vertices.size() / floatsPerVertex);
+        report.optimized = true;
+
+        return report;
+    }
+
+    auto MeshOptimizer::AnalyzeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount, std::uint32_t cacheSize) -> CacheStats {
+        const std::size_t triangleCount{ indices.size() / 3 };
+        if (triangleCount == 0 || std::any_of(indices.begin(), indices.end(), [vertexCount](std::uint32_t index) -> bool { return index >= vertexCount; }))
+            return {};
+
+        FifoCache cache{ vertexCount, cacheSize };
+        std::vector<bool> referenced(vertexCount, false);
+        std::size_t misses{};
+        std::size_t uniqueVertices{};
+
+        for (const auto index : indices) {
+            misses += static_cast<std::size_t>(cache.access(index));
+
+            if (!referenced[index]) {
+                referenced[index] = true;
+                ++uniqueVertices;
+            }
+        }
+
+        return { static_cast<float>(misses) / static_cast<float>(triangleCount),
+                 static_cast<float>(misses) / static_cast<float>(uniqueVertices) };
+    }
+
+    auto MeshOptimizer::OptimizeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount) -> std::vector<std::uint32_t> {
+        const std::size_t triangleCount{ indices.size() / 3 };
+
+        std::vector<std::uint32_t> result{};
+        result.reserve(indices.size());
+
+        // triangles using every vertex, stored contiguously per vertex. The
+        // first liveTriangles[v] entries of a vertex are the ones not emitted yet
+        std::vector<std::uint32_t> offsets(vertexCount + 1, 0);
+        for (const auto index : indices)
+            ++offsets[index + 1];
+
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        std::vector<std::uint32_t> adjacency(indices.size());
+        std::vector<std::uint32_t> liveTriangles(vertexCount, 0);
+
+        for (std::size_t triangle{}; triangle < triangleCount; triangle++) {
+            for (std::size_t corner{}; corner < 3; corner++) {
+                const auto vertex{ indices[triangle * 3 + corner] };
+                adjacency[offsets[vertex] + liveTriangles[vertex]++] = static_cast<std::uint32_t>(triangle);
+            }
+        }
+
+        std::vector<std::int32_t> cachePositions(vertexCount, -1);
+        std::vector<float> vertexScores(vertexCount);
+        for (std::size_t vertex{}; vertex < vertexCount; vertex++)
+            vertexScores[vertex] = vertexScore(-1, liveTriangles[vertex]);
+
+        auto triangleScore{ [&](std::size_t triangle) -> float {
+            return vertexScores[indices[triangle * 3 + 0]] + vertexScores[indices[triangle * 3 + 1]] + vertexScores[indices[triangle * 3 + 2]];
+        } };
+
+        std::vector<float> triangleScores(triangleCount);
+        for (std::size_t triangle{}; triangle < triangleCount; triangle++)
+            triangleScores[triangle] = triangleScore(triangle);
+
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<std::uint32_t> cache{};
+        std::vector<std::uint32_t> nextCache{};
+        cache.reserve(s_ScoringCacheSize + 3);
+        nextCache.reserve(s_ScoringCacheSize + 3);
+
+        std::optional<std::size_t> best{};
+        std::size_t cursor{};
+
+        for (std::size_t count{}; count < triangleCount; count++) {
+            // the cache gave nothing, continue with the next triangle in input order
+            if (!best) {
+                while (emitted[cursor])
+                    ++cursor;
+
+                best = cursor;
+            }
+
+            const std::size_t triangle{ *best };
+            emitted[triangle] = true;
+            nextCache.clear();
+
+            for (std::size_t corner{}; corner < 3; corner++) {
+                const auto vertex{ indices[triangle * 3 + corner] };
+                result.push_back(vertex);
+
+                if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end())
+                    nextCache.push_back(vertex);
+
+                const auto begin{ adjacency.begin() + offsets[vertex] };
+                const auto end{ begin + liveTriangles[vertex] };
+                std::iter_swap(std::find(begin, end, static_cast<std::uint32_t>(triangle)), end - 1);
+                --liveTriangles[vertex];
+            }
+
+            // the emitted triangle moves to the front of the LRU cache
+            const std::size_t emittedVertices{ nextCache.size() };
+            for (const auto vertex : cache) {
+                if (std::find(nextCache.begin(), nextCache.begin() + static_cast<std::ptrdiff_t>(emittedVertices), vertex) ==
+                    nextCache.begin() + static_cast<std::ptrdiff_t>(emittedVertices))
+                    nextCache.push_back(vertex);
+            }
+
+            for (std::size_t i{}; i < nextCache.size(); i++) {
+                const auto vertex{ nextCache[i] };
+                cachePositions[vertex] = i < s_ScoringCacheSize ? static_cast<std::int32_t>(i) : -1;
+                vertexScores[vertex] = vertexScore(cachePositions[vertex], liveTriangles[vertex]);
+            }
+
+            // rescore the triangles touching the cache, the best one among them goes next
+            best.reset();
+            float bestScore{ std::numeric_limits<float>::lowest() };
+
+            for (std::size_t i{}; i < nextCache.size(); i++) {
+                const auto vertex{ nextCache[i] };
+
+                for (std::uint32_t t{}; t < liveTriangles[vertex]; t++) {
+                    const auto candidate{ adjacency[offsets[vertex] + t] };
+                    triangleScores[candidate] = triangleScore(candidate);
+
+                    if (i < s_ScoringCacheSize && triangleScores[candidate] > bestScore) {
+                        bestScore = triangleScores[candidate];
+                        best = candidate;
+                    }
+                }
+            }
+
+            if (nextCache.size() > s_ScoringCacheSize)
+                nextCache.resize(s_ScoringCacheSize);
+
+            std::swap(cache, nextCache);
+        }
+
+        return result;
+    }
+
+    auto MeshOptimizer::OptimizeOverdraw(std::span<const std::uint32_t> indices, std::span<const float> vertices,
+                                         std::size_t floatsPerVertex, float threshold) -> std::vector<std::uint32_t> {
+        const std::size_t triangleCount{ indices.size() / 3 };
+        const std::size_t vertexCount{ vertices.size() / floatsPerVertex };
+
+        if (triangleCount == 0)
+            return { indices.begin(), indices.end() };
+
+        // Hard boundaries: triangles missing the cache on all of their vertices
+        // start a new strip, reordering at those points costs no cache efficiency
+        std::vector<std::size_t> hardBoundaries{ 0 };
+        {
+            FifoCache cache{ vertexCount, s_CacheSize };
+            accessTriangle(cache, indices, 0);
+
+            for (std::size_t triangle{ 1 }; triangle < triangleCount; triangle++) {
+                if (accessTriangle(cache, indices, triangle) == 3)
+                    hardBoundaries.push_back(triangle);
+            }
+        }
+
+        hardBoundaries.push_back(triangleCount);
+
+        // Soft boundaries: split every hard cluster further wherever the part read so
+        // far is about as cache efficient as the whole cluster, restarting the cache there
+        std::vector<std::size_t> clusters{};
+        {
+            FifoCache cache{ vertexCount, s_CacheSize };
+
+            for (std::size_t i{}; i + 1 < hardBoundaries.size(); i++) {
+                const std::size_t start{ hardBoundaries[i] };
+                const std::size_t end{ hardBoundaries[i + 1] };
+
+                cache.flush();
+                std::size_t clusterMisses{};
+                for (std::size_t triangle{ start }; triangle < end; triangle++)
+                    clusterMisses += accessTriangle(cache, indices, triangle);
+
+                const float clusterAcmr{ static_cast<float>(clusterMisses) / static_cast<float>(end - start) };
+
+                cache.flush();
+                clusters.push_back(start);
+
+                std::size_t misses{};
+                std::size_t triangles{};
+
+                for (std::size_t triangle{ start }; triangle < end; triangle++) {
+                    misses += accessTriangle(cache, indices, triangle);
+                    ++triangles;
+
+                    if (triangle + 1 < end && static_cast<float>(misses) / static_cast<float>(triangles) <= threshold * clusterAcmr) {
+                        clusters.push_back(triangle + 1);
+                        cache.flush();
+                        misses = 0;
+                        triangles = 0;
+                    }
+                }
+            }
+        }
+
+        clusters.push_back(triangleCount);
+
+        auto position{ [&](std::uint32_t vertex) -> glm::vec3 {
+            const float* data{ vertices.data() + vertex * floatsPerVertex };
+            return glm::vec3(data[0], data[1], data[2]);
+        } };
+
+        // area weighted centroid and normal of every cluster
+        const std::size_t clusterCount{ clusters.size() - 1 };
+        std::vector<glm::vec3> centroids(clusterCount, glm::vec3(0.0f));
+        std::vector<glm::vec3> normals(clusterCount, glm::vec3(0.0f));
+        std::vector<float> areas(clusterCount, 0.0f);
+
+        glm::vec3 meshCentroid{ 0.0f };
+        float meshArea{};
+
+        for (std::size_t cluster{}; cluster < clusterCount; cluster++) {
+            for (std::size_t triangle{ clusters[cluster] }; triangle < clusters[cluster + 1]; triangle++) {
+                const glm::vec3 a{ position(indices[triangle * 3 + 0]) };
+                const glm::vec3 b{ position(indices[triangle * 3 + 1]) };
+                const glm::vec3 c{ position(indices[triangle * 3 + 2]) };
+
+                const glm::vec3 normal{ glm::cross(b - a, c - a) };
+                const float area{ glm::length(normal) };
+
+                centroids[cluster] = centroids[cluster] + (a + b + c) * (area / 3.0f);
+                normals[cluster] = normals[cluster] + normal;
+                areas[cluster] += area;
+            }
+
+            meshCentroid = meshCentroid + centroids[cluster];
+            meshArea += areas[cluster];
+        }
+
+        if (meshArea > 0.0f)
+            meshCentroid = meshCentroid / meshArea;
+
+        // clusters facing away from the center of the mesh are likely in front of the others
+        std::vector<float> sortKeys(clusterCount, 0.0f);
+        for (std::size_t cluster{}; cluster < clusterCount; cluster++) {
+            const float length{ glm::length(normals[cluster]) };
+            if (areas[cluster] > 0.0f && length > 0.0f)
+                sortKeys[cluster] = glm::dot(centroids[cluster] / areas[cluster] - meshCentroid, normals[cluster] / length);
+        }
+
+        std::vector<std::size_t> order(clusterCount);
+        std::iota(order.begin(), order.end(), std::size_t{});
+        std::stable_sort(order.begin(), order.end(), [&sortKeys](std::size_t lhs, std::size_t rhs) -> bool { return sortKeys[lhs] > sortKeys[rhs]; });
+
+        std::vector<std::uint32_t> result{};
+        result.reserve(indices.size());
+
+        for (const auto cluster : order)
+            result.insert(result.end(), indices.begin() + static_cast<std::ptrdiff_t>(clusters[cluster] * 3),
+                          indices.begin() + static_cast<std::ptrdiff_t>(clusters[cluster + 1] * 3));
+
+        return result;
+    }
+
+    auto MeshOptimizer::OptimizeVertexFetch(MeshData& mesh, std::size_t floatsPerVertex) -> void {
+        static constexpr std::uint32_t unused{ std::numeric_limits<std::uint32_t>::max() };
+
+        std::vector<std::uint32_t> remap(mesh.vertices.size() / floatsPerVertex, unused);
+        std::vector<float> vertices{};
+        vertices.reserve(mesh.vertices.size());
+
+        std::uint32_t next{};
+        for (auto& index : mesh.indices) {
+            if (remap[index] == unused) {
+                remap[index] = next++;
+
+                const auto first{ mesh.vertices.begin() + static_cast<std::ptrdiff_t>(index * floatsPerVertex) };
+                vertices.insert(vertices.end(), first, first + static_cast<std::ptrdiff_t>(floatsPerVertex));
+            }
+
+            index = remap[index];
+        }
+
+        mesh.vertices = std::move(vertices);
+    }
+}
@@ -0,0 +1,342 @@
+// C++ Standard Library
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <tuple>
+
+// Project Libraries
+#include "OpenGL/Mesh.hh"
+#include "OpenGL/MeshOptimizer.hh"
+#include "OpenGL/MeshSimplifier.hh"
+
+namespace kT {
+    namespace {
+        /**
+         * Sum of squared distances to a set of planes, weighted by the area of the triangles they come from
+         * */
+        struct Quadric {
+            double a00{}, a11{}, a22{};
+            double a01{}, a02{}, a12{};
+            double b0{}, b1{}, b2{};
+            double c{};
+            double weight{};
+
+            static auto FromPlane(const glm::vec3& normal, float distance, double area) -> Quadric {
+                const double x{ normal.x };
+                const double y{ normal.y };
+                const double z{ normal.z };
+                const double d{ distance };
+
+                return { x * x * area, y * y * area, z * z * area,
+                         x * y * area, x * z * area, y * z * area,
+                         x * d * area, y * d * area, z * d * area,
+                         d * d * area, area };
+            }
+
+            auto add(const Quadric& other) -> void {
+                a00 += other.a00; a11 += other.a11; a22 += other.a22;
+                a01 += other.a01; a02 += other.a02; a12 += other.a12;
+                b0 += other.b0; b1 += other.b1; b2 += other.b2;
+                c += other.c;
+                weight += other.weight;
+            }
+
+            /**
+             * Returns the mean squared distance from the point to the planes
+             * */
+            [[nodiscard]]
+            auto evaluate(const glm::vec3& point) const -> double {
+                const double x{ point.x };
+                const double y{ point.y };
+                const double z{ point.z };
+
+                const double error{ a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                                    2.0 * (b0 * x + b1 * y + b2 * z) + c };
+
+                return weight > 0.0 ? std::max(error, 0.0) / weight : 0.0;
+            }
+        };
+
+        struct Collapse {
+            std::uint32_t   from{};
+            std::uint32_t   to{};
+            double          cost{};
+        };
+    }
+
+    auto MeshSimplifier::Simplify(std::span<const std::uint32_t> indices, std::span<const float> vertices, std::size_t floatsPerVertex,
+                                  std::size_t targetIndexCount, float maxError) -> Result {
+        const std::size_t vertexCount{ vertices.size() / floatsPerVertex };
+
+        Result result{ { indices.begin(), indices.end() }, 0.0f };
+        if (indices.size() <= targetIndexCount || indices.size() % 3 != 0 ||
+            std::any_of(indices.begin(), indices.end(), [vertexCount](std::uint32_t index) -> bool { return index >= vertexCount; }))
+            return result;
+
+        auto position{ [&](std::uint32_t vertex) -> glm::vec3 {
+            const float* data{ vertices.data() + vertex * floatsPerVertex };
+            return glm::vec3(data[0], data[1], data[2]);
+        } };
+
+        auto key{ [&](std::uint32_t vertex) -> std::tuple<float, float, float> {
+            const float* data{ vertices.data() + vertex * floatsPerVertex };
+            return { data[0], data[1], data[2] };
+        } };
+
+        // Vertices sharing a position are welded, the first one of each group standing for the
+        // rest. Groups of more than one vertex lie on an attribute seam and are locked in place
+        std::vector<std::uint32_t> welded(vertexCount);
+        std::vector<bool> locked(vertexCount, false);
+        {
+            std::vector<std::uint32_t> order(vertexCount);
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(), [&key](std::uint32_t lhs, std::uint32_t rhs) -> bool { return key(lhs) < key(rhs); });
+
+            for (std::size_t first{}; first < vertexCount;) {
+                std::size_t last{ first };
+                while (last < vertexCount && key(order[last]) == key(order[first])) {
+                    welded[order[last]] = order[first];
+                    ++last;
+                }
+
+                if (last - first > 1) {
+                    for (std::size_t i{ first }; i < last; i++)
+                        locked[order[i]] = true;
+                }
+
+                first = last;
+            }
+        }
+
+        // Edges used by a single triangle are on an open border, more than two make it non manifold
+        {
+            std::vector<std::uint64_t> edges{};
+            edges.reserve(indices.size());
+
+            for (std::size_t i{}; i < indices.size(); i += 3) {
+                for (std::size_t corner{}; corner < 3; corner++) {
+                    const std::uint64_t a{ welded[indices[i + corner]] };
+                    const std::uint64_t b{ welded[indices[i + (corner + 1) % 3]] };
+                    edges.push_back(std::min(a, b) << 32 | std::max(a, b));
+                }
+            }
+
+            std::sort(edges.begin(), edges.end());
+
+            for (std::size_t first{}; first < edges.size();) {
+                std::size_t last{ first };
+                while (last < edges.size() && edges[last] == edges[first])
+                    ++last;
+
+                if (last - first != 2) {
+                    locked[static_cast<std::uint32_t>(edges[first] >> 32)] = true;
+                    locked[static_cast<std::uint32_t>(edges[first] & 0xffffffffu)] = true;
+                }
+
+                first = last;
+            }
+        }
+
+        // Every welded vertex starts with the planes of the triangles around it
+        std::vector<Quadric> quadrics(vertexCount);
+        for (std::size_t i{}; i < indices.size(); i += 3) {
+            const glm::vec3 p0{ position(indices[i + 0]) };
+            const glm::vec3 normal{ glm::cross(position(indices[i + 1]) - p0, position(indices[i + 2]) - p0) };
+            const float length{ glm::length(normal) };
+
+            if (length == 0.0f)
+                continue;
+
+            const glm::vec3 unit{ normal / length };
+            const Quadric quadric{ Quadric::FromPlane(unit, -glm::dot(unit, p0), 0.5 * length) };
+
+            for (std::size_t corner{}; corner < 3; corner++)
+                quadrics[welded[indices[i + corner]]].add(quadric);
+        }
+
+        std::vector<std::uint32_t>& current{ result.indices };
+        std::vector<std::uint32_t> remap(vertexCount);
+        std::iota(remap.begin(), remap.end(), 0u);
+
+        std::vector<std::uint32_t> offsets(vertexCount + 1);
+        std::vector<std::uint32_t> adjacency{};
+        std::vector<Collapse> candidates{};
+        std::vector<bool> touched(vertexCount);
+
+        const double maxErrorSquared{ static_cast<double>(maxError) * static_cast<double>(maxError) };
+        const std::size_t targetTriangles{ targetIndexCount / 3 };
+        double worst{};
+
+        // Every pass collapses a set of edges far enough from each other that the
+        // checks of one are not invalidated by the others, cheapest ones first
+        while (current.size() > targetIndexCount) {
+            const std::size_t triangleCount{ current.size() / 3 };
+
+            std::fill(offsets.begin(), offsets.end(), 0);
+            for (const auto index : current)
+                ++offsets[index + 1];
+
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            adjacency.resize(current.size());
+
+            {
+                std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+                for (std::size_t i{}; i < current.size(); i++)
+                    adjacency[fill[current[i]]++] = static_cast<std::uint32_t>(i / 3);
+            }
+
+            candidates.clear();
+            for (std::size_t i{}; i < current.size(); i += 3) {
+                for (std::size_t corner{}; corner < 3; corner++) {
+                    const std::uint32_t a{ current[i + corner] };
+                    const std::uint32_t b{ current[i + (corner + 1) % 3] };
+
+                    for (const auto [from, to] : { std::pair{ a, b }, std::pair{ b, a } }) {
+                        if (locked[welded[from]] || welded[from] == welded[to])
+                            continue;
+
+                        Quadric quadric{ quadrics[from] };
+                        quadric.add(quadrics[welded[to]]);
+                        candidates.push_back({ from, to, quadric.evaluate(position(to)) });
+                    }
+                }
+            }
+
+            std::sort(candidates.begin(), candidates.end(), [](const Collapse& lhs, const Collapse& rhs) -> bool {
+                return std::tie(lhs.cost, lhs.from, lhs.to) < std::tie(rhs.cost, rhs.from, rhs.to);
+            });
+
+            std::fill(touched.begin(), touched.end(), false);
+            std::size_t remaining{ triangleCount };
+            bool collapsed{ false };
+
+            for (const auto& candidate : candidates) {
+                if (remaining <= targetTriangles || candidate.cost > maxErrorSquared)
+                    break;
+
+                if (touched[candidate.from] || touched[candidate.to])
+                    continue;
+
+                // triangles around the edge vanish, the rest must keep facing the same side
+                const glm::vec3 target{ position(candidate.to) };
+                std::size_t removed{};
+                bool flips{ false };
+
+                for (std::uint32_t i{ offsets[candidate.from] }; i < offsets[candidate.from + 1] && !flips; i++) {
+                    const std::size_t triangle{ adjacency[i] * std::size_t{ 3 } };
+                    const std::uint32_t corners[3]{ current[triangle], current[triangle + 1], current[triangle + 2] };
+
+                    if (welded[corners[0]] == welded[candidate.to] || welded[corners[1]] == welded[candidate.to] || welded[corners[2]] == welded[candidate.to]) {
+                        ++removed;
+                        continue;
+                    }
+
+                    glm::vec3 before[3]{ position(corners[0]), position(corners[1]), position(corners[2]) };
+                    glm::vec3 after[3]{ before[0], before[1], before[2] };
+
+                    for (std::size_t corner{}; corner < 3; corner++) {
+                        if (corners[corner] == candidate.from)
+                            after[corner] = target;
+                    }
+
+                    const glm::vec3 normalBefore{ glm::cross(before[1] - before[0], before[2] - before[0]) };
+                    const glm::vec3 normalAfter{ glm::cross(after[1] - after[0], after[2] - after[0]) };
+                    flips = glm::dot(normalBefore, normalAfter) <= 0.0f;
+                }
+
+                if (flips)
+                    continue;
+
+                remap[candidate.from] = candidate.to;
+                quadrics[welded[candidate.to]].add(quadrics[candidate.from]);
+                worst = std::max(worst, candidate.cost);
+
+                touched[candidate.to] = true;
+                for (std::uint32_t i{ offsets[candidate.from] }; i < offsets[candidate.from + 1]; i++) {
+                    const std::size_t triangle{ adjacency[i] * std::size_t{ 3 } };
+                    touched[current[triangle]] = touched[current[triangle + 1]] = touched[current[triangle + 2]] = true;
+                }
+
+                remaining -= removed;
+                collapsed = true;
+            }
+
+            if (!collapsed)
+                break;
+
+            // drop the triangles that collapsed, also the ones left flat across a seam
+            std::size_t written{};
+            for (std::size_t i{}; i < current.size(); i += 3) {
+                const std::uint32_t a{ remap[current[i + 0]] };
+                const std::uint32_t b{ remap[current[i + 1]] };
+                const std::uint32_t c{ remap[current[i + 2]] };
+
+                if (welded[a] == welded[b] || welded[b] == welded[c] || welded[a] == welded[c])
+                    continue;
+
+                current[written++] = a;
+                current[written++] = b;
+                current[written++] = c;
+            }
+
+            current.resize(written);
+        }
+
+        result.error = static_cast<float>(std::sqrt(worst));
+        return result;
+    }
+
+    auto MeshSimplifier::GenerateLods(MeshData& mesh, bool generate) -> void {
+        const std::size_t floatsPerVertex{ Mesh::GetLayout().getStride() / sizeof(float) };
+        const std::size_t indexCount{ mesh.indices.size() };
+
+        mesh.bounds = ComputeBounds(mesh.vertices, floatsPerVertex);
+        mesh.lods = { LodLevel{ 0, static_cast<std::uint32_t>(indexCount), 0.0f } };
+
+        if (!generate || indexCount == 0 || indexCount % 3 != 0)
+            return;
+
+        // every level is simplified from the full resolution mesh so its error is measured against it
+        const std::vector<std::uint32_t> full{ mesh.indices };
+        std::size_t previous{ indexCount };
+
+        for (std::size_t level{ 1 }; level < s_MaxLevels; level++) {
+            const auto target{ static_cast<std::size_t>(static_cast<float>(previous / 3) * s_LevelRatio) * 3 };
+            auto simplified{ Simplify(full, mesh.vertices, floatsPerVertex, target) };
+
+            if (simplified.indices.empty() || static_cast<float>(simplified.indices.size()) > static_cast<float>(previous) * s_MinReduction)
+                break;
+
+            simplified.indices = MeshOptimizer::OptimizeVertexCache(simplified.indices, mesh.vertices.size() / floatsPerVertex);
+
+            mesh.lods.push_back({ static_cast<std::uint32_t>(mesh.indices.size()), static_cast<std::uint32_t>(simplified.indices.size()),
+                                  std::max(simplified.error, mesh.lods.back().error) });
+            mesh.indices.insert(mesh.indices.end(), simplified.indices.begin(), simplified.indices.end());
+
+            previous = simplified.indices.size();
+        }
+    }
+
+    auto MeshSimplifier::ComputeBounds(std::span<const float> vertices, std::size_t floatsPerVertex) -> BoundingSphere {
+        const std::size_t vertexCount{ vertices.size() / floatsPerVertex };
+        if (vertexCount == 0)
+            return {};
+
+        glm::vec3 minimum{ vertices[0], vertices[1], vertices[2] };
+        glm::vec3 maximum{ minimum };
+
+        for (std::size_t i{}; i < vertexCount; i++) {
+            const glm::vec3 point{ vertices[i * floatsPerVertex], vertices[i * floatsPerVertex + 1], vertices[i * floatsPerVertex + 2] };
+            minimum = glm::min(minimum, point);
+            maximum = glm::max(maximum, point);
+        }
+
+        BoundingSphere sphere{ (minimum + maximum) * 0.5f, 0.0f };
+        for (std::size_t i{}; i < vertexCount; i++) {
+            const glm::vec3 point{ vertices[i * floatsPerVertex], vertices[i * floatsPerVertex + 1], vertices[i * floatsPerVertex + 2] };
+            sphere.radius = std::max(sphere.radius, glm::length(point - sphere.center));
+        }
+
+        return sphere;
+    }
+}
@@ -0,0 +1,194 @@
+// C++ Standard Library
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+// Project Libraries
+#include "OpenGL/Mesh.hh"
+#include "OpenGL/MeshletBuilder.hh"
+
+namespace kT {
+    namespace {
+        // cones wider than this face every direction somewhere, testing them is pointless
+        constexpr float s_MinConeDot{ 0.1f };
+    }
+
+    auto MeshletBuilder::Build(MeshData& mesh) -> void {
+        const std::size_t floatsPerVertex{ Mesh::GetLayout().getStride() / sizeof(float) };
+        const std::size_t vertexCount{ mesh.vertices.size() / floatsPerVertex };
+        const std::size_t indexCount{ mesh.lods.empty() ? mesh.indices.size() : mesh.lods.front().indexCount };
+        const std::size_t triangleCount{ indexCount / 3 };
+
+        mesh.meshlets.clear();
+
+        const std::span<std::uint32_t> indices{ mesh.indices.data(), indexCount };
+        if (indexCount % 3 != 0 || triangleCount < s_MinTriangles ||
+            std::any_of(indices.begin(), indices.end(), [vertexCount](std::uint32_t index) -> bool { return index >= vertexCount; }))
+            return;
+
+        // triangles around every vertex
+        std::vector<std::uint32_t> offsets(vertexCount + 1);
+        std::vector<std::uint32_t> adjacency(indexCount);
+
+        for (const auto index : indices)
+            ++offsets[index + 1];
+
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        {
+            std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (std::size_t i{}; i < indexCount; i++)
+                adjacency[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<std::uint32_t> owner(vertexCount, std::numeric_limits<std::uint32_t>::max());    // last meshlet using each vertex
+        std::vector<std::uint32_t> reordered{};
+        std::vector<std::uint32_t> candidates{};
+        reordered.reserve(indexCount);
+
+        std::size_t seed{};
+
+        while (reordered.size() < indexCount) {
+            const auto id{ static_cast<std::uint32_t>(mesh.meshlets.size()) };
+            const std::size_t firstIndex{ reordered.size() };
+            std::size_t vertices{};
+            std::size_t triangles{};
+
+            candidates.clear();
+
+            auto newVertices{ [&](std::size_t triangle) -> std::size_t {
+                return (owner[indices[triangle * 3]] != id) + (owner[indices[triangle * 3 + 1]] != id) + (owner[indices[triangle * 3 + 2]] != id);
+            } };
+
+            auto emit{ [&](std::size_t triangle) -> void {
+                emitted[triangle] = true;
+                ++triangles;
+
+                for (std::size_t corner{}; corner < 3; corner++) {
+                    const std::uint32_t vertex{ indices[triangle * 3 + corner] };
+                    reordered.push_back(vertex);
+
+                    if (owner[vertex] == id)
+                        continue;
+
+                    owner[vertex] = id;
+                    ++vertices;
+
+                    for (std::uint32_t i{ offsets[vertex] }; i < offsets[vertex + 1]; i++) {
+                        if (!emitted[adjacency[i]])
+                            candidates.push_back(adjacency[i]);
+                    }
+                }
+            } };
+
+            while (emitted[seed])
+                ++seed;
+
+            emit(seed);
+
+            while (triangles < s_MaxTriangles) {
+                // grow towards the neighbour adding the fewest vertices, which keeps the cluster compact
+                std::size_t best{ triangleCount };
+                std::size_t bestNew{ 4 };
+                std::size_t kept{};
+
+                for (const auto triangle : candidates) {
+                    if (emitted[triangle])
+                        continue;
+
+                    candidates[kept++] = triangle;
+
+                    const std::size_t added{ newVertices(triangle) };
+                    if (added < bestNew || (added == bestNew && triangle < best)) {
+                        best = triangle;
+                        bestNew = added;
+                    }
+                }
+
+                candidates.resize(kept);
+
+                // no neighbours left, the next triangle in cache order is still close by
+                if (best == triangleCount) {
+                    while (seed < triangleCount && emitted[seed])
+                        ++seed;
+
+                    if (seed == triangleCount)
+                        break;
+
+                    best = seed;
+                    bestNew = newVertices(seed);
+                }
+
+                if (vertices + bestNew > s_MaxVertices)
+                    break;
+
+                emit(best);
+            }
+
+            Meshlet meshlet{ ComputeBounds(std::span{ reordered }.subspan(firstIndex), mesh.vertices, floatsPerVertex) };
+            meshlet.firstIndex = static_cast<std::uint32_t>(firstIndex);
+            mesh.meshlets.push_back(meshlet);
+        }
+
+        std::copy(reordered.begin(), reordered.end(), indices.begin());
+    }
+
+    auto MeshletBuilder::ComputeBounds(std::span<const std::uint32_t> indices, std::span<const float> vertices, std::size_t floatsPerVertex) -> Meshlet {
+        Meshlet meshlet{};
+        meshlet.indexCount = static_cast<std::uint32_t>(indices.size());
+
+        if (indices.empty())
+            return meshlet;
+
+        auto position{ [&](std::uint32_t vertex) -> glm::vec3 {
+            const float* data{ vertices.data() + vertex * floatsPerVertex };
+            return glm::vec3(data[0], data[1], data[2]);
+        } };
+
+        glm::vec3 minimum{ position(indices[0]) };
+        glm::vec3 maximum{ minimum };
+
+        for (const auto index : indices) {
+            minimum = glm::min(minimum, position(index));
+            maximum = glm::max(maximum, position(index));
+        }
+
+        meshlet.bounds.center = (minimum + maximum) * 0.5f;
+        for (const auto index : indices)
+            meshlet.bounds.radius = std::max(meshlet.bounds.radius, glm::length(position(index) - meshlet.bounds.center));
+
+        // the cone follows the winding, which is what back face culling looks at, not the vertex normals
+        std::vector<glm::vec3> normals{};
+        normals.reserve(indices.size() / 3);
+
+        glm::vec3 axis{ 0.0f };
+        for (std::size_t i{}; i + 2 < indices.size(); i += 3) {
+            const glm::vec3 p0{ position(indices[i]) };
+            const glm::vec3 normal{ glm::cross(position(indices[i + 1]) - p0, position(indices[i + 2]) - p0) };
+            const float length{ glm::length(normal) };
+
+            if (length == 0.0f)
+                continue;
+
+            normals.push_back(normal / length);
+            axis += normals.back();
+        }
+
+        const float axisLength{ glm::length(axis) };
+        if (normals.empty() || axisLength == 0.0f)
+            return meshlet;
+
+        axis = axis / axisLength;
+
+        float minimumDot{ 1.0f };
+        for (const auto& normal : normals)
+            minimumDot = std::min(minimumDot, glm::dot(axis, normal));
+
+        meshlet.coneAxis = axis;
+        meshlet.coneCutoff = minimumDot < s_MinConeDot ? 1.0f : std::sqrt(1.0f - minimumDot * minimumDot);
+
+        return meshlet;
+    }
+}
@@ -0,0 +1,257 @@
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define KATE_MIP_GENERATOR_SSE2
+    #include <emmintrin.h>
+#endif
+
+// Project Libraries
+#include "Core/ThreadPool.hh"
+#include "OpenGL/MipGenerator.hh"
+
+namespace kT {
+    namespace {
+        // one texel as floats in [0, 1], channels past the image ones are unused
+        using Texel = std::array<float, 4>;
+
+        // entries of the linear to sRGB table, enough for every 8-bit sRGB value to have its own
+        constexpr std::size_t s_EncodeTableSize{ 4096 };
+
+        // taps of the Kaiser filter on each axis and the shape of its window
+        constexpr std::size_t s_KaiserTaps{ 6 };
+        constexpr float s_KaiserAlpha{ 4.0f };
+
+        // levels with fewer texels are filtered on the calling thread
+        constexpr std::size_t s_ParallelTexels{ 64 * 64 };
+
+        auto getLinearTable() -> const std::array<float, 256>& {
+            static const auto table{ []() -> std::array<float, 256> {
+                std::array<float, 256> result{};
+                for (std::size_t i{}; i < result.size(); i++) {
+                    const float value{ static_cast<float>(i) / 255.0f };
+                    result[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+                }
+
+                return result;
+            }() };
+
+            return table;
+        }
+
+        auto getEncodeTable() -> const std::array<std::uint8_t, s_EncodeTableSize>& {
+            static const auto table{ []() -> std::array<std::uint8_t, s_EncodeTableSize> {
+                std::array<std::uint8_t, s_EncodeTableSize> result{};
+                for (std::size_t i{}; i < result.size(); i++) {
+                    const float value{ static_cast<float>(i) / static_cast<float>(s_EncodeTableSize - 1) };
+                    const float encoded{ value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f };
+                    result[i] = static_cast<std::uint8_t>(std::lround(encoded * 255.0f));
+                }
+
+                return result;
+            }() };
+
+            return table;
+        }
+
+        // zeroth order modified Bessel function of the first kind, its series converges quickly for the window
+        auto besselI0(float x) -> float {
+            float sum{ 1.0f };
+            float term{ 1.0f };
+            for (int k{ 1 }; k < 16; k++) {
+                const float factor{ x / (2.0f * static_cast<float>(k)) };
+                term *= factor * factor;
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        // source texels 2x - 2 to 2x + 3 make output texel x, halving the size puts its center between 2x and 2x + 1
+        auto getKaiserWeights() -> const std::array<float, s_KaiserTaps>& {
+            static const auto weights{ []() -> std::array<float, s_KaiserTaps> {
+                std::array<float, s_KaiserTaps> result{};
+                constexpr float radius{ static_cast<float>(s_KaiserTaps) / 4.0f };
+                float total{};
+
+                for (std::size_t tap{}; tap < s_KaiserTaps; tap++) {
+                    // distance to the center in output texels
+                    const float distance{ (static_cast<float>(tap) - 2.5f) / 2.0f };
+                    const float x{ std::numbers::pi_v<float> * distance };
+                    const float ratio{ distance / radius };
+                    const float window{ besselI0(s_KaiserAlpha * std::sqrt(1.0f - ratio * ratio)) / besselI0(s_KaiserAlpha) };
+
+                    result[tap] = std::sin(x) / x * window;
+                    total += result[tap];
+                }
+
+                for (auto& weight : result)
+                    weight /= total;
+
+                return result;
+            }() };
+
+            return weights;
+        }
+
+        // adds value * weight to sum, every channel at once
+        auto accumulate(Texel& sum, const Texel& value, float weight) -> void {
+#ifdef KATE_MIP_GENERATOR_SSE2
+            _mm_storeu_ps(sum.data(), _mm_add_ps(_mm_loadu_ps(sum.data()), _mm_mul_ps(_mm_loadu_ps(value.data()), _mm_set1_ps(weight))));
+#else
+            for (std::size_t c{}; c < sum.size(); c++)
+                sum[c] += value[c] * weight;
+#endif
+        }
+
+        /**
+         * Reads and writes the texels of one level, converting the color channels
+         * of sRGB images to and from linear space
+         * */
+        struct LevelCodec {
+            std::size_t channels{};
+            std::size_t colorChannels{};    // every channel but alpha
+            bool        srgb{};
+
+            LevelCodec(std::size_t channels, bool srgb)
+                :   channels{ channels }, colorChannels{ channels == 2 || channels == 4 ? channels - 1 : channels }, srgb{ srgb } {}
+
+            [[nodiscard]]
+            auto read(const std::uint8_t* texel) const -> Texel {
+                Texel result{};
+                for (std::size_t c{}; c < channels; c++)
+                    result[c] = srgb && c < colorChannels ? getLinearTable()[texel[c]] : static_cast<float>(texel[c]) / 255.0f;
+
+                return result;
+            }
+
+            auto write(const Texel& value, std::uint8_t* texel) const -> void {
+                // the Kaiser filter rings a little past the range of its inputs
+                for (std::size_t c{}; c < channels; c++) {
+                    const float clamped{ std::clamp(value[c], 0.0f, 1.0f) };
+                    texel[c] = srgb && c < colorChannels ? getEncodeTable()[static_cast<std::size_t>(std::lround(clamped * static_cast<float>(s_EncodeTableSize - 1)))]
+                                                         : static_cast<std::uint8_t>(std::lround(clamped * 255.0f));
+                }
+            }
+        };
+
+        struct LevelView {
+            const std::uint8_t* texels{};
+            std::size_t         width{};
+            std::size_t         height{};
+        };
+
+        auto boxRow(const LevelView& source, std::uint8_t* destination, std::size_t nextWidth, std::size_t y, const LevelCodec& codec) -> void {
+            const std::uint8_t* row0{ source.texels + std::min(y * 2, source.height - 1) * source.width * codec.channels };
+            const std::uint8_t* row1{ source.texels + std::min(y * 2 + 1, source.height - 1) * source.width * codec.channels };
+
+            for (std::size_t x{}; x < nextWidth; x++) {
+                const std::size_t x0{ std::min(x * 2, source.width - 1) * codec.channels };
+                const std::size_t x1{ std::min(x * 2 + 1, source.width - 1) * codec.channels };
+
+                Texel sum{};
+                accumulate(sum, codec.read(row0 + x0), 0.25f);
+                accumulate(sum, codec.read(row0 + x1), 0.25f);
+                accumulate(sum, codec.read(row1 + x0), 0.25f);
+                accumulate(sum, codec.read(row1 + x1), 0.25f);
+                codec.write(sum, destination + x * codec.channels);
+            }
+        }
+
+        // separable: the six source rows under output row y are filtered across first, then combined down
+        auto kaiserRow(const LevelView& source, std::uint8_t* destination, std::size_t nextWidth, std::size_t y, const LevelCodec& codec,
+                       std::vector<Texel>& line, std::vector<Texel>& rows) -> void {
+            const auto& weights{ getKaiserWeights() };
+            const auto width{ static_cast<std::ptrdiff_t>(source.width) };
+            rows.assign(s_KaiserTaps * nextWidth, Texel{});
+            line.resize(source.width);
+
+            for (std::size_t tap{}; tap < s_KaiserTaps; tap++) {
+                const auto sourceY{ static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(y * 2 + tap) - 2, 0, static_cast<std::ptrdiff_t>(source.height) - 1)) };
+                const std::uint8_t* row{ source.texels + sourceY * source.width * codec.channels };
+
+                // every texel is read by three outputs, converting the row once saves decoding it each time
+                for (std::size_t x{}; x < source.width; x++)
+                    line[x] = codec.read(row + x * codec.channels);
+
+                for (std::size_t x{}; x < nextWidth; x++) {
+                    for (std::size_t column{}; column < s_KaiserTaps; column++) {
+                        const std::ptrdiff_t sourceX{ std::clamp<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(x * 2 + column) - 2, 0, width - 1) };
+                        accumulate(rows[tap * nextWidth + x], line[static_cast<std::size_t>(sourceX)], weights[column]);
+                    }
+                }
+            }
+
+            for (std::size_t x{}; x < nextWidth; x++) {
+                Texel sum{};
+                for (std::size_t tap{}; tap < s_KaiserTaps; tap++)
+                    accumulate(sum, rows[tap * nextWidth + x], weights[tap]);
+
+                codec.write(sum, destination + x * codec.channels);
+            }
+        }
+    }
+
+    auto MipGenerator::GetLevelCount(std::int32_t width, std::int32_t height) -> std::int32_t {
+        std::int32_t levels{ 1 };
+        for (std::int32_t size{ std::max(width, height) }; size > 1; size /= 2)
+            ++levels;
+
+        return levels;
+    }
+
+    auto MipGenerator::GetMipBytes(std::int32_t width, std::int32_t height, std::int32_t channels) -> std::size_t {
+        std::size_t bytes{};
+        while (width > 1 || height > 1) {
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+            bytes += static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * static_cast<std::size_t>(channels);
+        }
+
+        return bytes;
+    }
+
+    auto MipGenerator::Generate(Texture::ImageData& image, bool srgb, Filter filter) -> void {
+        image.mips.assign(GetMipBytes(image.width, image.height, image.channels), 0);
+        if (image.mips.empty() || !image.pixels)
+            return;
+
+        // each level is filtered from the previous one, already rounded to 8 bits
+        const LevelCodec codec{ static_cast<std::size_t>(image.channels), srgb };
+        LevelView source{ image.pixels.get(), static_cast<std::size_t>(image.width), static_cast<std::size_t>(image.height) };
+        std::uint8_t* destination{ image.mips.data() };
+
+        while (source.width > 1 || source.height > 1) {
+            const std::size_t nextWidth{ std::max<std::size_t>(source.width / 2, 1) };
+            const std::size_t nextHeight{ std::max<std::size_t>(source.height / 2, 1) };
+
+            const auto filterRow{ [&](std::size_t y) -> void {
+                std::uint8_t* row{ destination + y * nextWidth * codec.channels };
+
+                if (filter == Filter::KAISER) {
+                    thread_local std::vector<Texel> line{};
+                    thread_local std::vector<Texel> rows{};
+                    kaiserRow(source, row, nextWidth, y, codec, line, rows);
+                }
+                else {
+                    boxRow(source, row, nextWidth, y, codec);
+                }
+            } };
+
+            if (nextWidth * nextHeight >= s_ParallelTexels) {
+                ThreadPool::Get().parallelFor(nextHeight, filterRow);
+            }
+            else {
+                for (std::size_t y{}; y < nextHeight; y++)
+                    filterRow(y);
+            }
+
+            source = { destination, nextWidth, nextHeight };
+            destination += nextWidth * nextHeight * codec.channels;
+        }
+    }
+}
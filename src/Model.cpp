@@ -1,27 +1,177 @@
 // C++ Standard Library
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <cstddef>
 
 // Project Libraries
 #include "OpenGL/Model.hh"
+#include "Core/Hash.hh"
+#include "Core/Logger.hh"
+#include "Core/ProcessMemory.hh"
+#include "Core/ThreadPool.hh"
+#include "OpenGL/BakedTexture.hh"
+#include "OpenGL/GltfLoader.hh"
+#include "OpenGL/MeshletBuilder.hh"
+#include "OpenGL/MeshOptimizer.hh"
+#include "OpenGL/MeshSimplifier.hh"
+#include "OpenGL/MipGenerator.hh"
+#include "OpenGL/ObjLoader.hh"
+#include "OpenGL/TangentGenerator.hh"
+#include "OpenGL/TextureStreamer.hh"
+#include "OpenGL/TextureUploader.hh"
 
 namespace kT {
-    Model::Model(const std::filesystem::path& path)
+    Model::Model(const std::filesystem::path& path, const ModelLoadOptions& options)
         :   m_ModelPath{ path.string().substr(0,  path.string().find_last_of('/')) }
     {
-        load(path);
+        load(path, options);
     }
 
-    auto Model::LoadFromFile(const std::string path) -> void {
+    auto Model::LoadFromFile(const std::string path, const ModelLoadOptions& options) -> void {
         m_ModelPath = path.substr(0, path.find_last_of('/'));
-        load(path);
+        load(path, options);
     }
 
-    auto Model::load(const std::filesystem::path& path) -> void {
+    auto Model::load(const std::filesystem::path& path, const ModelLoadOptions& options) -> void {
+        const auto start{ std::chrono::steady_clock::now() };
+
+        PreparedModel prepared{ Prepare(path, options) };
+
+        m_Meshes.reserve(m_Meshes.size() + prepared.meshes.size());
+        while (uploadNext(prepared)) {}
+        // a blocking load returns with every texture level in video memory
+        TextureUploader::Flush();
+
+        const std::chrono::duration<double, std::milli> elapsed{ std::chrono::steady_clock::now() - start };
+        KATE_LOGGER_INFO("Loaded model {} in {:.2f} ms, peak RSS {:.2f} MB", path.string(), elapsed.count(),
+                         static_cast<double>(getPeakResidentBytes()) / (1024.0 * 1024.0));
+    }
+
+    auto Model::Prepare(const std::filesystem::path& path, const ModelLoadOptions& options) -> PreparedModel {
         if (!path.has_filename())
             throw std::runtime_error("Not valid path for model object");
 
+        PreparedModel prepared{};
+        prepared.path = path;
+        prepared.options = options;
+        resetPeakResidentBytes();
+
+        const std::filesystem::path directory{ path.parent_path() };
+        const std::filesystem::path bakePath{ BakedModel::GetBakePath(path) };
+        std::uint64_t sourceHash{};
+
+        if (options.useBakedCache) {
+            sourceHash = HashSources(path, options);
+            prepared.baked = BakedModel::Open(bakePath, sourceHash, directory);
+        }
+
+        if (prepared.baked) {
+            const auto views{ prepared.baked->getMeshes() };
+            const auto instances{ prepared.baked->getInstances() };
+            prepared.meshes.assign(views.begin(), views.end());
+            prepared.instances.assign(instances.begin(), instances.end());
+            prepared.scene = prepared.baked->getScene();
+            recordStage(prepared, "open bake");
+        }
+        else {
+            // the native loaders parse the whole file at once, only their processing waits for the upload
+            prepared.processOnUpload = prepared.isStreaming();
+
+            if (options.nativeImporters && ObjLoader::IsSupported(path))
+                prepared.imported = ObjLoader::Load(path);
+            else if (options.nativeImporters && GltfLoader::IsSupported(path))
+                prepared.imported = GltfLoader::Load(path, prepared.scene, prepared.instances);
+            else if (prepared.processOnUpload)
+                importStreamed(prepared);
+            else
+                prepared.imported = import(path, prepared.scene, prepared.instances);
+
+            recordStage(prepared, "import");
+
+            // formats without a node hierarchy place every mesh once under a single root
+            if (prepared.scene.isEmpty()) {
+                prepared.scene.addNode(SceneGraph::s_NoParent, glm::mat4(1.0f), path.filename().string());
+                prepared.instances.resize(prepared.imported.size());
+                for (std::size_t i{}; i < prepared.imported.size(); i++)
+                    prepared.instances[i].mesh = static_cast<std::uint32_t>(i);
+            }
+
+            if (prepared.processOnUpload) {
+                // a bake needs every processed mesh at once, which is what streaming avoids
+                KATE_LOGGER_INFO("Streaming import of {} processes its meshes as they are uploaded, no bake is written", path.string());
+            }
+            else {
+                if (options.optimizeMeshes) {
+                    optimize(path, prepared.imported);
+                    recordStage(prepared, "optimize");
+                }
+
+                // splits vertices, so it runs once the vertex order is final and before anything indexes into it
+                if (options.generateTangents) {
+                    generateTangents(path, prepared.imported);
+                    recordStage(prepared, "tangents");
+                }
+
+                if (options.buildMeshlets) {
+                    buildMeshlets(path, prepared.imported);
+                    recordStage(prepared, "meshlets");
+                }
+
+                generateLods(path, prepared.imported, options.generateLods);
+                recordStage(prepared, "lods");
+
+                if (options.useBakedCache) {
+                    try {
+                        BakedModel::Write(bakePath, sourceHash, prepared.imported, prepared.instances, prepared.scene, directory, options.compressBakes);
+                    }
+                    catch (const std::exception& e) {
+                        // not being able to cache the model is not fatal, it is imported again next time
+                        KATE_LOGGER_WARN("Could not bake model {}: {}", path.string(), e.what());
+                    }
+
+                    recordStage(prepared, "bake");
+                }
+            }
+
+            prepared.meshes.reserve(prepared.imported.size());
+            for (const auto& mesh : prepared.imported)
+                prepared.meshes.emplace_back(mesh);
+        }
+
+        prepared.scene.update();
+        for (auto& instance : prepared.instances)
+            instance.transform = prepared.scene.getWorldTransform(instance.node);
+
+        if (options.compactVertices)
+            prepared.quantized.resize(prepared.meshes.size());
+        prepared.tangents.resize(prepared.meshes.size());
+
+        if (prepared.processOnUpload) {
+            prepared.processing.resize(prepared.meshes.size());
+            prepared.meshBytes.resize(prepared.meshes.size());
+        }
+
+        // a streaming import encodes each mesh right before uploading it, so only one encoded copy exists at a time
+        if (!prepared.isStreaming()) {
+            ThreadPool::Get().parallelFor(prepared.meshes.size(), [&prepared](std::size_t i) -> void { encodeVertices(prepared, i); });
+            recordStage(prepared, "encode");
+        }
+
+        // the geometry of meshes processed on upload is not final yet
+        if (!prepared.processOnUpload)
+            reportGeometrySize(prepared);
+
+        scheduleTextures(prepared);
+        return prepared;
+    }
+
+    auto Model::readScene(const std::filesystem::path& path, Assimp::Importer& importer) -> const aiScene* {
         std::array<char, 4096> fileDir{};
 #if  defined(_WIN64) || defined(WIN32)
         wcstombs_s(nullptr, fileDir.data(), fileDir.size(), path.c_str(), 4096);
@@ -29,57 +179,656 @@ namespace kT {
         std::copy(path.native().begin(), path.native().end(), fileDir.begin());
 #endif
 
-        Assimp::Importer importer{};
-
         // See more postprocessing options: https://assimp.sourceforge.net/lib_html/postprocess_8h.html
-        auto scene = importer.ReadFile(fileDir.data(),
-                                                 aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices);
-        if((scene == nullptr) || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || (scene->mRootNode == nullptr))
+        auto imported = importer.ReadFile(fileDir.data(), s_ImportFlags);
+        if((imported == nullptr) || (imported->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || (imported->mRootNode == nullptr))
             throw std::runtime_error(importer.GetErrorString());
 
-        m_Meshes.reserve(scene->mRootNode->mNumMeshes);
-        processNode(scene->mRootNode, scene);
+        return imported;
+    }
+
+    auto Model::import(const std::filesystem::path& path, SceneGraph& scene, std::vector<MeshInstance>& instances) -> std::vector<MeshData> {
+        Assimp::Importer importer{};
+        const aiScene* imported{ readScene(path, importer) };
+
+        // the node walk is cheap, it only places the meshes and fixes the order they are kept in
+        processNode(imported->mRootNode, SceneGraph::s_NoParent, scene, instances);
+        const std::vector<std::uint32_t> order{ deduplicate(path, instances) };
+
+        // every task writes its own slot, so the result does not depend on which thread finishes first
+        const auto start{ std::chrono::steady_clock::now() };
+        const std::filesystem::path directory{ path.parent_path() };
+
+        // embedded images are copied once however many materials use them
+        std::vector<TextureRef> embedded(imported->mNumTextures);
+        ThreadPool::Get().parallelFor(embedded.size(), [&](std::size_t i) -> void { embedded[i] = loadEmbeddedTexture(imported->mTextures[i], path, i); });
+
+        std::vector<MeshData> meshes(order.size());
+        ThreadPool::Get().parallelFor(order.size(), [&](std::size_t i) -> void {
+            meshes[i] = processMesh(imported->mMeshes[order[i]], imported, directory, embedded);
+        });
+
+        // the converted meshes hold copies of everything used, the scene is released before the next stages run.
+        // Both exist at once for the whole model here, streaming imports convert one mesh at a time instead
+        importer.FreeScene();
+
+        const std::chrono::duration<double, std::milli> elapsed{ std::chrono::steady_clock::now() - start };
+        KATE_LOGGER_DEBUG("Processed {} meshes of {} in {:.2f} ms on {} threads", meshes.size(), path.string(), elapsed.count(),
+                          ThreadPool::Get().getThreadCount() + 1);
+
+        return meshes;
+    }
+
+    auto Model::importStreamed(PreparedModel& prepared) -> void {
+        // the scene outlives its importer, so the meshes it holds can be freed one by one as they are converted
+        Assimp::Importer importer{};
+        readScene(prepared.path, importer);
+        prepared.sourceScene = std::shared_ptr<aiScene>{ importer.GetOrphanedScene() };
+        const aiScene* imported{ prepared.sourceScene.get() };
+
+        processNode(imported->mRootNode, SceneGraph::s_NoParent, prepared.scene, prepared.instances);
+        prepared.sourceMeshes = deduplicate(prepared.path, prepared.instances);
+
+        auto embedded{ std::make_shared<std::vector<TextureRef>>(imported->mNumTextures) };
+        ThreadPool::Get().parallelFor(embedded->size(), [&](std::size_t i) -> void { (*embedded)[i] = loadEmbeddedTexture(imported->mTextures[i], prepared.path, i); });
+        prepared.embedded = std::move(embedded);
+
+        // the materials are read now so the texture decodes of upcoming meshes can be queued ahead of their conversion
+        const std::filesystem::path directory{ prepared.path.parent_path() };
+        prepared.imported.resize(prepared.sourceMeshes.size());
+        for (std::size_t i{}; i < prepared.sourceMeshes.size(); i++)
+            prepared.imported[i].textures = processMaterial(imported->mMeshes[prepared.sourceMeshes[i]], imported, directory, *prepared.embedded);
+    }
+
+    auto Model::GetBakeSettings(const ModelLoadOptions& options) -> std::uint64_t {
+        // settings changing the imported data are part of the hash, so bakes made with others are stale
+        const std::string settings{ std::to_string(s_ImportFlags) + (options.optimizeMeshes ? "+optimized" : "") +
+                               (options.generateLods ? "+lods" : "") + (options.buildMeshlets ? "+meshlets" : "") +
+                               (options.nativeImporters ? "+native" : "") + (options.generateTangents ? "+tangents" : "") };
+        return hashString(settings);
+    }
+
+    auto Model::GetSourceFiles(const std::filesystem::path& path, const ModelLoadOptions& options) -> std::vector<std::filesystem::path> {
+        std::vector<std::filesystem::path> sources{ path };
+        std::vector<std::filesystem::path> dependencies{};
+
+        if (options.nativeImporters && ObjLoader::IsSupported(path))
+            dependencies = ObjLoader::GetDependencies(path);
+        else if (options.nativeImporters && GltfLoader::IsSupported(path))
+            dependencies = GltfLoader::GetDependencies(path);
+
+        sources.insert(sources.end(), dependencies.begin(), dependencies.end());
+        return sources;
+    }
+
+    auto Model::HashSources(const std::filesystem::path& path, const ModelLoadOptions& options) -> std::uint64_t {
+        std::uint64_t hash{ GetBakeSettings(options) };
+        for (const auto& source : GetSourceFiles(path, options)) {
+            // a missing material library is not an import error, creating it later changes the hash anyway
+            if (source == path || std::filesystem::exists(source))
+                hash = BakedModel::HashSource(source, hash);
+        }
+
+        return hash;
+    }
+
+    auto Model::decodeImage(const TextureRef& ref, bool baked) -> Texture::ImageData {
+        if (baked && !ref.embedded)
+            return BakedTexture::Decode(ref.path, ref.type);
+
+        // the mips are generated here on the worker, not by the driver on the thread owning the context
+        Texture::ImageData image{ ref.embedded ? Texture::decode(*ref.embedded) : Texture::decode(ref.path) };
+        MipGenerator::Generate(image, ref.type == Texture::TextureType::DIFFUSE);
+        return image;
+    }
+
+    auto Model::optimize(const std::filesystem::path& path, std::vector<MeshData>& meshes) -> void {
+        MeshOptimizer::CacheStats before{};
+        MeshOptimizer::CacheStats after{};
+        std::size_t triangles{};
+
+        std::vector<std::size_t> meshTriangles(meshes.size());
+        std::vector<MeshOptimizer::Report> reports(meshes.size());
+        ThreadPool::Get().parallelFor(meshes.size(), [&](std::size_t i) -> void {
+            meshTriangles[i] = meshes[i].indices.size() / 3;
+            reports[i] = MeshOptimizer::Optimize(meshes[i]);
+        });
+
+        // figures are gathered in mesh order once every mesh is done
+        for (std::size_t i{}; i < meshes.size(); i++) {
+            const auto& report{ reports[i] };
+
+            if (!report.optimized) {
+                KATE_LOGGER_WARN("Mesh {} of {} is not a valid triangle list, left unoptimized", i, path.string());
+                continue;
+            }
+
+            KATE_LOGGER_DEBUG("Mesh {} of {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}", i, path.string(),
+                              report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr);
+
+            // model wide figures are weighted by triangle count
+            before.acmr += report.before.acmr * static_cast<float>(meshTriangles[i]);
+            before.atvr += report.before.atvr * static_cast<float>(meshTriangles[i]);
+            after.acmr += report.after.acmr * static_cast<float>(meshTriangles[i]);
+            after.atvr += report.after.atvr * static_cast<float>(meshTriangles[i]);
+            triangles += meshTriangles[i];
+        }
+
+        if (triangles != 0) {
+            const auto total{ static_cast<float>(triangles) };
+            KATE_LOGGER_INFO("Optimized {} meshes of {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}", meshes.size(), path.string(),
+                             before.acmr / total, after.acmr / total, before.atvr / total, after.atvr / total);
+        }
     }
 
-    auto Model::processNode(aiNode* root, const aiScene* scene) -> void {
-        // Process all the meshes from this node
+    auto Model::generateLods(const std::filesystem::path& path, std::vector<MeshData>& meshes, bool generate) -> void {
+        std::size_t levels{};
+        std::size_t fullIndices{};
+        std::size_t lodIndices{};
+
+        ThreadPool::Get().parallelFor(meshes.size(), [&](std::size_t i) -> void { MeshSimplifier::GenerateLods(meshes[i], generate); });
+
+        for (std::size_t i{}; i < meshes.size(); i++) {
+            const auto& lods{ meshes[i].lods };
+            KATE_LOGGER_DEBUG("Mesh {} of {}: {} levels of detail, {} -> {} triangles", i, path.string(), lods.size(),
+                              lods.front().indexCount / 3, lods.back().indexCount / 3);
+
+            levels += lods.size();
+            fullIndices += lods.front().indexCount;
+            lodIndices += meshes[i].indices.size() - lods.front().indexCount;
+        }
+
+        if (generate && !meshes.empty()) {
+            KATE_LOGGER_INFO("Generated {} levels of detail for {} meshes of {}, adding {:.1f}% indices", levels, meshes.size(), path.string(),
+                             fullIndices == 0 ? 0.0 : 100.0 * static_cast<double>(lodIndices) / static_cast<double>(fullIndices));
+        }
+    }
+
+    auto Model::buildMeshlets(const std::filesystem::path& path, std::vector<MeshData>& meshes) -> void {
+        std::size_t meshlets{};
+        std::size_t triangles{};
+
+        ThreadPool::Get().parallelFor(meshes.size(), [&meshes](std::size_t i) -> void { MeshletBuilder::Build(meshes[i]); });
+
+        for (const auto& mesh : meshes) {
+            meshlets += mesh.meshlets.size();
+            for (const auto& meshlet : mesh.meshlets)
+                triangles += meshlet.indexCount / 3;
+        }
+
+        if (meshlets != 0) {
+            KATE_LOGGER_INFO("Split {} meshes of {} into {} meshlets, {:.1f} triangles each", meshes.size(), path.string(), meshlets,
+                             static_cast<double>(triangles) / static_cast<double>(meshlets));
+        }
+    }
+
+    auto Model::generateTangents(const std::filesystem::path& path, std::vector<MeshData>& meshes) -> void {
+        std::vector<std::size_t> splits(meshes.size());
+        ThreadPool::Get().parallelFor(meshes.size(), [&](std::size_t i) -> void {
+            if (TangentGenerator::IsNeeded(meshes[i]))
+                splits[i] = TangentGenerator::Generate(meshes[i]);
+        });
+
+        std::size_t tangentMeshes{};
+        std::size_t splitVertices{};
+        for (std::size_t i{}; i < meshes.size(); i++) {
+            if (meshes[i].tangents.empty())
+                continue;
+
+            ++tangentMeshes;
+            splitVertices += splits[i];
+        }
+
+        if (tangentMeshes != 0) {
+            KATE_LOGGER_INFO("Generated tangents for {} normal mapped meshes of {}, splitting {} vertices at texture seams", tangentMeshes,
+                             path.string(), splitVertices);
+        }
+    }
+
+    auto Model::processImported(MeshData& mesh, const ModelLoadOptions& options) -> void {
+        // same stages in the same order as a whole model import, without the per model reports
+        if (options.optimizeMeshes)
+            MeshOptimizer::Optimize(mesh);
+
+        if (options.generateTangents && TangentGenerator::IsNeeded(mesh))
+            TangentGenerator::Generate(mesh);
+
+        if (options.buildMeshlets)
+            MeshletBuilder::Build(mesh);
+
+        MeshSimplifier::GenerateLods(mesh, options.generateLods);
+    }
+
+    auto Model::reportGeometrySize(const PreparedModel& prepared) -> void {
+        const std::size_t standardStride{ Mesh::GetLayout().getStride() };
+        const std::size_t stride{ Mesh::GetLayout(prepared.getVertexFormat()).getStride() };
+
+        std::size_t standardBytes{};
+        std::size_t bytes{};
+        std::size_t shortIndexMeshes{};
+        std::vector<std::size_t> meshBytes(prepared.meshes.size());
+
+        for (std::size_t i{}; i < prepared.meshes.size(); i++) {
+            const std::size_t vertexCount{ prepared.getVertexCount(i) };
+            const BakedModel::GeometrySize size{ prepared.getGeometrySize(i) };
+            const std::size_t indexCount{ size.indices };
+
+            meshBytes[i] = vertexCount * stride + GeometryArena::GetIndexBytes(vertexCount, indexCount) +
+                           size.tangents / TangentGenerator::s_Components * sizeof(std::uint32_t);
+            standardBytes += vertexCount * standardStride + indexCount * sizeof(std::uint32_t) + size.tangents * sizeof(float);
+            bytes += meshBytes[i];
+
+            if (GeometryArena::GetIndexType(vertexCount) == GL_UNSIGNED_SHORT)
+                ++shortIndexMeshes;
+        }
+
+        if (standardBytes == 0)
+            return;
+
+        static constexpr double megabyte{ 1024.0 * 1024.0 };
+        KATE_LOGGER_INFO("Geometry of {}: {:.2f} MB instead of {:.2f} MB ({:.1f}% saved), {} bytes fetched per vertex instead of {}, "
+                         "{} of {} meshes with 16 bit indices", prepared.path.string(), static_cast<double>(bytes) / megabyte,
+                         static_cast<double>(standardBytes) / megabyte, 100.0 * (1.0 - static_cast<double>(bytes) / static_cast<double>(standardBytes)),
+                         stride, standardStride, shortIndexMeshes, prepared.meshes.size());
+
+        // what copying the mesh into every node referencing it would have taken
+        std::size_t instancedBytes{};
+        for (const auto& instance : prepared.instances)
+            instancedBytes += meshBytes[instance.mesh];
+
+        if (instancedBytes > bytes) {
+            KATE_LOGGER_INFO("Instancing {} placements of {} meshes of {} saves {:.2f} MB of geometry", prepared.instances.size(),
+                             prepared.meshes.size(), prepared.path.string(), static_cast<double>(instancedBytes - bytes) / megabyte);
+        }
+    }
+
+    auto Model::processNode(const aiNode* root, std::uint32_t parent, SceneGraph& scene, std::vector<MeshInstance>& instances) -> void {
+        // assimp matrices are row major, glm takes columns
+        const aiMatrix4x4& local{ root->mTransformation };
+        const std::uint32_t node{ scene.addNode(parent, glm::transpose(glm::mat4(local.a1, local.a2, local.a3, local.a4, local.b1, local.b2, local.b3, local.b4,
+                                                                                 local.c1, local.c2, local.c3, local.c4, local.d1, local.d2, local.d3, local.d4)),
+                                                root->mName.C_Str()) };
+
+        // Collect all the meshes from this node
         for(std::size_t i{}; i < root->mNumMeshes; i++)
-            m_Meshes.push_back(std::move(processMesh(scene->mMeshes[root->mMeshes[i]], scene)));
+            instances.push_back(MeshInstance{ root->mMeshes[i], node });
 
         // then do the same for each of its children
         for(std::size_t i {}; i < root->mNumChildren; i++)
-                processNode(root->mChildren[i], scene);
+                processNode(root->mChildren[i], node, scene, instances);
+    }
+
+    auto Model::deduplicate(const std::filesystem::path& path, std::vector<MeshInstance>& instances) -> std::vector<std::uint32_t> {
+        std::vector<std::uint32_t> order{};
+        std::unordered_map<std::uint32_t, std::uint32_t> compact{};
+
+        for (auto& instance : instances) {
+            const auto [it, inserted]{ compact.try_emplace(instance.mesh, static_cast<std::uint32_t>(order.size())) };
+            if (inserted)
+                order.push_back(instance.mesh);
+
+            instance.mesh = it->second;
+        }
+
+        // the renderer batches contiguous instances of the same mesh into one draw
+        std::stable_sort(instances.begin(), instances.end(), [](const MeshInstance& a, const MeshInstance& b) -> bool { return a.mesh < b.mesh; });
+
+        if (instances.size() > order.size()) {
+            KATE_LOGGER_INFO("{} node references of {} share {} distinct meshes", instances.size(), path.string(), order.size());
+        }
+
+        return order;
+    }
+
+    auto Model::scheduleTextures(PreparedModel& prepared) -> void {
+        // Decode every image missing from the cache on the worker pool, nobody waits
+        // here so this is also safe to call from one of the pool threads
+        prepared.textureKeys.resize(prepared.meshes.size());
+
+        for (std::size_t i{}; i < prepared.meshes.size(); i++) {
+            for (const auto& ref : prepared.meshes[i].textures) {
+                prepared.textureKeys[i].push_back(TextureCache::MakeKey(ref.path, ref.type));
+
+                const auto& key{ prepared.textureKeys[i].back() };
+                // raw texels need no decoding, they are uploaded as they are
+                if (!prepared.options.parallelTextureDecode || prepared.isStreaming() || ref.isRaw() || TextureCache::Contains(key) || prepared.images.contains(key))
+                    continue;
+
+                prepared.images.emplace(key, ThreadPool::Get().submit([ref, baked = prepared.options.useBakedCache]() -> Texture::ImageData { return decodeImage(ref, baked); }));
+            }
+        }
+    }
+
+    auto Model::uploadNext(PreparedModel& prepared, bool wait) -> bool {
+        if (prepared.isUploaded())
+            return false;
+
+        const std::size_t index{ prepared.uploaded };
+        const auto& mesh{ prepared.meshes[index] };
+        const auto& keys{ prepared.textureKeys[index] };
+
+        if (prepared.isStreaming())
+            scheduleStreamedTextures(prepared);
+
+        if (prepared.processOnUpload)
+            scheduleStreamedMeshes(prepared);
+
+        if (!wait) {
+            for (const auto& key : keys) {
+                auto it{ prepared.images.find(key) };
+                if (it != prepared.images.end() && it->second.valid() &&
+                    it->second.wait_for(std::chrono::seconds::zero()) != std::future_status::ready)
+                    return false;
+            }
+
+            if (prepared.processOnUpload && prepared.processing[index].wait_for(std::chrono::seconds::zero()) != std::future_status::ready)
+                return false;
+        }
+
+        if (prepared.processOnUpload) {
+            // the textures were read with the scene, the processed mesh only brings the geometry
+            MeshData processed{ prepared.processing[index].get() };
+            processed.textures = std::move(prepared.imported[index].textures);
+            prepared.imported[index] = std::move(processed);
+            prepared.meshes[index] = MeshView{ prepared.imported[index] };
+            prepared.processingBytes -= prepared.meshBytes[index];
+        }
+
+        if (index == 0) {
+            m_ModelPath = prepared.path.parent_path();
+
+            // meshes and nodes of files loaded before come before the ones of this file
+            const auto meshOffset{ static_cast<std::uint32_t>(m_Meshes.size()) };
+            const std::uint32_t nodeOffset{ m_Scene.append(prepared.scene) };
+            for (const auto& instance : prepared.instances)
+                m_Instances.push_back(MeshInstance{ meshOffset + instance.mesh, nodeOffset + instance.node, instance.transform });
+
+            if (!prepared.processOnUpload) {
+                std::size_t vertexCount{};
+                std::size_t indexBytes{};
+                for (std::size_t i{}; i < prepared.meshes.size(); i++) {
+                    vertexCount += prepared.getVertexCount(i);
+                    indexBytes += GeometryArena::GetIndexBytes(prepared.getVertexCount(i), prepared.getGeometrySize(i).indices);
+                }
+
+                // one range for the whole model keeps all of its meshes in the same block
+                m_Geometry.push_back(GeometryArena::Allocate(prepared.getVertexFormat(), vertexCount, indexBytes, prepared.hasTangents()));
+                prepared.geometry = m_Geometry.back().getRange();
+            }
+        }
+
+        // Uploads need the OpenGL context, so they stay on this thread. Texels are queued and
+        // sent over the next frames by kT::TextureUploader, only the smallest level goes now
+        std::vector<std::shared_ptr<Texture>> textures{};
+        textures.reserve(mesh.textures.size());
+
+        for (std::size_t t{}; t < mesh.textures.size(); t++) {
+            const auto& ref{ mesh.textures[t] };
+
+            if (auto cached{ TextureCache::Find(keys[t]) })
+                textures.push_back(std::move(cached));
+            else if (auto it{ prepared.images.find(keys[t]) }; it != prepared.images.end() && it->second.valid())
+                textures.push_back(TextureCache::Insert(keys[t], Texture::fromImageAsync(it->second.get(), ref.type, prepared.options.streamTextures)));
+            else if (ref.isRaw())
+                textures.push_back(TextureCache::Insert(keys[t], Texture::fromData(ref.embedded->data(), ref.type, ref.rawSize.first, ref.rawSize.second)));
+            else
+                textures.push_back(TextureCache::Insert(keys[t], Texture::fromImageAsync(decodeImage(ref, prepared.options.useBakedCache), ref.type,
+                                                                                         prepared.options.streamTextures)));
+
+            // does nothing for textures not streamed or already registered through another mesh
+            TextureStreamer::Register(textures.back());
+        }
+
+        encodeVertices(prepared, index);
+
+        GeometryArena::Range range{ prepared.geometry };
+        if (prepared.processOnUpload) {
+            // the size of a mesh processed on upload is only known now, so it gets a range of its own
+            const std::size_t vertexCount{ prepared.getVertexCount(index) };
+            m_Geometry.push_back(GeometryArena::Allocate(prepared.getVertexFormat(), vertexCount,
+                                                         GeometryArena::GetIndexBytes(vertexCount, mesh.indices.size()), !mesh.tangents.empty()));
+            range = m_Geometry.back().getRange();
+        }
+        else {
+            range.firstVertex += static_cast<std::uint32_t>(prepared.uploadedVertices);
+            range.vertexCount = static_cast<std::uint32_t>(prepared.getVertexCount(index));
+            range.indexOffset += static_cast<std::uint32_t>(prepared.uploadedIndexBytes);
+            range.indexBytes = static_cast<std::uint32_t>(GeometryArena::GetIndexBytes(range.vertexCount, mesh.indices.size()));
+        }
+
+        m_Meshes.emplace_back(range, prepared.getVertices(index), mesh.indices, mesh.lods, mesh.bounds, mesh.meshlets, std::move(textures));
+        prepared.uploadedVertices += range.vertexCount;
+        prepared.uploadedIndexBytes += range.indexBytes;
+        ++prepared.uploaded;
+
+        if (prepared.isStreaming())
+            releaseMesh(prepared, index);
+
+        if (prepared.isUploaded()) {
+            recordStage(prepared, "upload");
+            reportMemory(prepared);
+        }
+
+        return true;
+    }
+
+    auto Model::encodeVertices(PreparedModel& prepared, std::size_t mesh) -> void {
+        // bakes store the vertices and tangents already encoded, compressed ones hold a mesh decoded only from here until it is released
+        if (prepared.baked) {
+            prepared.baked->decode(mesh, prepared.getVertexFormat());
+            prepared.meshes[mesh] = prepared.baked->getMeshes()[mesh];
+            return;
+        }
+
+        if (prepared.options.compactVertices && prepared.quantized[mesh].data.empty())
+            prepared.quantized[mesh] = VertexQuantizer::Quantize(prepared.meshes[mesh].vertices);
+
+        if (prepared.tangents[mesh].empty())
+            prepared.tangents[mesh] = VertexQuantizer::PackTangents(prepared.meshes[mesh].tangents);
+    }
+
+    auto Model::releaseMesh(PreparedModel& prepared, std::size_t mesh) -> void {
+        // the arena holds the geometry now, baked data goes back to the file and imported data is freed
+        if (prepared.baked)
+            prepared.baked->evict(mesh);
+        else
+            prepared.imported[mesh] = MeshData{};
+
+        if (!prepared.quantized.empty())
+            prepared.quantized[mesh] = QuantizedVertices{};
+
+        prepared.tangents[mesh] = std::vector<std::uint32_t>{};
+        prepared.meshes[mesh] = MeshView{};
+
+        // images are in the texture cache once uploaded, later meshes find them there
+        for (const auto& key : prepared.textureKeys[mesh]) {
+            auto image{ prepared.images.find(key) };
+            if (image == prepared.images.end() || image->second.valid())
+                continue;
+
+            prepared.images.erase(image);
+            if (auto bytes{ prepared.imageBytes.find(key) }; bytes != prepared.imageBytes.end()) {
+                prepared.decodingBytes -= bytes->second;
+                prepared.imageBytes.erase(bytes);
+            }
+        }
+    }
+
+    auto Model::scheduleStreamedTextures(PreparedModel& prepared) -> void {
+        if (!prepared.options.parallelTextureDecode)
+            return;
+
+        for (; prepared.scheduledMeshes < prepared.meshes.size(); ++prepared.scheduledMeshes) {
+            const std::size_t mesh{ prepared.scheduledMeshes };
+            const auto& refs{ prepared.meshes[mesh].textures };
+            const auto& keys{ prepared.textureKeys[mesh] };
+
+            // decoded images take at most four bytes per texel, counting four keeps the budget an upper bound
+            std::vector<std::size_t> bytes(refs.size());
+            std::size_t meshBytes{};
+            for (std::size_t t{}; t < refs.size(); t++) {
+                if (refs[t].isRaw() || TextureCache::Contains(keys[t]) || prepared.images.contains(keys[t]))
+                    continue;
+
+                const auto [width, height]{ refs[t].embedded ? Texture::probe(*refs[t].embedded) : Texture::probe(refs[t].path) };
+                bytes[t] = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4;
+
+                // images come with their whole mip chain, a third more texels at most
+                bytes[t] += bytes[t] / 3;
+                meshBytes += bytes[t];
+            }
+
+            // the mesh that does not fit decodes its textures when uploaded, with nothing else in flight
+            if (getResidentBytes() + prepared.decodingBytes + meshBytes > prepared.options.memoryBudget)
+                return;
+
+            for (std::size_t t{}; t < refs.size(); t++) {
+                if (refs[t].isRaw() || TextureCache::Contains(keys[t]) || prepared.images.contains(keys[t]))
+                    continue;
+
+                prepared.images.emplace(keys[t], ThreadPool::Get().submit([ref = refs[t], baked = prepared.options.useBakedCache]() -> Texture::ImageData { return decodeImage(ref, baked); }));
+
+                prepared.imageBytes.emplace(keys[t], bytes[t]);
+                prepared.decodingBytes += bytes[t];
+            }
+        }
     }
 
-    auto Model::processMesh(aiMesh* mesh, const aiScene* scene) -> kT::Mesh {
+    auto Model::scheduleStreamedMeshes(PreparedModel& prepared) -> void {
+        for (; prepared.processedMeshes < prepared.meshes.size(); ++prepared.processedMeshes) {
+            const std::size_t mesh{ prepared.processedMeshes };
+
+            std::size_t bytes{};
+            if (prepared.sourceScene) {
+                const aiMesh* source{ prepared.sourceScene->mMeshes[prepared.sourceMeshes[mesh]] };
+                bytes = static_cast<std::size_t>(source->mNumVertices) * Mesh::GetLayout().getStride() +
+                        static_cast<std::size_t>(source->mNumFaces) * 3 * sizeof(std::uint32_t);
+            }
+            else {
+                bytes = prepared.imported[mesh].vertices.size() * sizeof(float) + prepared.imported[mesh].indices.size() * sizeof(std::uint32_t);
+            }
+
+            // tangents, levels of detail and the copies the optimizer works on take about as much again
+            bytes *= 2;
+
+            // the mesh that does not fit is processed once it is the next one uploaded
+            if (mesh != prepared.uploaded &&
+                getResidentBytes() + prepared.decodingBytes + prepared.processingBytes + bytes > prepared.options.memoryBudget)
+                return;
+
+            if (prepared.sourceScene) {
+                prepared.processing[mesh] = ThreadPool::Get().submit([scene = prepared.sourceScene, embedded = prepared.embedded, source = prepared.sourceMeshes[mesh],
+                                                                      directory = prepared.path.parent_path(), options = prepared.options]() -> MeshData {
+                    MeshData data{ processMesh(scene->mMeshes[source], scene.get(), directory, *embedded) };
+
+                    // every mesh is converted once and the copy holds all it needs, only the aiMesh of meshes not queued yet are read again
+                    delete scene->mMeshes[source];
+                    scene->mMeshes[source] = nullptr;
+
+                    processImported(data, options);
+                    return data;
+                });
+            }
+            else {
+                // the geometry moves to the worker, the textures stay for the decodes scheduled meanwhile
+                MeshData data{ std::move(prepared.imported[mesh]) };
+                prepared.imported[mesh] = MeshData{};
+                prepared.imported[mesh].textures = std::move(data.textures);
+                prepared.meshes[mesh] = MeshView{ prepared.imported[mesh] };
+
+                prepared.processing[mesh] = ThreadPool::Get().submit([data = std::move(data), options = prepared.options]() mutable -> MeshData {
+                    processImported(data, options);
+                    return std::move(data);
+                });
+            }
+
+            prepared.meshBytes[mesh] = bytes;
+            prepared.processingBytes += bytes;
+        }
+
+        // the queued conversions hold what is left of the scene until the last one is done
+        prepared.sourceScene.reset();
+        prepared.embedded.reset();
+    }
+
+    auto Model::recordStage(PreparedModel& prepared, std::string_view stage) -> void {
+        prepared.stages.push_back(ImportStage{ stage, getResidentBytes(), getPeakResidentBytesSinceReset() });
+        resetPeakResidentBytes();
+
+        KATE_LOGGER_DEBUG("Import of {} after {}: {:.2f} MB resident", prepared.path.string(), stage,
+                          static_cast<double>(prepared.stages.back().residentBytes) / (1024.0 * 1024.0));
+    }
+
+    auto Model::reportMemory(const PreparedModel& prepared) -> void {
+        static constexpr double megabyte{ 1024.0 * 1024.0 };
+
+        std::string stages{};
+        for (const auto& stage : prepared.stages) {
+            if (!stages.empty())
+                stages += ", ";
+
+            stages += fmt::format("{} {:.1f} MB", stage.name, static_cast<double>(stage.peakResidentBytes) / megabyte);
+        }
+
+        KATE_LOGGER_INFO("Peak RSS of {} by import stage: {}", prepared.path.string(), stages);
+
+        std::size_t peak{};
+        for (const auto& stage : prepared.stages)
+            peak = std::max(peak, stage.peakResidentBytes);
+
+        if (prepared.isStreaming() && peak > prepared.options.memoryBudget) {
+            KATE_LOGGER_WARN("Import of {} peaked at {:.1f} MB, over its memory budget of {:.1f} MB", prepared.path.string(),
+                             static_cast<double>(peak) / megabyte, static_cast<double>(prepared.options.memoryBudget) / megabyte);
+        }
+    }
+
+    auto Model::processMesh(aiMesh* mesh, const aiScene* scene, const std::filesystem::path& directory, std::span<const TextureRef> embedded) -> MeshData {
         std::vector<float> vertices{};
         std::vector<std::uint32_t> indices{};
-        std::vector<kT::Texture> textures{};
+
+        // sized up front and written in place, the layout is the one of kT::Mesh::GetLayout()
+        constexpr std::size_t floatsPerVertex{ 8 };
+        vertices.resize(static_cast<std::size_t>(mesh->mNumVertices) * floatsPerVertex);
+
+        const bool hasNormals{ mesh->HasNormals() };
+        const aiVector3D* textureCoordinates{ mesh->mTextureCoords[0] };
 
         for(std::size_t i = 0; i < mesh->mNumVertices; i++) {
-            vertices.insert(vertices.end(), { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z });
+            float* vertex{ vertices.data() + i * floatsPerVertex };
+
+            vertex[0] = mesh->mVertices[i].x;
+            vertex[1] = mesh->mVertices[i].y;
+            vertex[2] = mesh->mVertices[i].z;
+
+            // missing attributes are zero filled so every vertex follows the Mesh layout
+            vertex[3] = hasNormals ? mesh->mNormals[i].x : 0.0f;
+            vertex[4] = hasNormals ? mesh->mNormals[i].y : 0.0f;
+            vertex[5] = hasNormals ? mesh->mNormals[i].z : 0.0f;
 
-            if (mesh->HasNormals())
-                vertices.insert(vertices.end(), { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z });
-            if (mesh->mTextureCoords[0] != nullptr)
-                vertices.insert(vertices.end(), { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y });
+            vertex[6] = textureCoordinates != nullptr ? textureCoordinates[i].x : 0.0f;
+            vertex[7] = textureCoordinates != nullptr ? textureCoordinates[i].y : 0.0f;
         }
 
-        // Retrieve mesh indices
+        // Retrieve mesh indices, triangulated on import so three per face
+        indices.reserve(static_cast<std::size_t>(mesh->mNumFaces) * 3);
         for(std::size_t i{}; i < mesh->mNumFaces; i++) {
-            auto face{ mesh->mFaces[i] };
-
-            for(std::size_t index{}; index < face.mNumIndices; index++)
-                indices.push_back(face.mIndices[index]);
+            const auto& face{ mesh->mFaces[i] };
+            indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
         }
 
-        // process material
+        return MeshData{ std::move(vertices), std::move(indices), {}, processMaterial(mesh, scene, directory, embedded) };
+    }
+
+    auto Model::processMaterial(const aiMesh* mesh, const aiScene* scene, const std::filesystem::path& directory,
+                                std::span<const TextureRef> embedded) -> std::vector<TextureRef> {
+        std::vector<TextureRef> textures{};
+
         if(mesh->mMaterialIndex >= 0) {
             auto material { scene->mMaterials[mesh->mMaterialIndex] };
 
-            auto diffuseMaps { loadMaterialTextures(material, aiTextureType_DIFFUSE, kT::Texture::TextureType::DIFFUSE, scene) };
-            auto specularMaps { loadMaterialTextures(material, aiTextureType_SPECULAR, kT::Texture::TextureType::SPECULAR, scene) };
-            auto normalMaps { loadMaterialTextures(material, aiTextureType_NORMALS, kT::Texture::TextureType::NORMAL, scene) };
+            auto diffuseMaps { loadMaterialTextures(material, aiTextureType_DIFFUSE, kT::Texture::TextureType::DIFFUSE, scene, directory, embedded) };
+            auto specularMaps { loadMaterialTextures(material, aiTextureType_SPECULAR, kT::Texture::TextureType::SPECULAR, scene, directory, embedded) };
+            auto normalMaps { loadMaterialTextures(material, aiTextureType_NORMALS, kT::Texture::TextureType::NORMAL, scene, directory, embedded) };
 
             for (auto& item : diffuseMaps)
                 textures.push_back(std::move(item));
@@ -91,32 +840,93 @@ namespace kT {
                 textures.push_back(std::move(item));
         }
 
-        return Mesh{ vertices, indices, std::move(textures) };
+        return textures;
     }
 
-    auto Model::loadMaterialTextures(aiMaterial *mat, aiTextureType type, kT::Texture::TextureType tType, const aiScene* scene) -> std::vector<kT::Texture> {
-        std::vector<kT::Texture> textures{};
+    auto Model::loadMaterialTextures(aiMaterial *mat, aiTextureType type, kT::Texture::TextureType tType, const aiScene* scene,
+                                     const std::filesystem::path& directory, std::span<const TextureRef> embedded) -> std::vector<TextureRef> {
+        std::vector<TextureRef> textures{};
         for(std::uint32_t i{}; i < mat->GetTextureCount(type); i++) {
             aiString str{};
-            if (mat->GetTexture(type, i, &str) == AI_SUCCESS)
-                // TODO: str might not be the name of a texture and instead hold the texture index. Right we assume textures are in same directory as the model
-                textures.push_back(kT::Texture::fromFile(m_ModelPath.string() + '/' + str.C_Str(), tType));
+            if (mat->GetTexture(type, i, &str) != AI_SUCCESS)
+                continue;
+
+            // resolves both "*N" indices and file names of images stored in the scene
+            if (const aiTexture* texture{ scene->GetEmbeddedTexture(str.C_Str()) }) {
+                const auto index{ static_cast<std::size_t>(std::find(scene->mTextures, scene->mTextures + scene->mNumTextures, texture) - scene->mTextures) };
+                if (index < embedded.size() && embedded[index].embedded) {
+                    TextureRef& ref{ textures.emplace_back(embedded[index]) };
+                    ref.type = tType;
+                    continue;
+                }
+            }
+
+            textures.push_back(TextureRef{ directory / str.C_Str(), tType });
         }
 
         return textures;
     }
 
+    auto Model::loadEmbeddedTexture(const aiTexture* texture, const std::filesystem::path& path, std::size_t index) -> TextureRef {
+        // named after the model so the texture cache tells them apart, like the images kT::GltfLoader embeds
+        std::filesystem::path name{ path };
+        name += "*" + std::to_string(index);
+
+        if (texture == nullptr || texture->pcData == nullptr || texture->mWidth == 0)
+            return TextureRef{ name };
+
+        const auto* data{ reinterpret_cast<const std::byte*>(texture->pcData) };
+
+        // a zero height means pcData holds a whole image file mWidth bytes long
+        if (texture->mHeight == 0)
+            return TextureRef{ name, {}, std::make_shared<const std::vector<std::byte>>(data, data + texture->mWidth) };
+
+        const std::size_t width{ texture->mWidth };
+        const std::size_t height{ texture->mHeight };
+        auto texels{ std::make_shared<std::vector<std::byte>>(width * height * 4) };
+
+        // aiTexel is BGRA with the top row first, image files are flipped on decode so the bottom row goes first here as well
+        for (std::size_t row{}; row < height; row++) {
+            const aiTexel* source{ texture->pcData + (height - 1 - row) * width };
+            std::byte* destination{ texels->data() + row * width * 4 };
+
+            for (std::size_t x{}; x < width; x++) {
+                destination[x * 4 + 0] = static_cast<std::byte>(source[x].r);
+                destination[x * 4 + 1] = static_cast<std::byte>(source[x].g);
+                destination[x * 4 + 2] = static_cast<std::byte>(source[x].b);
+                destination[x * 4 + 3] = static_cast<std::byte>(source[x].a);
+            }
+        }
+
+        return TextureRef{ name, {}, std::move(texels), { static_cast<std::int32_t>(width), static_cast<std::int32_t>(height) } };
+    }
+
     Model::Model(Model &&other) noexcept
-        :   m_Meshes{ std::move(other.m_Meshes) }, m_ModelPath{ std::move(other.m_ModelPath) }
+        :   m_Meshes{ std::move(other.m_Meshes) }, m_Instances{ std::move(other.m_Instances) }, m_Scene{ std::move(other.m_Scene) },
+            m_ModelPath{ std::move(other.m_ModelPath) }, m_Geometry{ std::move(other.m_Geometry) }
     {}
 
     auto Model::operator=(Model&& other) noexcept -> Model& {
         m_Meshes = std::move(other.m_Meshes);
+        m_Instances = std::move(other.m_Instances);
+        m_Scene = std::move(other.m_Scene);
         m_ModelPath = std::move(other.m_ModelPath);
+        m_Geometry = std::move(other.m_Geometry);
 
         return *this;
     }
 
+    auto Model::updateTransforms() -> void {
+        // nothing moved, which is the common case
+        if (m_Scene.update() == 0)
+            return;
+
+        for (auto& instance : m_Instances) {
+            if (m_Scene.wasUpdated(instance.node))
+                instance.transform = m_Scene.getWorldTransform(instance.node);
+        }
+    }
+
     auto Model::getVertexCount() const -> std::size_t {
         std::size_t total{ 0 };
 
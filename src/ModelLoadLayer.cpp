@@ -9,21 +9,42 @@
 #include "OpenGL/Shader.hh"
 #include "Core/Logger.hh"
 #include "Core/ModelLoadLayer.hh"
+#include "OpenGL/TextureCache.hh"
+#include "OpenGL/GeometryArena.hh"
+#include "OpenGL/TextureStreamer.hh"
+#include "OpenGL/TextureUploader.hh"
 #include <OpenGL/Renderer.hh>
 
 
 namespace kT {
     auto ModelLoader::OnAttach(std::shared_ptr<Window> handle) -> void {
         m_Camera = std::make_shared<Camera>();
-        m_Model = std::make_shared<Model>();
         m_DefaultShader = std::make_shared<Shader>();
 
         m_Camera->Init(*handle);
         m_DefaultShader->LoadFromFile("../assets/shaders/defaultVertex.glsl", "../assets/shaders/defaultFragment.glsl");
-        m_Model->LoadFromFile("../assets/models/Pod42/source/POD/POD.obj");
+
+        loadModel("../assets/models/Pod42/source/POD/POD.obj");
         m_ClearColor = { 1.0, 1.0, 1.0, 1.0 };
     }
 
+    auto ModelLoader::OnDetach() -> void {
+        m_ModelLoad.reset();
+        m_Model.reset();
+
+        // the cache keeps every texture alive until told the models using it are gone
+        TextureCache::Purge();
+    }
+
+    auto ModelLoader::loadModel(const std::filesystem::path& path) -> void {
+        // The model is drawn as its meshes get uploaded, see AsyncModelLoader::Update()
+        m_ModelLoad = AsyncModelLoader::Load(path);
+        m_Model = m_ModelLoad->getModel();
+
+        // textures of the replaced model are released unless another model still uses them
+        TextureCache::Purge();
+    }
+
     auto ModelLoader::OnUpdate(std::shared_ptr<Window> handle) -> void {
         m_DefaultShader->setUniformVec3("light.ambient", glm::vec3(0.2f, 0.2f, 0.2f));
         m_DefaultShader->setUniformVec3("light.diffuse", glm::vec3(0.5f, 0.5f, 0.5f));
@@ -61,7 +82,8 @@ namespace kT {
 
         // DRAWING
         Renderer::ClearColor(m_ClearColor);
-        Renderer::DrawModel(*m_DefaultShader, *m_Model);
+        Renderer::ResetStats();
+        Renderer::DrawModel(*m_DefaultShader, *m_Model, *m_Camera, model);
     }
 
     auto ModelLoader::OnImGuiRender() -> void {
@@ -77,6 +99,24 @@ namespace kT {
         ImGui::Text("Light block Settings");
         ImGui::DragFloat3("Position", glm::value_ptr(m_LightPosition), 0.1f, -100.0f, 100.0f);
         ImGui::Checkbox("Enable wireframe", &m_Lines);
+
+        ImGui::Text("Level of detail Settings");
+        float lodPixelError{ Renderer::GetLodPixelError() };
+        if (ImGui::SliderFloat("LOD error (px)", &lodPixelError, 0.0f, 16.0f))
+            Renderer::SetLodPixelError(lodPixelError);
+
+        float cullPixelSize{ Renderer::GetCullPixelSize() };
+        if (ImGui::SliderFloat("Cull size (px)", &cullPixelSize, 0.0f, 16.0f))
+            Renderer::SetCullPixelSize(cullPixelSize);
+
+        bool meshletCulling{ Renderer::GetMeshletCulling() };
+        if (ImGui::Checkbox("Meshlet culling", &meshletCulling))
+            Renderer::SetMeshletCulling(meshletCulling);
+
+        ImGui::Text("Texture streaming Settings");
+        int textureBudget{ static_cast<int>(TextureStreamer::GetBudget() >> 20) };
+        if (ImGui::SliderInt("VRAM budget (MB)", &textureBudget, 16, 4096))
+            TextureStreamer::SetBudget(static_cast<std::size_t>(textureBudget) << 20);
         ImGui::End();
 
         static constexpr int HOURS_TO_SECS{ 3600 };
@@ -97,9 +137,49 @@ namespace kT {
 
         ImGui::Begin("Inspection");
         ImGui::Text("Model: 1"); // Just one model loaded at a time currently
+        if (m_ModelLoad->getState() == ModelLoadHandle::State::FAILED)
+            ImGui::Text("Load failed: %s", m_ModelLoad->getError().c_str());
+        else if (!m_ModelLoad->isDone())
+            ImGui::ProgressBar(m_ModelLoad->getProgress(), ImVec2(-1.0f, 0.0f), ModelLoadHandle::getStrState(m_ModelLoad->getState()).data());
+
         ImGui::Text("Vertices: %lx", m_Model->getVertexCount());
         ImGui::Text("Indices: %lx", m_Model->getIndexCount());
         ImGui::Text("Textures: %lx", m_Model->getTextureCount());
+        ImGui::Text("Scene nodes: %zu, mesh instances: %zu", m_Model->getScene().getSize(), m_Model->getInstances().size());
+
+        const auto& cacheStats{ TextureCache::GetStats() };
+        ImGui::Text("Texture cache: %zu hits, %zu misses", cacheStats.hits, cacheStats.misses);
+        ImGui::Text("Texture cache saved: %.2f MB", static_cast<double>(cacheStats.bytesSaved) / (1024.0 * 1024.0));
+
+        const auto& streamStats{ TextureStreamer::GetStats() };
+        const double textureBudgetMb{ static_cast<double>(TextureStreamer::GetBudget()) / (1024.0 * 1024.0) };
+        ImGui::Text("Streamed textures: %zu, %zu fully resident", streamStats.textures, streamStats.fullyResident);
+        ImGui::Text("Texture residency: %.2f / %.2f MB, %.2f MB requested", static_cast<double>(streamStats.residentBytes) / (1024.0 * 1024.0),
+                    textureBudgetMb, static_cast<double>(streamStats.requestedBytes) / (1024.0 * 1024.0));
+        ImGui::ProgressBar(static_cast<float>(static_cast<double>(streamStats.requestedBytes) / (1024.0 * 1024.0) / textureBudgetMb),
+                           ImVec2(-1.0f, 0.0f), "Budget pressure");
+        ImGui::Text("Mip levels: %zu raised, %zu evicted, %zu raises deferred", streamStats.raisedLevels, streamStats.evictedLevels,
+                    streamStats.deferredRaises);
+
+        const auto uploadStats{ TextureUploader::GetStats() };
+        ImGui::Text("Texture uploads: %zu pending, %.2f MB left", uploadStats.pendingTextures, static_cast<double>(uploadStats.pendingBytes) / (1024.0 * 1024.0));
+        ImGui::Text("Texture uploaded: %.2f MB, %zu frames waited on the GPU", static_cast<double>(uploadStats.uploadedBytes) / (1024.0 * 1024.0), uploadStats.stalledFrames);
+
+        const auto arenaStats{ GeometryArena::GetStats() };
+        ImGui::Text("Geometry arena: %zu blocks, %zu allocations", arenaStats.blocks, arenaStats.allocations);
+        ImGui::Text("Arena vertices: %.2f / %.2f MB, %.1f%% fragmented", static_cast<double>(arenaStats.vertexBytesUsed) / (1024.0 * 1024.0),
+                    static_cast<double>(arenaStats.vertexBytesCapacity) / (1024.0 * 1024.0), arenaStats.vertexFragmentation * 100.0f);
+        ImGui::Text("Arena indices: %.2f / %.2f MB, %.1f%% fragmented", static_cast<double>(arenaStats.indexBytesUsed) / (1024.0 * 1024.0),
+                    static_cast<double>(arenaStats.indexBytesCapacity) / (1024.0 * 1024.0), arenaStats.indexFragmentation * 100.0f);
+        const auto& drawStats{ Renderer::GetStats() };
+        ImGui::Text("Meshes: %zu drawn, %zu culled", drawStats.meshesDrawn, drawStats.meshesCulled);
+        ImGui::Text("Draw calls: %zu, %zu instances batched", drawStats.drawCalls, drawStats.instancesBatched);
+        ImGui::Text("Triangles: %zu submitted of %zu at full detail", drawStats.trianglesDrawn, drawStats.trianglesFullDetail);
+        ImGui::Text("Meshlets: %zu drawn, %zu off screen, %zu facing away", drawStats.meshletsDrawn,
+                    drawStats.meshletsFrustumCulled, drawStats.meshletsBackfaceCulled);
+        ImGui::Text("Triangles culled by meshlets: %zu", drawStats.trianglesClusterCulled);
+        ImGui::Text("Meshes per LOD: %zu / %zu / %zu / %zu", drawStats.meshesPerLod[0], drawStats.meshesPerLod[1],
+                    drawStats.meshesPerLod[2], drawStats.meshesPerLod[3]);
         ImGui::Text("Frame Rate: %.1f FPS)", ImGui::GetIO().Framerate);
 
         auto sTime = static_cast<int>(glfwGetTime());
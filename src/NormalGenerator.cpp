@@ -0,0 +1,78 @@
+// C++ Standard Library
+#include <array>
+#include <cstring>
+#include <unordered_map>
+
+// Project Libraries
+#include "Core/Hash.hh"
+#include "OpenGL/Mesh.hh"
+#include "OpenGL/NormalGenerator.hh"
+
+namespace kT {
+    namespace {
+        // positions are matched bit for bit, which is what vertex welding on import does as well
+        struct PositionKey {
+            std::array<float, 3> position{};
+
+            auto operator==(const PositionKey& other) const -> bool {
+                return std::memcmp(position.data(), other.position.data(), sizeof(position)) == 0;
+            }
+        };
+
+        struct PositionKeyHash {
+            auto operator()(const PositionKey& key) const -> std::size_t {
+                return static_cast<std::size_t>(hashBytes(std::as_bytes(std::span{ key.position })));
+            }
+        };
+    }
+
+    auto NormalGenerator::GenerateSmooth(MeshData& mesh) -> void {
+        const std::size_t floatsPerVertex{ Mesh::GetLayout().getStride() / sizeof(float) };
+        const std::size_t vertexCount{ mesh.vertices.size() / floatsPerVertex };
+
+        auto position{ [&mesh, floatsPerVertex](std::size_t vertex) -> glm::vec3 {
+            const float* data{ mesh.vertices.data() + vertex * floatsPerVertex };
+            return glm::vec3(data[0], data[1], data[2]);
+        } };
+
+        // every vertex points to the sum of the position it is at
+        std::unordered_map<PositionKey, std::uint32_t, PositionKeyHash> positions{};
+        std::vector<std::uint32_t> positionOf(vertexCount);
+        positions.reserve(vertexCount);
+
+        for (std::size_t vertex{}; vertex < vertexCount; vertex++) {
+            const float* data{ mesh.vertices.data() + vertex * floatsPerVertex };
+            const PositionKey key{ { data[0], data[1], data[2] } };
+            positionOf[vertex] = positions.try_emplace(key, static_cast<std::uint32_t>(positions.size())).first->second;
+        }
+
+        // the cross product is twice the triangle area long, so big triangles weigh more
+        std::vector<glm::vec3> sums(positions.size(), glm::vec3(0.0f));
+        for (std::size_t i{}; i + 2 < mesh.indices.size(); i += 3) {
+            const std::uint32_t a{ mesh.indices[i] };
+            const std::uint32_t b{ mesh.indices[i + 1] };
+            const std::uint32_t c{ mesh.indices[i + 2] };
+
+            if (a >= vertexCount || b >= vertexCount || c >= vertexCount)
+                continue;
+
+            const glm::vec3 p0{ position(a) };
+            const glm::vec3 normal{ glm::cross(position(b) - p0, position(c) - p0) };
+
+            sums[positionOf[a]] += normal;
+            sums[positionOf[b]] += normal;
+            sums[positionOf[c]] += normal;
+        }
+
+        for (std::size_t vertex{}; vertex < vertexCount; vertex++) {
+            const glm::vec3 sum{ sums[positionOf[vertex]] };
+            const float length{ glm::length(sum) };
+            const glm::vec3 normal{ length > 0.0f ? sum / length : glm::vec3(0.0f) };
+
+            float* data{ mesh.vertices.data() + vertex * floatsPerVertex };
+            data[3] = normal.x;
+            data[4] = normal.y;
+            data[5] = normal.z;
+        }
+    }
+}
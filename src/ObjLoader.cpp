@@ -0,0 +1,489 @@
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+// Project Libraries
+#include "Core/Hash.hh"
+#include "Core/Logger.hh"
+#include "Core/MappedFile.hh"
+#include "Core/ThreadPool.hh"
+#include "OpenGL/NormalGenerator.hh"
+#include "OpenGL/ObjLoader.hh"
+
+namespace kT {
+    namespace {
+        // indices into the attributes of the whole file, -1 if the corner does not have the attribute
+        struct Corner {
+            std::int64_t position{ -1 };
+            std::int64_t texCoord{ -1 };
+            std::int64_t normal{ -1 };
+
+            auto operator==(const Corner& other) const -> bool = default;
+        };
+
+        struct CornerHash {
+            auto operator()(const Corner& corner) const -> std::size_t {
+                return static_cast<std::size_t>(hashBytes(std::as_bytes(std::span{ &corner, 1 })));
+            }
+        };
+
+        enum class MarkerType { GROUP, MATERIAL, LIBRARY };
+
+        // statement changing the mesh the next triangles go into, names point into the mapped file
+        struct Marker {
+            std::size_t         triangle{};
+            MarkerType          type{};
+            std::string_view    name{};
+        };
+
+        // one slice of the file parsed on its own, indices are fixed up once every chunk is done
+        struct Chunk {
+            std::string_view            text{};
+            std::vector<float>          positions{};
+            std::vector<float>          texCoords{};
+            std::vector<float>          normals{};
+            std::vector<Corner>         corners{};      // three per triangle
+            std::vector<std::size_t>    relative{};     // corner * 3 + attribute of the indices relative to this chunk
+            std::vector<Marker>         markers{};
+        };
+
+        // consecutive triangles of one chunk
+        struct TriangleRange {
+            std::size_t chunk{};
+            std::size_t first{};
+            std::size_t count{};
+        };
+
+        struct Segment {
+            std::string_view            material{};
+            std::vector<TriangleRange>  ranges{};
+        };
+
+        struct Material {
+            std::vector<TextureRef> diffuse{};
+            std::vector<TextureRef> specular{};
+            std::vector<TextureRef> normal{};
+        };
+
+        auto isSpace(char c) -> bool {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        auto trim(std::string_view text) -> std::string_view {
+            while (!text.empty() && isSpace(text.front()))
+                text.remove_prefix(1);
+            while (!text.empty() && isSpace(text.back()))
+                text.remove_suffix(1);
+            return text;
+        }
+
+        auto nextLine(std::string_view& text) -> std::string_view {
+            const std::size_t end{ text.find('\n') };
+            const std::string_view line{ text.substr(0, end) };
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+            return line;
+        }
+
+        auto nextToken(std::string_view& text) -> std::string_view {
+            text = trim(text);
+            std::size_t end{};
+            while (end < text.size() && !isSpace(text[end]))
+                ++end;
+
+            const std::string_view token{ text.substr(0, end) };
+            text.remove_prefix(end);
+            return token;
+        }
+
+        auto parseFloat(std::string_view token) -> float {
+            if (!token.empty() && token.front() == '+')
+                token.remove_prefix(1);
+
+            float value{};
+            const auto [end, error] { std::from_chars(token.data(), token.data() + token.size(), value) };
+            if (error != std::errc{} || token.empty())
+                throw std::runtime_error("Malformed number in OBJ file: " + std::string{ token });
+
+            return value;
+        }
+
+        auto isNumber(std::string_view token) -> bool {
+            float value{};
+            return !token.empty() && std::from_chars(token.data(), token.data() + token.size(), value).ec == std::errc{};
+        }
+
+        // reads count floats, missing trailing ones are zero and extra ones (w, vertex colors) ignored
+        auto parseFloats(std::string_view text, std::size_t required, std::size_t count, std::vector<float>& out) -> void {
+            for (std::size_t i{}; i < count; i++) {
+                const std::string_view token{ nextToken(text) };
+                if (token.empty() && i >= required)
+                    out.push_back(0.0f);
+                else
+                    out.push_back(parseFloat(token));
+            }
+        }
+
+        // corner of a polygon before triangulation, relative has a bit set for every index counted from the end of the chunk
+        struct PolygonCorner {
+            Corner          corner{};
+            std::uint8_t    relative{};
+        };
+
+        // resolves one index of a face corner, OBJ indices are one based and negative ones count back from the last element
+        auto parseIndex(std::string_view token, std::size_t count, std::uint8_t bit, PolygonCorner& corner) -> std::int64_t {
+            std::int64_t index{};
+            const auto [end, error] { std::from_chars(token.data(), token.data() + token.size(), index) };
+            if (error != std::errc{} || end != token.data() + token.size() || index == 0)
+                throw std::runtime_error("Malformed face index in OBJ file: " + std::string{ token });
+
+            if (index > 0)
+                return index - 1;
+
+            // only the attributes of this chunk are known here, the ones before it are added once every chunk is parsed
+            corner.relative |= bit;
+            return static_cast<std::int64_t>(count) + index;
+        }
+
+        auto parseFace(std::string_view text, Chunk& chunk, std::vector<PolygonCorner>& polygon) -> void {
+            polygon.clear();
+
+            for (std::string_view token{ nextToken(text) }; !token.empty(); token = nextToken(text)) {
+                std::array<std::string_view, 3> parts{};
+                for (std::size_t part{}; part < parts.size() && !token.empty(); part++) {
+                    const std::size_t slash{ token.find('/') };
+                    parts[part] = token.substr(0, slash);
+                    token.remove_prefix(slash == std::string_view::npos ? token.size() : slash + 1);
+                }
+
+                PolygonCorner& corner{ polygon.emplace_back() };
+                corner.corner.position = parseIndex(parts[0], chunk.positions.size() / 3, 1, corner);
+                if (!parts[1].empty())
+                    corner.corner.texCoord = parseIndex(parts[1], chunk.texCoords.size() / 2, 2, corner);
+                if (!parts[2].empty())
+                    corner.corner.normal = parseIndex(parts[2], chunk.normals.size() / 3, 4, corner);
+            }
+
+            auto emit{ [&chunk](const PolygonCorner& corner) -> void {
+                for (std::size_t attribute{}; attribute < 3; attribute++) {
+                    if (corner.relative & (1u << attribute))
+                        chunk.relative.push_back(chunk.corners.size() * 3 + attribute);
+                }
+
+                chunk.corners.push_back(corner.corner);
+            } };
+
+            // fan triangulation, polygons in OBJ files are convex in practice. Points and lines are not drawn
+            for (std::size_t i{ 2 }; i < polygon.size(); i++) {
+                emit(polygon[0]);
+                emit(polygon[i - 1]);
+                emit(polygon[i]);
+            }
+        }
+
+        auto parseChunk(Chunk& chunk) -> void {
+            std::string_view text{ chunk.text };
+            std::vector<PolygonCorner> polygon{};
+
+            // roughly a line per element, reserving avoids most of the regrowth on big files
+            chunk.positions.reserve(text.size() / 24);
+            chunk.corners.reserve(text.size() / 12);
+
+            while (!text.empty()) {
+                std::string_view line{ nextLine(text) };
+                const std::string_view keyword{ nextToken(line) };
+
+                if (keyword == "v")
+                    parseFloats(line, 3, 3, chunk.positions);
+                else if (keyword == "vt")
+                    parseFloats(line, 1, 2, chunk.texCoords);
+                else if (keyword == "vn")
+                    parseFloats(line, 3, 3, chunk.normals);
+                else if (keyword == "f")
+                    parseFace(line, chunk, polygon);
+                else if (keyword == "o" || keyword == "g")
+                    chunk.markers.push_back({ chunk.corners.size() / 3, MarkerType::GROUP, trim(line) });
+                else if (keyword == "usemtl")
+                    chunk.markers.push_back({ chunk.corners.size() / 3, MarkerType::MATERIAL, trim(line) });
+                else if (keyword == "mtllib")
+                    chunk.markers.push_back({ chunk.corners.size() / 3, MarkerType::LIBRARY, trim(line) });
+            }
+        }
+
+        // the file name is what is left once the options in front of it are skipped, it may contain spaces
+        auto parseTexturePath(std::string_view text) -> std::string_view {
+            text = trim(text);
+            while (!text.empty() && text.front() == '-') {
+                std::string_view rest{ text };
+                nextToken(rest);
+
+                for (std::string_view peek{ rest }, token{ nextToken(peek) }; isNumber(token) || token == "on" || token == "off"; token = nextToken(peek))
+                    rest = peek;
+
+                text = trim(rest);
+            }
+
+            return text;
+        }
+
+        auto loadMaterials(const std::filesystem::path& path, const std::filesystem::path& directory,
+                           std::unordered_map<std::string, Material>& materials) -> void {
+            if (!std::filesystem::is_regular_file(path)) {
+                KATE_LOGGER_WARN("Material library {} not found, its materials have no textures", path.string());
+                return;
+            }
+
+            const MappedFile file{ path };
+            std::string_view text{ reinterpret_cast<const char*>(file.getData().data()), file.getSize() };
+            Material* material{};
+
+            while (!text.empty()) {
+                std::string_view line{ nextLine(text) };
+                const std::string_view keyword{ nextToken(line) };
+
+                if (keyword == "newmtl") {
+                    material = &materials[std::string{ trim(line) }];
+                    continue;
+                }
+
+                if (material == nullptr)
+                    continue;
+
+                // same mapping as the assimp importer, bump maps are height maps and not normal maps
+                std::vector<TextureRef>* textures{};
+                Texture::TextureType type{};
+
+                if (keyword == "map_Kd") {
+                    textures = &material->diffuse;
+                    type = Texture::TextureType::DIFFUSE;
+                }
+                else if (keyword == "map_Ks") {
+                    textures = &material->specular;
+                    type = Texture::TextureType::SPECULAR;
+                }
+                else if (keyword == "norm") {
+                    textures = &material->normal;
+                    type = Texture::TextureType::NORMAL;
+                }
+
+                const std::string_view texture{ parseTexturePath(line) };
+                if (textures != nullptr && !texture.empty())
+                    textures->push_back(TextureRef{ directory / texture, type });
+            }
+        }
+
+        auto buildMesh(const Segment& segment, const std::vector<Chunk>& chunks, std::span<const float> positions,
+                       std::span<const float> texCoords, std::span<const float> normals, const Material* material) -> MeshData {
+            constexpr std::size_t floatsPerVertex{ 8 };
+
+            std::size_t triangles{};
+            bool hasNormals{};
+            for (const auto& range : segment.ranges) {
+                triangles += range.count;
+
+                const auto& corners{ chunks[range.chunk].corners };
+                hasNormals = hasNormals || std::any_of(corners.begin() + range.first * 3, corners.begin() + (range.first + range.count) * 3,
+                                                       [](const Corner& corner) -> bool { return corner.normal >= 0; });
+            }
+
+            MeshData mesh{};
+            mesh.indices.reserve(triangles * 3);
+            mesh.vertices.reserve(triangles * floatsPerVertex);
+
+            std::unordered_map<Corner, std::uint32_t, CornerHash> welded{};
+            welded.reserve(triangles);
+
+            std::uint32_t vertexCount{};
+
+            for (const auto& range : segment.ranges) {
+                const auto& corners{ chunks[range.chunk].corners };
+
+                for (std::size_t i{ range.first * 3 }; i < (range.first + range.count) * 3; i++) {
+                    const Corner& corner{ corners[i] };
+                    const auto [it, inserted] { welded.try_emplace(corner, vertexCount) };
+                    mesh.indices.push_back(it->second);
+
+                    if (!inserted)
+                        continue;
+
+                    ++vertexCount;
+
+                    const float* position{ positions.data() + corner.position * 3 };
+                    mesh.vertices.insert(mesh.vertices.end(), position, position + 3);
+
+                    if (corner.normal >= 0) {
+                        const float* normal{ normals.data() + corner.normal * 3 };
+                        mesh.vertices.insert(mesh.vertices.end(), normal, normal + 3);
+                    }
+                    else {
+                        mesh.vertices.insert(mesh.vertices.end(), 3, 0.0f);
+                    }
+
+                    // flipped like aiProcess_FlipUVs does, OBJ puts the origin at the bottom left
+                    if (corner.texCoord >= 0) {
+                        mesh.vertices.push_back(texCoords[corner.texCoord * 2]);
+                        mesh.vertices.push_back(1.0f - texCoords[corner.texCoord * 2 + 1]);
+                    }
+                    else {
+                        mesh.vertices.insert(mesh.vertices.end(), 2, 0.0f);
+                    }
+                }
+            }
+
+            if (!hasNormals)
+                NormalGenerator::GenerateSmooth(mesh);
+
+            // same order as kT::Model::processMesh()
+            if (material != nullptr) {
+                mesh.textures.insert(mesh.textures.end(), material->diffuse.begin(), material->diffuse.end());
+                mesh.textures.insert(mesh.textures.end(), material->specular.begin(), material->specular.end());
+                mesh.textures.insert(mesh.textures.end(), material->normal.begin(), material->normal.end());
+            }
+
+            return mesh;
+        }
+    }
+
+    auto ObjLoader::Load(const std::filesystem::path& path) -> std::vector<MeshData> {
+        const MappedFile file{ path };
+        const std::string_view text{ reinterpret_cast<const char*>(file.getData().data()), file.getSize() };
+        const std::filesystem::path directory{ path.parent_path() };
+
+        // chunks end right after a line break, so every line is parsed by exactly one of them
+        auto& pool{ ThreadPool::Get() };
+        const std::size_t chunkCount{ std::clamp<std::size_t>(text.size() / s_MinChunkSize, 1, pool.getThreadCount() + 1) };
+
+        std::vector<Chunk> chunks(chunkCount);
+        std::size_t begin{};
+        for (std::size_t i{}; i < chunkCount; i++) {
+            std::size_t end{ i + 1 == chunkCount ? text.size() : std::max(begin, (i + 1) * text.size() / chunkCount) };
+            end = std::min(text.find('\n', end), text.size());
+            end = end == text.size() ? end : end + 1;
+
+            chunks[i].text = text.substr(begin, end - begin);
+            begin = end;
+        }
+
+        pool.parallelFor(chunks.size(), [&chunks](std::size_t i) -> void { parseChunk(chunks[i]); });
+
+        // attributes of the whole file, each chunk starts where the previous one ended
+        std::vector<std::array<std::size_t, 3>> bases(chunks.size());
+        std::array<std::size_t, 3> totals{};
+        for (std::size_t i{}; i < chunks.size(); i++) {
+            bases[i] = totals;
+            totals[0] += chunks[i].positions.size() / 3;
+            totals[1] += chunks[i].texCoords.size() / 2;
+            totals[2] += chunks[i].normals.size() / 3;
+        }
+
+        std::vector<float> positions(totals[0] * 3);
+        std::vector<float> texCoords(totals[1] * 2);
+        std::vector<float> normals(totals[2] * 3);
+
+        pool.parallelFor(chunks.size(), [&](std::size_t i) -> void {
+            auto& chunk{ chunks[i] };
+            std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + static_cast<std::ptrdiff_t>(bases[i][0] * 3));
+            std::copy(chunk.texCoords.begin(), chunk.texCoords.end(), texCoords.begin() + static_cast<std::ptrdiff_t>(bases[i][1] * 2));
+            std::copy(chunk.normals.begin(), chunk.normals.end(), normals.begin() + static_cast<std::ptrdiff_t>(bases[i][2] * 3));
+
+            chunk.positions = {};
+            chunk.texCoords = {};
+            chunk.normals = {};
+
+            for (const auto slot : chunk.relative) {
+                Corner& corner{ chunk.corners[slot / 3] };
+                std::int64_t& index{ slot % 3 == 0 ? corner.position : slot % 3 == 1 ? corner.texCoord : corner.normal };
+                index += static_cast<std::int64_t>(bases[i][slot % 3]);
+            }
+
+            for (const auto& corner : chunk.corners) {
+                if (corner.position < 0 || corner.position >= static_cast<std::int64_t>(totals[0]) ||
+                    corner.texCoord >= static_cast<std::int64_t>(totals[1]) || corner.normal >= static_cast<std::int64_t>(totals[2]) ||
+                    (corner.texCoord < -1 || corner.normal < -1))
+                    throw std::runtime_error("OBJ file " + path.string() + " references missing vertex data");
+            }
+        });
+
+        // meshes break where the object, group or material changes, like in the assimp importer
+        std::vector<Segment> segments(1);
+        std::vector<std::string_view> libraries{};
+        std::string_view currentMaterial{};
+
+        for (std::size_t c{}; c < chunks.size(); c++) {
+            std::size_t assigned{};
+            auto assign{ [&](std::size_t end) -> void {
+                if (end > assigned)
+                    segments.back().ranges.push_back({ c, assigned, end - assigned });
+                assigned = end;
+            } };
+
+            for (const auto& marker : chunks[c].markers) {
+                assign(marker.triangle);
+
+                if (marker.type == MarkerType::LIBRARY) {
+                    libraries.push_back(marker.name);
+                    continue;
+                }
+
+                if (!segments.back().ranges.empty())
+                    segments.emplace_back();
+
+                if (marker.type == MarkerType::MATERIAL)
+                    currentMaterial = marker.name;
+
+                segments.back().material = currentMaterial;
+            }
+
+            assign(chunks[c].corners.size() / 3);
+        }
+
+        std::erase_if(segments, [](const Segment& segment) -> bool { return segment.ranges.empty(); });
+
+        std::unordered_map<std::string, Material> materials{};
+        std::unordered_set<std::string_view> loaded{};
+        for (const auto& library : libraries) {
+            if (loaded.insert(library).second)
+                loadMaterials(directory / library, directory, materials);
+        }
+
+        std::vector<MeshData> meshes(segments.size());
+        pool.parallelFor(segments.size(), [&](std::size_t i) -> void {
+            const auto material{ materials.find(std::string{ segments[i].material }) };
+            meshes[i] = buildMesh(segments[i], chunks, positions, texCoords, normals, material != materials.end() ? &material->second : nullptr);
+        });
+
+        KATE_LOGGER_DEBUG("Parsed {} in {} chunks: {} positions, {} meshes", path.string(), chunks.size(), totals[0], meshes.size());
+        return meshes;
+    }
+
+    auto ObjLoader::GetDependencies(const std::filesystem::path& path) -> std::vector<std::filesystem::path> {
+        const MappedFile file{ path };
+        std::string_view text{ reinterpret_cast<const char*>(file.getData().data()), file.getSize() };
+
+        std::vector<std::filesystem::path> libraries{};
+        while (!text.empty()) {
+            std::string_view line{ nextLine(text) };
+            if (nextToken(line) != "mtllib")
+                continue;
+
+            std::filesystem::path library{ path.parent_path() / trim(line) };
+            if (std::find(libraries.begin(), libraries.end(), library) == libraries.end())
+                libraries.push_back(std::move(library));
+        }
+
+        return libraries;
+    }
+
+    auto ObjLoader::IsSupported(const std::filesystem::path& path) -> bool {
+        std::string extension{ path.extension().string() };
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) -> char { return static_cast<char>(std::tolower(c)); });
+        return extension == ".obj";
+    }
+}
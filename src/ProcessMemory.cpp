@@ -0,0 +1,121 @@
+// Platform Libraries
+#if defined(_WIN64) || defined(WIN32)
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(__APPLE__)
+    #include <mach/mach.h>
+    #include <sys/resource.h>
+#else
+    #include <algorithm>
+    #include <atomic>
+    #include <cstdio>
+    #include <cstring>
+    #include <sys/resource.h>
+    #include <unistd.h>
+#endif
+
+// Project Libraries
+#include "Core/ProcessMemory.hh"
+
+namespace kT {
+    namespace {
+#if !defined(_WIN64) && !defined(WIN32) && !defined(__APPLE__)
+        // clear_refs restarts ru_maxrss as well, so the largest peak cleared is kept for kT::getPeakResidentBytes()
+        std::atomic<std::size_t> s_PeakBeforeReset{};
+
+        // high water mark of status, the peak since the last reset
+        auto readHighWaterMark() -> std::size_t {
+            std::FILE* file{ std::fopen("/proc/self/status", "r") };
+            if (file == nullptr)
+                return 0;
+
+            char line[256]{};
+            unsigned long kilobytes{};
+            bool found{};
+
+            while (!found && std::fgets(line, sizeof(line), file) != nullptr)
+                found = std::strncmp(line, "VmHWM:", 6) == 0 && std::sscanf(line + 6, "%lu", &kilobytes) == 1;
+
+            std::fclose(file);
+            return found ? static_cast<std::size_t>(kilobytes) * 1024 : 0;
+        }
+#endif
+    }
+
+    auto getPeakResidentBytes() -> std::size_t {
+#if defined(_WIN64) || defined(WIN32)
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0;
+
+        return static_cast<std::size_t>(counters.PeakWorkingSetSize);
+#else
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+
+    #if defined(__APPLE__)
+        return static_cast<std::size_t>(usage.ru_maxrss);
+    #else
+        // kilobytes on Linux
+        return std::max(static_cast<std::size_t>(usage.ru_maxrss) * 1024, s_PeakBeforeReset.load());
+    #endif
+#endif
+    }
+
+    auto getPeakResidentBytesSinceReset() -> std::size_t {
+#if defined(_WIN64) || defined(WIN32) || defined(__APPLE__)
+        return getPeakResidentBytes();
+#else
+        const std::size_t peak{ readHighWaterMark() };
+        return peak != 0 ? peak : getPeakResidentBytes();
+#endif
+    }
+
+    auto resetPeakResidentBytes() -> bool {
+#if defined(_WIN64) || defined(WIN32) || defined(__APPLE__)
+        return false;
+#else
+        const std::size_t peak{ readHighWaterMark() };
+        std::size_t previous{ s_PeakBeforeReset.load() };
+        while (previous < peak && !s_PeakBeforeReset.compare_exchange_weak(previous, peak)) {}
+
+        // writing 5 restarts the high water mark from the current resident set, Linux 4.0 onwards
+        std::FILE* file{ std::fopen("/proc/self/clear_refs", "w") };
+        if (file == nullptr)
+            return false;
+
+        const bool written{ std::fputs("5", file) >= 0 };
+        return std::fclose(file) == 0 && written;
+#endif
+    }
+
+    auto getResidentBytes() -> std::size_t {
+#if defined(_WIN64) || defined(WIN32)
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0;
+
+        return static_cast<std::size_t>(counters.WorkingSetSize);
+#elif defined(__APPLE__)
+        mach_task_basic_info info{};
+        mach_msg_type_number_t count{ MACH_TASK_BASIC_INFO_COUNT };
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+            return 0;
+
+        return static_cast<std::size_t>(info.resident_size);
+#else
+        // second field of statm, in pages
+        std::FILE* file{ std::fopen("/proc/self/statm", "r") };
+        if (file == nullptr)
+            return 0;
+
+        unsigned long size{};
+        unsigned long resident{};
+        const int read{ std::fscanf(file, "%lu %lu", &size, &resident) };
+        std::fclose(file);
+
+        return read == 2 ? static_cast<std::size_t>(resident) * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#endif
+    }
+}
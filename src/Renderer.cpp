@@ -1,16 +1,42 @@
 #include "OpenGL/Renderer.hh"
 #include "OpenGL/Texture.hh"
+#include "OpenGL/GeometryArena.hh"
+#include "OpenGL/TextureStreamer.hh"
+
+// C++ Standard Library
+#include <algorithm>
+#include <limits>
+#include <utility>
 
 namespace kT {
+    Renderer::Stats Renderer::s_Stats{};
+    std::vector<GLsizei> Renderer::s_DrawCounts{};
+    std::vector<void*> Renderer::s_DrawOffsets{};
+    std::vector<GLint> Renderer::s_DrawBaseVertices{};
+    std::vector<Renderer::Batch> Renderer::s_Batches{};
+    std::vector<glm::mat4> Renderer::s_InstanceTransforms{};
+
     auto Renderer::Init() -> void {
         s_VertexArray = std::make_shared<VertexArray>();
+        s_InstanceBuffer = std::make_unique<VertexBuffer>();
+
+        // geometry drawn without instances is placed by the model matrix alone. No vertex array is bound
+        // yet, whose instance arrays could be disabled, those are disabled by default anyway
+        LoadInstanceTransform(glm::mat4(1.0f));
         glEnable(GL_BLEND);
         glEnable(GL_DEPTH_TEST);
+
+        // meshlet cone culling drops back facing clusters, the rasterizer drops the back faces of everything else
+        glEnable(GL_CULL_FACE);
+        glCullFace(GL_BACK);
+        glFrontFace(GL_CCW);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     }
 
     auto Renderer::ShutDown() -> void {
-
+        s_InstanceBuffer.reset();
+        s_VertexArray.reset();
+        GeometryArena::ShutDown();
     }
 
     auto Renderer::EnableWireframeMode() -> void {
@@ -21,21 +47,23 @@ namespace kT {
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
     }
 
-    auto Renderer::DrawMesh(Shader& shader, const Mesh& mesh) -> void {
-        const std::vector<Texture>& textures{ mesh.getTextures() };
+    auto Renderer::BindMaterial(Shader& shader, const Mesh& mesh) -> void {
+        const std::vector<std::shared_ptr<Texture>>& textures{ mesh.getTextures() };
         std::uint32_t diffuseCount{ 1 };
         std::uint32_t specularCount{ 1 };
         std::uint32_t normalCount{ 1 };
+        const Texture* diffuse{};
 
         for(std::int32_t i = 0; i < textures.size(); i++) {
             std::string number{};
 
             Texture::bindUnit(i);
 
-            switch(textures[i].getType()) {
+            switch(textures[i]->getType()) {
 
                 case Texture::TextureType::DIFFUSE:
                     number = std::to_string(diffuseCount++);
+                    diffuse = textures[i].get();
                     break;
                 case Texture::TextureType::SPECULAR:
                     number = std::to_string(specularCount++);
@@ -45,19 +73,314 @@ namespace kT {
                     break;
             }
 
-            shader.setUniformInt("material." + std::string(Texture::getStrType(textures[i].getType())), i);
-            textures[i].bind();
+            shader.setUniformInt("material." + std::string(Texture::getStrType(textures[i]->getType())), i);
+            textures[i]->bind();
         }
 
+        // the tangent stream only holds data for meshes whose material has a normal map
+        shader.setUniformBool("normalMapped", mesh.hasTangents() && normalCount > 1);
+
+        // the lit result is linear when the diffuse map sampled, the last one bound, is sRGB
+        const bool srgb{ diffuse != nullptr && diffuse->isSrgb() };
+        shader.setUniformBool("gammaEncode", srgb);
+        shader.setUniformBool("gammaDecode", srgb && !diffuse->isSrgbSampled());
+
+        // compact vertices store positions relative to the mesh bounds
+        shader.setUniformVec3("positionOffset", mesh.getPositionTransform().offset);
+        shader.setUniformVec3("positionScale", mesh.getPositionTransform().scale);
+
         shader.use();
-        s_VertexArray->useVertexBuffer(mesh.getVertexBuffer());
-        mesh.getIndexBuffer().bind();
-        glDrawElements(GL_TRIANGLES, mesh.getIndexBuffer().getCount(), GL_UNSIGNED_INT, nullptr);
+    }
+
+    auto Renderer::GetIndexOffset(const Mesh& mesh, std::uint32_t firstIndex) -> void* {
+        const std::size_t indexSize{ mesh.getIndexType() == GL_UNSIGNED_SHORT ? sizeof(std::uint16_t) : sizeof(std::uint32_t) };
+        return reinterpret_cast<void*>(static_cast<std::uintptr_t>(mesh.getGeometry().indexOffset + firstIndex * indexSize));
+    }
+
+    auto Renderer::DrawMeshRange(Shader& shader, const Mesh& mesh, std::size_t lod, std::size_t instances) -> void {
+        const auto& level{ mesh.getLods()[lod] };
+
+        BindMaterial(shader, mesh);
+        ++s_Stats.drawCalls;
+
+        if (instances == 1) {
+            glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(level.indexCount), mesh.getIndexType(),
+                                     GetIndexOffset(mesh, level.firstIndex), static_cast<GLint>(mesh.getGeometry().firstVertex));
+        }
+        else {
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(level.indexCount), mesh.getIndexType(),
+                                              GetIndexOffset(mesh, level.firstIndex), static_cast<GLsizei>(instances),
+                                              static_cast<GLint>(mesh.getGeometry().firstVertex));
+        }
+    }
+
+    auto Renderer::SetInstanceTransform(const glm::mat4& transform) -> void {
+        // a disabled array makes every vertex read the current attribute value instead
+        for (GLuint column{}; column < 4; column++)
+            glDisableVertexAttribArray(s_InstanceAttribute + column);
+
+        LoadInstanceTransform(transform);
+    }
+
+    auto Renderer::LoadInstanceTransform(const glm::mat4& transform) -> void {
+        for (GLuint column{}; column < 4; column++)
+            glVertexAttrib4fv(s_InstanceAttribute + column, glm::value_ptr(transform[static_cast<int>(column)]));
+    }
+
+    auto Renderer::ResetPositionTransform(const Shader& shader) -> void {
+        // the uniforms keep the transform of the last mesh drawn with compact vertices
+        if (glGetUniformLocation(shader.getProgram(), "positionOffset") == -1)
+            return;
+
+        shader.setUniformVec3("positionOffset", glm::vec3(0.0f));
+        shader.setUniformVec3("positionScale", glm::vec3(1.0f));
+    }
+
+    auto Renderer::BindInstances(std::size_t first) -> void {
+        // the attribute pointers are part of the bound vertex array, so they are set again for every batch
+        s_InstanceBuffer->bind();
+        for (GLuint column{}; column < 4; column++) {
+            const std::size_t offset{ first * sizeof(glm::mat4) + column * sizeof(glm::vec4) };
+
+            glEnableVertexAttribArray(s_InstanceAttribute + column);
+            glVertexAttribPointer(s_InstanceAttribute + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                                  reinterpret_cast<const void*>(static_cast<std::uintptr_t>(offset)));
+            glVertexAttribDivisor(s_InstanceAttribute + column, 1);
+        }
+        s_InstanceBuffer->unbind();
+    }
+
+    auto Renderer::DrawBatches(Shader& shader, const Model& model, const Camera* camera) -> void {
+        const auto& meshes{ model.getMeshes() };
+
+        // one upload per model and frame, orphaning the previous contents
+        if (std::any_of(s_Batches.begin(), s_Batches.end(), [](const Batch& batch) -> bool { return batch.instanceCount > 1; })) {
+            s_InstanceBuffer->load(std::span<const float>{ glm::value_ptr(s_InstanceTransforms.front()), s_InstanceTransforms.size() * 16 },
+                                   GL_STREAM_DRAW);
+        }
+
+        // the meshes of a model share one arena block, so this binds at most once per file loaded into it
+        std::optional<std::uint32_t> bound{};
+
+        for (const auto& batch : s_Batches) {
+            const Mesh& mesh{ meshes[batch.mesh] };
+
+            if (bound != mesh.getGeometry().block) {
+                bound = mesh.getGeometry().block;
+                GeometryArena::Bind(*bound);
+            }
+
+            if (batch.instanceCount == 1) {
+                SetInstanceTransform(s_InstanceTransforms[batch.firstInstance]);
+
+                // a lone instance at full resolution is culled per meshlet instead, in mesh space
+                // like the planes taken from the full transform and the eye brought back by its inverse
+                if (camera != nullptr && batch.lod == 0 && s_MeshletCulling && !mesh.getMeshlets().empty()) {
+                    const Frustum frustum{ camera->getProjection() * camera->getView() * batch.transform };
+                    const glm::vec3 eye{ glm::inverse(batch.transform) * glm::vec4(camera->getPosition(), 1.0f) };
+
+                    s_Stats.trianglesDrawn += DrawMeshlets(shader, mesh, frustum, eye);
+                    continue;
+                }
+
+                DrawMeshRange(shader, mesh, batch.lod);
+            }
+            else {
+                BindInstances(batch.firstInstance);
+                DrawMeshRange(shader, mesh, batch.lod, batch.instanceCount);
+                s_Stats.instancesBatched += batch.instanceCount;
+            }
+
+            s_Stats.trianglesDrawn += mesh.getLods()[batch.lod].indexCount / 3 * batch.instanceCount;
+        }
+    }
+
+    auto Renderer::DrawMeshlets(Shader& shader, const Mesh& mesh, const Frustum& frustum, const glm::vec3& eye) -> std::size_t {
+        s_DrawCounts.clear();
+        s_DrawOffsets.clear();
+        s_DrawBaseVertices.clear();
+
+        std::size_t triangles{};
+        std::uint32_t runStart{};
+        std::uint32_t runEnd{};
+
+        // visible meshlets next to each other in the index buffer are merged into a single draw
+        auto flush{ [&]() -> void {
+            if (runEnd == runStart)
+                return;
+
+            s_DrawCounts.push_back(static_cast<GLsizei>(runEnd - runStart));
+            s_DrawOffsets.push_back(GetIndexOffset(mesh, runStart));
+            s_DrawBaseVertices.push_back(static_cast<GLint>(mesh.getGeometry().firstVertex));
+            triangles += (runEnd - runStart) / 3;
+        } };
+
+        for (const auto& meshlet : mesh.getMeshlets()) {
+            const glm::vec3 toMeshlet{ meshlet.bounds.center - eye };
+            bool visible{ true };
+
+            if (!frustum.intersects(meshlet.bounds)) {
+                ++s_Stats.meshletsFrustumCulled;
+                visible = false;
+            }
+            else if (glm::dot(toMeshlet, meshlet.coneAxis) >= meshlet.coneCutoff * glm::length(toMeshlet) + meshlet.bounds.radius) {
+                ++s_Stats.meshletsBackfaceCulled;
+                visible = false;
+            }
+
+            if (!visible) {
+                s_Stats.trianglesClusterCulled += meshlet.indexCount / 3;
+                continue;
+            }
+
+            ++s_Stats.meshletsDrawn;
+            if (meshlet.firstIndex != runEnd) {
+                flush();
+                runStart = meshlet.firstIndex;
+            }
+
+            runEnd = meshlet.firstIndex + meshlet.indexCount;
+        }
+
+        flush();
+
+        if (s_DrawCounts.empty())
+            return 0;
+
+        BindMaterial(shader, mesh);
+        ++s_Stats.drawCalls;
+        glMultiDrawElementsBaseVertex(GL_TRIANGLES, s_DrawCounts.data(), mesh.getIndexType(), s_DrawOffsets.data(),
+                                      static_cast<GLsizei>(s_DrawCounts.size()), s_DrawBaseVertices.data());
+
+        return triangles;
+    }
+
+    auto Renderer::DrawMesh(Shader& shader, const Mesh& mesh) -> void {
+        GeometryArena::Bind(mesh.getGeometry().block);
+        SetInstanceTransform(glm::mat4(1.0f));
+        DrawMeshRange(shader, mesh);
     }
 
     auto Renderer::DrawModel(Shader& shader, Model& model) -> void {
-        for (const auto& mesh : model.getMeshes())
-            Renderer::DrawMesh(shader, mesh);
+        model.updateTransforms();
+        s_Batches.clear();
+        s_InstanceTransforms.clear();
+
+        // instances are sorted by mesh, so each mesh takes a single batch
+        for (const auto& instance : model.getInstances()) {
+            if (instance.mesh >= model.getMeshes().size())
+                continue;
+
+            if (s_Batches.empty() || s_Batches.back().mesh != instance.mesh)
+                s_Batches.push_back({ instance.mesh, 0, s_InstanceTransforms.size(), 0, instance.transform });
+
+            ++s_Batches.back().instanceCount;
+            s_InstanceTransforms.push_back(instance.transform);
+        }
+
+        // without a camera there is no telling how large the textures are seen
+        for (const auto& batch : s_Batches)
+            TextureStreamer::Request(model.getMeshes()[batch.mesh], 0.0f);
+
+        DrawBatches(shader, model, nullptr);
+    }
+
+    auto Renderer::DrawModel(Shader& shader, Model& model, const Camera& camera, const glm::mat4& transform) -> void {
+        model.updateTransforms();
+        const auto& meshes{ model.getMeshes() };
+        const auto instances{ model.getInstances() };
+
+        s_Batches.clear();
+        s_InstanceTransforms.clear();
+
+        // level picked for every visible instance of the mesh being looked at
+        std::vector<std::pair<std::uint32_t, const MeshInstance*>> visible{};
+
+        for (std::size_t first{}; first < instances.size();) {
+            const std::uint32_t meshIndex{ instances[first].mesh };
+
+            std::size_t last{ first };
+            while (last < instances.size() && instances[last].mesh == meshIndex)
+                ++last;
+
+            // instances of meshes still being uploaded are left for a later frame
+            if (meshIndex >= meshes.size()) {
+                first = last;
+                continue;
+            }
+
+            const Mesh& mesh{ meshes[meshIndex] };
+            const auto& bounds{ mesh.getBounds() };
+            const auto& lods{ mesh.getLods() };
+            visible.clear();
+
+            // texture coordinates under a pixel at the closest instance, tells the streamer which levels are seen
+            float coordinatesPerPixel{ std::numeric_limits<float>::max() };
+
+            for (std::size_t i{ first }; i < last; i++) {
+                const glm::mat4 world{ transform * instances[i].transform };
+
+                // planes taken from the full transform are in mesh space
+                if (!Frustum{ camera.getProjection() * camera.getView() * world }.intersects(bounds)) {
+                    ++s_Stats.meshesCulled;
+                    continue;
+                }
+
+                // bounds and errors are in mesh units, the largest axis scale keeps them conservative
+                const float scale{ std::max({ glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2])) }) };
+                const glm::vec3 center{ world * glm::vec4(bounds.center, 1.0f) };
+                const float radius{ bounds.radius * scale };
+                const float distance{ glm::length(center - camera.getPosition()) - radius };
+
+                // the camera is inside the bounds, nothing can be left out
+                std::size_t lod{};
+                if (distance > 0.0f) {
+                    if (camera.getScreenSize(2.0f * radius, distance) < s_CullPixelSize) {
+                        ++s_Stats.meshesCulled;
+                        continue;
+                    }
+
+                    lod = lods.size() - 1;
+                    while (lod > 0 && camera.getScreenSize(lods[lod].error * scale, distance) > s_LodPixelError)
+                        --lod;
+
+                    coordinatesPerPixel = std::min(coordinatesPerPixel, mesh.getTexelDensity() / scale / camera.getScreenSize(1.0f, distance));
+                }
+                else {
+                    coordinatesPerPixel = 0.0f;
+                }
+
+                visible.emplace_back(static_cast<std::uint32_t>(lod), &instances[i]);
+                ++s_Stats.meshesDrawn;
+                ++s_Stats.meshesPerLod[std::min(lod, s_Stats.meshesPerLod.size() - 1)];
+                s_Stats.trianglesFullDetail += lods.front().indexCount / 3;
+            }
+
+            if (!visible.empty())
+                TextureStreamer::Request(mesh, coordinatesPerPixel);
+
+            // one batch per level of detail in use
+            std::stable_sort(visible.begin(), visible.end(), [](const auto& a, const auto& b) -> bool { return a.first < b.first; });
+            for (const auto& [lod, instance] : visible) {
+                if (s_Batches.empty() || s_Batches.back().mesh != meshIndex || s_Batches.back().lod != lod)
+                    s_Batches.push_back({ meshIndex, lod, s_InstanceTransforms.size(), 0, transform * instance->transform });
+
+                ++s_Batches.back().instanceCount;
+                s_InstanceTransforms.push_back(instance->transform);
+            }
+
+            first = last;
+        }
+
+        DrawBatches(shader, model, &camera);
+    }
+
+    auto Renderer::GetStats() -> const Stats& {
+        return s_Stats;
+    }
+
+    auto Renderer::ResetStats() -> void {
+        s_Stats = {};
     }
 
     auto Renderer::ClearColor(const glm::vec4 &color) -> void {
@@ -71,11 +394,17 @@ namespace kT {
     }
 
     auto Renderer::DrawGeometry(Shader &shader, const VertexBuffer &vertexBuffer) -> void {
+        // the last batch drawn may have left its transform as the current value, the vertex array is the caller's
+        LoadInstanceTransform(glm::mat4(1.0f));
+        ResetPositionTransform(shader);
         glDrawArrays(GL_TRIANGLES, 0, vertexBuffer.getCount());
     }
 
     auto Renderer::DrawGeometry(Shader &shader, const VertexBuffer& vertexBuffer, const ElementBuffer &indexBuffer) -> void {
         s_VertexArray->useVertexBuffer(vertexBuffer);
+        // the last batch drawn may have left its transform as the current value
+        SetInstanceTransform(glm::mat4(1.0f));
+        ResetPositionTransform(shader);
         glDrawElements(GL_TRIANGLES, indexBuffer.getCount(), GL_UNSIGNED_INT, nullptr);
     }
 
@@ -85,13 +414,13 @@ namespace kT {
 
     auto Renderer::DrawGeometry(Shader &shader, std::initializer_list<float> &&vertexBuffer) -> void {
         // will use the default buffer layout
-        VertexBuffer vertices{ std::forward<std::initializer_list<float>>(vertexBuffer) };
+        VertexBuffer vertices{ std::span<const float>{ vertexBuffer.begin(), vertexBuffer.size() } };
         DrawGeometry(shader, vertices);
     }
 
     auto Renderer::DrawGeometry(Shader &shader, std::initializer_list<float> &&vertexBuffer, std::initializer_list<std::uint32_t> &&indexBuffer) -> void {
-        VertexBuffer vertices{ std::forward<std::initializer_list<float>>(vertexBuffer) };
-        ElementBuffer indices{ std::forward<std::initializer_list<std::uint32_t>>(indexBuffer) };
+        VertexBuffer vertices{ std::span<const float>{ vertexBuffer.begin(), vertexBuffer.size() } };
+        ElementBuffer indices{ std::span<const std::uint32_t>{ indexBuffer.begin(), indexBuffer.size() } };
         DrawGeometry(shader, vertices, indices);
     }
 
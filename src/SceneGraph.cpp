@@ -0,0 +1,79 @@
+// C++ Standard Library
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// Project Libraries
+#include "OpenGL/SceneGraph.hh"
+
+namespace kT {
+    auto SceneGraph::addNode(std::uint32_t parent, const glm::mat4& local, std::string_view name) -> std::uint32_t {
+        if (parent != s_NoParent && parent >= m_Parents.size())
+            throw std::runtime_error("Scene node " + std::to_string(m_Parents.size()) + " has a missing parent");
+
+        const auto index{ static_cast<std::uint32_t>(m_Parents.size()) };
+        m_Parents.push_back(parent);
+        m_Local.push_back(local);
+        m_World.push_back(local);
+        m_Names.emplace_back(name);
+        m_Dirty.push_back(1);
+        m_Updated.push_back(0);
+
+        m_FirstDirty = std::min<std::size_t>(m_FirstDirty, index);
+        return index;
+    }
+
+    auto SceneGraph::append(const SceneGraph& other, std::uint32_t parent) -> std::uint32_t {
+        if (parent != s_NoParent && parent >= m_Parents.size())
+            throw std::runtime_error("Appended scene nodes have a missing parent");
+
+        const auto offset{ static_cast<std::uint32_t>(m_Parents.size()) };
+        const std::size_t size{ m_Parents.size() + other.getSize() };
+
+        m_Parents.reserve(size);
+        for (const auto otherParent : other.m_Parents)
+            m_Parents.push_back(otherParent == s_NoParent ? parent : otherParent + offset);
+
+        m_Local.insert(m_Local.end(), other.m_Local.begin(), other.m_Local.end());
+        m_World.insert(m_World.end(), other.m_World.begin(), other.m_World.end());
+        m_Names.insert(m_Names.end(), other.m_Names.begin(), other.m_Names.end());
+        m_Dirty.resize(size, 1);
+        m_Updated.resize(size, 0);
+
+        m_FirstDirty = std::min<std::size_t>(m_FirstDirty, offset);
+        return offset;
+    }
+
+    auto SceneGraph::setLocalTransform(std::uint32_t node, const glm::mat4& local) -> void {
+        m_Local[node] = local;
+        m_Dirty[node] = 1;
+        m_FirstDirty = std::min<std::size_t>(m_FirstDirty, node);
+    }
+
+    auto SceneGraph::update() -> std::size_t {
+        // flags left by the previous update are cleared first, most frames nothing changes
+        if (m_LastUpdated != 0)
+            std::fill(m_Updated.begin(), m_Updated.end(), 0);
+
+        std::size_t updated{};
+        const std::size_t size{ m_Parents.size() };
+
+        // parents come first, so by the time a node is reached its parent world transform is final
+        for (std::size_t node{ m_FirstDirty }; node < size; node++) {
+            const std::uint32_t parent{ m_Parents[node] };
+            const bool parentUpdated{ parent != s_NoParent && m_Updated[parent] != 0 };
+
+            if (m_Dirty[node] == 0 && !parentUpdated)
+                continue;
+
+            m_World[node] = parent == s_NoParent ? m_Local[node] : m_World[parent] * m_Local[node];
+            m_Dirty[node] = 0;
+            m_Updated[node] = 1;
+            ++updated;
+        }
+
+        m_FirstDirty = size;
+        m_LastUpdated = updated;
+        return updated;
+    }
+}
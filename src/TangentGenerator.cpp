@@ -0,0 +1,137 @@
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// Project Libraries
+#include "OpenGL/Mesh.hh"
+#include "OpenGL/TangentGenerator.hh"
+
+namespace kT {
+    namespace {
+        // texture space areas below this are degenerate, their triangles do not contribute
+        constexpr float s_MinArea{ 1e-12f };
+
+        // any unit vector perpendicular to n, for vertices without usable texture coordinates
+        auto getPerpendicular(const glm::vec3& n) -> glm::vec3 {
+            const glm::vec3 axis{ std::abs(n.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f) };
+            return glm::normalize(glm::cross(n, axis));
+        }
+
+        auto getAngle(const glm::vec3& a, const glm::vec3& b) -> float {
+            const float lengths{ glm::length(a) * glm::length(b) };
+            return lengths > 0.0f ? std::acos(std::clamp(glm::dot(a, b) / lengths, -1.0f, 1.0f)) : 0.0f;
+        }
+    }
+
+    auto TangentGenerator::IsNeeded(const MeshData& mesh) -> bool {
+        return std::any_of(mesh.textures.begin(), mesh.textures.end(),
+                           [](const TextureRef& ref) -> bool { return ref.type == Texture::TextureType::NORMAL; });
+    }
+
+    auto TangentGenerator::Generate(MeshData& mesh) -> std::size_t {
+        const std::size_t floatsPerVertex{ Mesh::GetLayout().getStride() / sizeof(float) };
+        const std::size_t vertexCount{ mesh.vertices.size() / floatsPerVertex };
+
+        auto attribute{ [&mesh, floatsPerVertex](std::size_t vertex, std::size_t offset) -> const float* {
+            return mesh.vertices.data() + vertex * floatsPerVertex + offset;
+        } };
+        auto position{ [&](std::size_t vertex) -> glm::vec3 { const float* p{ attribute(vertex, 0) }; return glm::vec3(p[0], p[1], p[2]); } };
+        auto normal{ [&](std::size_t vertex) -> glm::vec3 { const float* n{ attribute(vertex, 3) }; return glm::vec3(n[0], n[1], n[2]); } };
+        auto uv{ [&](std::size_t vertex) -> glm::vec2 { const float* t{ attribute(vertex, 6) }; return glm::vec2(t[0], t[1]); } };
+
+        // every vertex sums the frames of its triangles separately for each handedness
+        std::vector<std::array<glm::vec3, 2>> sums(vertexCount, { glm::vec3(0.0f), glm::vec3(0.0f) });
+        std::vector<std::array<bool, 2>> used(vertexCount, { false, false });
+        std::vector<std::uint8_t> triangleSide(mesh.indices.size() / 3);
+
+        for (std::size_t triangle{}; triangle < triangleSide.size(); triangle++) {
+            const std::array<std::uint32_t, 3> corners{ mesh.indices[triangle * 3], mesh.indices[triangle * 3 + 1], mesh.indices[triangle * 3 + 2] };
+            if (corners[0] >= vertexCount || corners[1] >= vertexCount || corners[2] >= vertexCount)
+                continue;
+
+            const glm::vec3 p0{ position(corners[0]) };
+            const glm::vec3 e1{ position(corners[1]) - p0 };
+            const glm::vec3 e2{ position(corners[2]) - p0 };
+            const glm::vec2 d1{ uv(corners[1]) - uv(corners[0]) };
+            const glm::vec2 d2{ uv(corners[2]) - uv(corners[0]) };
+
+            const float area{ d1.x * d2.y - d2.x * d1.y };
+            if (std::abs(area) < s_MinArea)
+                continue;
+
+            // derivatives of the position along u and v
+            const glm::vec3 tangent{ (e1 * d2.y - e2 * d1.y) / area };
+            const glm::vec3 bitangent{ (e2 * d1.x - e1 * d2.x) / area };
+
+            // mirrored texture flips the bitangent relative to the winding of the triangle
+            const std::uint8_t side{ glm::dot(glm::cross(glm::cross(e1, e2), tangent), bitangent) < 0.0f ? std::uint8_t{ 1 } : std::uint8_t{ 0 } };
+            triangleSide[triangle] = side;
+
+            for (std::size_t corner{}; corner < 3; corner++) {
+                const std::uint32_t vertex{ corners[corner] };
+                const glm::vec3 n{ normal(vertex) };
+                const glm::vec3 projected{ tangent - n * glm::dot(n, tangent) };
+
+                const float length{ glm::length(projected) };
+                if (length <= 0.0f)
+                    continue;
+
+                const glm::vec3 here{ position(vertex) };
+                const float angle{ getAngle(position(corners[(corner + 1) % 3]) - here, position(corners[(corner + 2) % 3]) - here) };
+
+                sums[vertex][side] += projected / length * angle;
+                used[vertex][side] = true;
+            }
+        }
+
+        // vertices used from both sides keep the right handed frame, the left handed one moves to a copy
+        std::vector<std::uint32_t> mirrored(vertexCount, UINT32_MAX);
+        const auto split{ static_cast<std::size_t>(std::count_if(used.begin(), used.end(), [](const auto& sides) -> bool { return sides[0] && sides[1]; })) };
+        std::size_t added{};
+
+        mesh.vertices.reserve((vertexCount + split) * floatsPerVertex);
+        for (std::size_t vertex{}; vertex < vertexCount; vertex++) {
+            if (!used[vertex][0] || !used[vertex][1])
+                continue;
+
+            mirrored[vertex] = static_cast<std::uint32_t>(vertexCount + added++);
+            for (std::size_t i{}; i < floatsPerVertex; i++)
+                mesh.vertices.push_back(mesh.vertices[vertex * floatsPerVertex + i]);
+        }
+
+        if (added != 0) {
+            for (std::size_t i{}; i < triangleSide.size() * 3; i++) {
+                if (const std::uint32_t vertex{ mesh.indices[i] }; vertex < vertexCount && triangleSide[i / 3] == 1 && mirrored[vertex] != UINT32_MAX)
+                    mesh.indices[i] = mirrored[vertex];
+            }
+        }
+
+        mesh.tangents.assign((vertexCount + added) * s_Components, 0.0f);
+
+        auto store{ [&](std::size_t vertex, glm::vec3 sum, float handedness) -> void {
+            const glm::vec3 n{ normal(vertex) };
+
+            // Gram-Schmidt against the normal once more, the sum of projected tangents may have drifted
+            sum -= n * glm::dot(n, sum);
+            const float length{ glm::length(sum) };
+            const glm::vec3 tangent{ length > 0.0f ? sum / length : getPerpendicular(glm::length(n) > 0.0f ? glm::normalize(n) : glm::vec3(0.0f, 0.0f, 1.0f)) };
+
+            float* destination{ mesh.tangents.data() + vertex * s_Components };
+            destination[0] = tangent.x;
+            destination[1] = tangent.y;
+            destination[2] = tangent.z;
+            destination[3] = handedness;
+        } };
+
+        for (std::size_t vertex{}; vertex < vertexCount; vertex++) {
+            const bool leftHanded{ used[vertex][1] && !used[vertex][0] };
+            store(vertex, leftHanded ? sums[vertex][1] : sums[vertex][0], leftHanded ? -1.0f : 1.0f);
+
+            if (mirrored[vertex] != UINT32_MAX)
+                store(mirrored[vertex], sums[vertex][1], -1.0f);
+        }
+
+        return added;
+    }
+}
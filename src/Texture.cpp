@@ -1,9 +1,142 @@
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <new>
+
+// Project Libraries
+#include "OpenGL/BakedTexture.hh"
+#include "OpenGL/MipGenerator.hh"
 #include "OpenGL/Texture.hh"
+#include "OpenGL/TextureCompressor.hh"
+#include "OpenGL/TextureStreamer.hh"
+#include "OpenGL/TextureUploader.hh"
 
 namespace  kT {
+    namespace {
+        // highest anisotropy requested, past it the sharpness gained is rarely worth the texture fetches
+        constexpr float s_MaxAnisotropy{ 8.0f };
+
+        // wrapping and filtering options of the bound texture, trilinear across its full mip chain
+        auto setSamplerState() -> void {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+            // keeps surfaces seen at grazing angles sharp, where trilinear filtering blurs them
+            if (GLEW_EXT_texture_filter_anisotropic) {
+                static const float maxAnisotropy{ []() -> float {
+                    float value{ 1.0f };
+                    glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &value);
+                    return value;
+                }() };
+
+                glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, std::min(maxAnisotropy, s_MaxAnisotropy));
+            }
+        }
+
+        // immutable storage allocates every level at once and spares the driver checking the chain at draw time
+        auto hasTextureStorage() -> bool {
+            return GLEW_VERSION_4_2 || GLEW_ARB_texture_storage;
+        }
+
+        // copies between textures on the GPU, residency changes keep the levels already sent
+        auto hasCopyImage() -> bool {
+            return GLEW_VERSION_4_3 || GLEW_ARB_copy_image;
+        }
+
+        // gray colors take a single channel that sampling decodes from sRGB
+        auto hasSrgbR8() -> bool {
+            return GLEW_EXT_texture_sRGB_R8;
+        }
+
+        struct UploadFormat {
+            GLenum                  internalFormat{};
+            GLenum                  format{};       // of the client texels
+            std::int32_t            texelBytes{};   // in video memory, drivers pad three channel formats to four bytes
+            std::array<GLint, 4>    swizzle{ GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA };
+        };
+
+        /**
+         * Returns the video memory layout of an uncompressed image. Diffuse maps hold colors and are
+         * stored in sRGB so sampling returns linear values, other maps hold data and are stored as is.
+         * Gray images are spread over RGB by the swizzle, so shaders keep reading .rgb and .a.
+         * Gray diffuse maps are stored as plain data without EXT_texture_sRGB_R8, the shader decodes them,
+         * see kT::Texture::isSrgbSampled(). Gray and alpha ones are expanded to RGBA before, see isGrayAlphaColor()
+         * */
+        auto getUploadFormat(std::int32_t channels, Texture::TextureType type) -> UploadFormat {
+            const bool color{ type == Texture::TextureType::DIFFUSE };
+
+            // core OpenGL has no one channel sRGB format, expanding gray colors to GL_SRGB8 would triple their size
+            switch (channels) {
+                case 1:
+                    return color && hasSrgbR8() ? UploadFormat{ GL_SR8_EXT, GL_RED, 1, { GL_RED, GL_RED, GL_RED, GL_ONE } }
+                                                : UploadFormat{ GL_R8, GL_RED, 1, { GL_RED, GL_RED, GL_RED, GL_ONE } };
+                case 2:
+                    return UploadFormat{ GL_RG8, GL_RG, 2, { GL_RED, GL_RED, GL_RED, GL_GREEN } };
+                case 3:
+                    return { color ? static_cast<GLenum>(GL_SRGB8) : static_cast<GLenum>(GL_RGB8), GL_RGB, 4 };
+                default:
+                    return { color ? static_cast<GLenum>(GL_SRGB8_ALPHA8) : static_cast<GLenum>(GL_RGBA8), GL_RGBA, 4 };
+            }
+        }
+
+        /**
+         * Returns true for gray and alpha diffuse maps. Their gray has to be decoded from sRGB while
+         * their alpha stays linear, as kT::MipGenerator filtered it, and no two channel format does that
+         * */
+        auto isGrayAlphaColor(const Texture::ImageData& image, Texture::TextureType type) -> bool {
+            return type == Texture::TextureType::DIFFUSE && image.format == Texture::PixelFormat::UNCOMPRESSED && image.channels == 2;
+        }
+
+        /**
+         * Returns a copy of a gray and alpha image whose gray is spread over RGB, every level included,
+         * so it can be stored as sRGB with the alpha in its own linear channel
+         * */
+        auto expandGrayAlpha(const Texture::ImageData& image) -> Texture::ImageData {
+            const auto expand{ [](const std::uint8_t* source, std::uint8_t* destination, std::size_t texels) -> void {
+                for (std::size_t i{}; i < texels; i++) {
+                    destination[i * 4 + 0] = source[i * 2];
+                    destination[i * 4 + 1] = source[i * 2];
+                    destination[i * 4 + 2] = source[i * 2];
+                    destination[i * 4 + 3] = source[i * 2 + 1];
+                }
+            } };
+
+            const std::size_t texels{ static_cast<std::size_t>(image.width) * static_cast<std::size_t>(image.height) };
+
+            Texture::ImageData rgba{ image.width, image.height, 4 };
+            rgba.bake = image.bake;
+            rgba.sourceHash = image.sourceHash;
+            rgba.pixels = { static_cast<std::uint8_t*>(std::malloc(texels * 4)), std::free };
+            if (!rgba.pixels)
+                throw std::bad_alloc{};
+
+            expand(image.pixels.get(), rgba.pixels.get(), texels);
+            rgba.mips.resize(image.mips.size() * 2);
+            expand(image.mips.data(), rgba.mips.data(), image.mips.size() / 2);
+            return rgba;
+        }
+
+        // video memory layout of a block compressed image, diffuse maps are sRGB like their uncompressed counterparts
+        auto getCompressedFormat(Texture::PixelFormat format, Texture::TextureType type) -> GLenum {
+            const bool color{ type == Texture::TextureType::DIFFUSE };
+
+            switch (format) {
+                case Texture::PixelFormat::BC1: return color ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+                case Texture::PixelFormat::BC3: return color ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                case Texture::PixelFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+                case Texture::PixelFormat::BC7: return color ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+                default: throw std::runtime_error("Could not load Texture data. format is not block compressed");
+            }
+        }
+    }
+
     // IMPLEMENTATION
     Texture::Texture(TextureType type, std::int32_t width, std::int32_t height) noexcept
-            :   m_Height{}, m_Width{}, m_Type{ type }
+            :   m_Height{ height }, m_Width{ width }, m_Type{ type }
     {
         glGenTextures(1, &this->m_Id);
     }
@@ -16,6 +149,21 @@ namespace  kT {
     }
 
     auto Texture::load(const std::filesystem::path& path) -> void {
+        ImageData image{ decode(path) };
+        MipGenerator::Generate(image, m_Type == TextureType::DIFFUSE);
+        if (isGrayAlphaColor(image, m_Type))
+            image = expandGrayAlpha(image);
+
+        m_Width = image.width;
+        m_Height = image.height;
+        m_Channels = image.channels;
+
+        bind();
+        setupTexture(image.pixels.get(), image.mips);
+        unbind();
+    }
+
+    auto Texture::decode(const std::filesystem::path& path) -> ImageData {
         std::array<char, 4096> fileDir{};
 #ifdef WINDOWS
         // fileDir.size() will return the amount of elements of fileDir, since it contains char which are byte sized
@@ -25,21 +173,52 @@ namespace  kT {
         std::copy(path.native().begin(), path.native().end(), fileDir.begin());
 #endif
 
-        stbi_set_flip_vertically_on_load(true);
-        // cast to const char because on windows path.c_str() returns a const wchar_t
-        std::uint8_t* imageData{ stbi_load(fileDir.data(), &m_Width, &m_Height, &m_Channels, 4) };
+        // the flag is thread local, decoding may run on any of the worker threads
+        stbi_set_flip_vertically_on_load_thread(true);
 
-        if (imageData) {
-            bind();
-            setupTexture(imageData);
-            unbind();
+        ImageData image{};
+        // cast to const char because on windows path.c_str() returns a const wchar_t
+        // keep the channels of the file, gray and RGB images take a quarter or three quarters of the memory of RGBA
+        image.pixels.reset(stbi_load(fileDir.data(), &image.width, &image.height, &image.channels, 0));
 
-            stbi_image_free(imageData);
-        }
-        else {
+        if (!image.pixels)
             throw std::runtime_error("Could not load Texture data");
-        }
 
+        return image;
+    }
+
+    auto Texture::decode(std::span<const std::byte> encoded) -> ImageData {
+        stbi_set_flip_vertically_on_load_thread(true);
+
+        ImageData image{};
+        image.pixels.reset(stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(encoded.data()), static_cast<int>(encoded.size()),
+                                                 &image.width, &image.height, &image.channels, 0));
+
+        if (!image.pixels)
+            throw std::runtime_error("Could not decode embedded Texture data");
+
+        return image;
+    }
+
+    auto Texture::probe(const std::filesystem::path& path) -> Dimensions {
+        Dimensions dimensions{};
+        std::int32_t channels{};
+
+        if (!stbi_info(path.string().c_str(), &dimensions.first, &dimensions.second, &channels))
+            return {};
+
+        return dimensions;
+    }
+
+    auto Texture::probe(std::span<const std::byte> encoded) -> Dimensions {
+        Dimensions dimensions{};
+        std::int32_t channels{};
+
+        if (!stbi_info_from_memory(reinterpret_cast<const stbi_uc*>(encoded.data()), static_cast<int>(encoded.size()),
+                                   &dimensions.first, &dimensions.second, &channels))
+            return {};
+
+        return dimensions;
     }
 
     auto Texture::bind() const -> void { glBindTexture(GL_TEXTURE_2D, getId()); }
@@ -48,7 +227,11 @@ namespace  kT {
 
     auto Texture::getId() const -> std::uint32_t { return m_Id; }
 
-    Texture::~Texture() { glDeleteTextures(1, &this->m_Id); }
+    Texture::~Texture() {
+        // levels still queued would be sent to a deleted texture, or to a new one reusing its name
+        TextureUploader::Cancel(m_Id);
+        glDeleteTextures(1, &this->m_Id);
+    }
 
     Texture::Texture(Texture&& other) noexcept { *this = std::move(other); }
 
@@ -58,6 +241,11 @@ namespace  kT {
         m_Height    = other.getDimensions().second;
         m_Channels  = other.getChannels();
         m_Type      = other.getType();
+        m_Format    = other.m_Format;
+        m_ResidentLevel = other.m_ResidentLevel;
+        m_Source    = std::move(other.m_Source);
+        m_Bake      = std::move(other.m_Bake);
+        m_SourceHash = other.m_SourceHash;
 
         other.m_Id          = 0;
         other.m_Width       = 0;
@@ -83,38 +271,308 @@ namespace  kT {
         return m_Type;
     }
 
+    auto Texture::isSrgb() const -> bool {
+        return m_Type == TextureType::DIFFUSE && m_Format != PixelFormat::BC5;
+    }
+
+    auto Texture::isSrgbSampled() const -> bool {
+        return isSrgb() && (m_Format != PixelFormat::UNCOMPRESSED || m_Channels != 1 || hasSrgbR8());
+    }
+
+    auto Texture::getSizeInBytes() const -> std::size_t {
+        return getSizeInBytes(m_ResidentLevel);
+    }
+
+    auto Texture::getSizeInBytes(std::int32_t residentLevel) const -> std::size_t {
+        // every texture has a full mip chain from its resident level down, uploaded or generated
+        std::size_t total{};
+        for (std::int32_t level{ std::max(residentLevel, 0) }; level < getLevelCount(); level++) {
+            total += TextureCompressor::GetLevelBytes(m_Format, std::max(m_Width >> level, 1), std::max(m_Height >> level, 1),
+                                                      getUploadFormat(m_Channels, m_Type).texelBytes);
+        }
+
+        return total;
+    }
+
+    auto Texture::getLevelCount() const -> std::int32_t {
+        return m_Width > 0 && m_Height > 0 ? MipGenerator::GetLevelCount(m_Width, m_Height) : 0;
+    }
+
     auto Texture::fromFile(const std::filesystem::path& path, kT::Texture::TextureType type) -> kT::Texture  {
         kT::Texture texture{ type };
         texture.load(path);
         return texture;
     }
 
-    auto Texture::setupTexture(const void* data) const -> void {
-        // setup wrapping and filtering options
-        GLenum format{};
+    auto Texture::isFormatSupported(PixelFormat format) -> bool {
+        switch (format) {
+            case PixelFormat::UNCOMPRESSED: return true;
+            case PixelFormat::BC1:
+            case PixelFormat::BC3: return GLEW_EXT_texture_compression_s3tc;
+            case PixelFormat::BC5: return GLEW_VERSION_3_0 || GLEW_ARB_texture_compression_rgtc;
+            case PixelFormat::BC7: return GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+        }
+
+        return false;
+    }
+
+    auto Texture::fromImage(const ImageData& image, kT::Texture::TextureType type) -> kT::Texture {
+        if (image.format != PixelFormat::UNCOMPRESSED) {
+            if (image.blocks.size() != TextureCompressor::GetChainBytes(image.format, image.width, image.height))
+                throw std::runtime_error("Could not load Texture data. image blocks do not match its size");
+
+            kT::Texture texture{ type, image.width, image.height };
+            texture.m_Width = image.width;
+            texture.m_Height = image.height;
+            texture.m_Channels = image.channels;
+            texture.m_Format = image.format;
+
+            texture.setupCompressedTexture(image.blocks);
+            return texture;
+        }
+
+        if (!image.pixels)
+            throw std::runtime_error("Could not load Texture data. image has no pixels");
+
+        if (isGrayAlphaColor(image, type))
+            return fromImage(expandGrayAlpha(image), type);
+
+        kT::Texture texture{ type, image.width, image.height };
+        texture.m_Width = image.width;
+        texture.m_Height = image.height;
+        texture.m_Channels = image.channels;
+
+        texture.setupTexture(image.pixels.get(), image.mips);
+        return texture;
+    }
+
+    auto Texture::setupTexture(const void* data, std::span<const std::uint8_t> mips) const -> void {
+        const UploadFormat upload{ getUploadFormat(m_Channels, m_Type) };
+        const bool immutable{ hasTextureStorage() };
+
+        const auto uploadLevel{ [&](std::int32_t level, std::int32_t width, std::int32_t height, const void* texels) -> void {
+            if (immutable)
+                glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, upload.format, GL_UNSIGNED_BYTE, texels);
+            else
+                glTexImage2D(GL_TEXTURE_2D, level, static_cast<GLint>(upload.internalFormat), width, height, 0, upload.format, GL_UNSIGNED_BYTE, texels);
+        } };
+
+        bind();
+
+        if (immutable)
+            glTexStorage2D(GL_TEXTURE_2D, MipGenerator::GetLevelCount(m_Width, m_Height), upload.internalFormat, m_Width, m_Height);
 
-        switch (m_Channels) {
-            case 1: format = GL_RED; break;
-            case 3: format = GL_RGB; break;
-            case 4: format = GL_RGBA; break;
+        // rows of one to three channel images are not padded to four bytes
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        uploadLevel(0, m_Width, m_Height, data);
+
+        if (mips.size() == MipGenerator::GetMipBytes(m_Width, m_Height, m_Channels) && !mips.empty()) {
+            // levels generated on the CPU follow one another, each half the size of the previous one
+            std::int32_t width{ m_Width };
+            std::int32_t height{ m_Height };
+            std::size_t offset{};
+
+            for (std::int32_t level{ 1 }; width > 1 || height > 1; level++) {
+                width = std::max(width / 2, 1);
+                height = std::max(height / 2, 1);
+                uploadLevel(level, width, height, mips.data() + offset);
+                offset += static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * static_cast<std::size_t>(m_Channels);
+            }
+        }
+        else {
+            // only raw texels handed over by the importer come without their mips
+            glGenerateMipmap(GL_TEXTURE_2D);
         }
 
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, upload.swizzle.data());
+        setSamplerState();
+        unbind();
+    }
+
+    auto Texture::setupCompressedTexture(std::span<const std::uint8_t> blocks) const -> void {
+        const GLenum internalFormat{ getCompressedFormat(m_Format, m_Type) };
+        const bool immutable{ hasTextureStorage() };
         bind();
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+        if (immutable)
+            glTexStorage2D(GL_TEXTURE_2D, MipGenerator::GetLevelCount(m_Width, m_Height), internalFormat, m_Width, m_Height);
+
+        // levels follow one another, each half the size of the previous one
+        std::int32_t width{ m_Width };
+        std::int32_t height{ m_Height };
+        std::size_t offset{};
+
+        for (std::int32_t level{}; ; level++) {
+            const std::size_t bytes{ TextureCompressor::GetLevelBytes(m_Format, width, height) };
+            if (immutable)
+                glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, internalFormat, static_cast<GLsizei>(bytes), blocks.data() + offset);
+            else
+                glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, static_cast<GLsizei>(bytes), blocks.data() + offset);
+            offset += bytes;
+
+            if (width == 1 && height == 1)
+                break;
+
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+        }
+
+        setSamplerState();
+        unbind();
+    }
+
+    auto Texture::fromImageAsync(ImageData&& image, kT::Texture::TextureType type, bool streamed) -> kT::Texture {
+        const bool compressed{ image.format != PixelFormat::UNCOMPRESSED };
+
+        if (!compressed && !image.pixels)
+            throw std::runtime_error("Could not load Texture data. image has no pixels");
+
+        // the uploader sends every level itself, OpenGL cannot generate the ones it has not received yet
+        if (!compressed && image.mips.size() != MipGenerator::GetMipBytes(image.width, image.height, image.channels))
+            MipGenerator::Generate(image, type == TextureType::DIFFUSE);
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        if (isGrayAlphaColor(image, type))
+            image = expandGrayAlpha(image);
 
+        kT::Texture texture{ type, image.width, image.height };
+        texture.m_Channels = image.channels;
+        texture.m_Format = image.format;
+        texture.m_ResidentLevel = streamed ? TextureStreamer::GetInitialLevel(image.width, image.height) : 0;
+
+        const UploadFormat upload{ getUploadFormat(image.channels, type) };
+        const GLenum internalFormat{ compressed ? getCompressedFormat(image.format, type) : upload.internalFormat };
+
+        texture.bind();
+        texture.allocateStorage(internalFormat, upload.format);
+        if (!compressed)
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, upload.swizzle.data());
+        setSamplerState();
         unbind();
+
+        // images no larger than the initial level are resident at once and never change, nothing is kept for them.
+        // The others are read again from their bake when raised, only images without one stay in client memory
+        auto source{ std::make_shared<const ImageData>(std::move(image)) };
+        if (texture.m_ResidentLevel > 0) {
+            if (source->bake.empty())
+                texture.m_Source = source;
+            else {
+                texture.m_Bake = source->bake;
+                texture.m_SourceHash = source->sourceHash;
+            }
+        }
+
+        TextureUploader::Enqueue({ texture.m_Id, std::move(source), compressed ? internalFormat : upload.format, texture.m_ResidentLevel });
+        return texture;
+    }
+
+    auto Texture::setResidentLevel(std::int32_t level) -> void {
+        if (!isStreamed())
+            throw std::runtime_error("Could not change Texture residency. texture keeps no image to send its levels from");
+
+        const std::int32_t levels{ getLevelCount() };
+        level = std::clamp(level, 0, levels - 1);
+
+        if (level == m_ResidentLevel)
+            return;
+
+        // levels after the one being sent are in video memory already, without copies between textures every level is sent again
+        const std::int32_t pending{ TextureUploader::GetPendingLevel(m_Id) };
+        const std::int32_t sent{ hasCopyImage() ? m_ResidentLevel + pending + 1 : levels };
+        const std::int32_t first{ std::max(sent, level) };
+
+        // read before anything changes, a texture whose levels cannot be sent keeps its residency
+        std::shared_ptr<const ImageData> source{};
+        if (first > level) {
+            source = loadSource();
+            if (!source) {
+                KATE_LOGGER_WARN("Could not read the levels of texture {} from {}, its residency stays", m_Id, m_Bake.string());
+                return;
+            }
+        }
+
+        TextureUploader::Cancel(m_Id);
+
+        const bool compressed{ m_Format != PixelFormat::UNCOMPRESSED };
+        const UploadFormat upload{ getUploadFormat(m_Channels, m_Type) };
+        const GLenum internalFormat{ compressed ? getCompressedFormat(m_Format, m_Type) : upload.internalFormat };
+
+        // storage cannot grow or shrink in place, a new texture takes the name of this one
+        const std::uint32_t previous{ m_Id };
+        const std::int32_t previousLevel{ m_ResidentLevel };
+        glGenTextures(1, &m_Id);
+        m_ResidentLevel = level;
+
+        bind();
+        allocateStorage(internalFormat, upload.format);
+        if (!compressed)
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, upload.swizzle.data());
+        setSamplerState();
+
+        for (std::int32_t copied{ first }; copied < levels; copied++) {
+            glCopyImageSubData(previous, GL_TEXTURE_2D, copied - previousLevel, 0, 0, 0, m_Id, GL_TEXTURE_2D, copied - level, 0, 0, 0,
+                               std::max(m_Width >> copied, 1), std::max(m_Height >> copied, 1), 1);
+        }
+
+        // sampling stays on the copied levels until the uploader sends the larger ones
+        if (first < levels)
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, first - level);
+
+        unbind();
+        glDeleteTextures(1, &previous);
+
+        if (first > level)
+            TextureUploader::Enqueue({ m_Id, std::move(source), compressed ? internalFormat : upload.format, level, first - 1 });
+    }
+
+    auto Texture::loadSource() const -> std::shared_ptr<const ImageData> {
+        if (m_Source)
+            return m_Source;
+
+        // the uploader holds the image until the levels are sent, then it is freed again
+        std::optional<ImageData> image{ BakedTexture::Open(m_Bake, m_SourceHash, m_Type == TextureType::DIFFUSE) };
+        if (!image || image->format != m_Format || image->width != m_Width || image->height != m_Height)
+            return nullptr;
+
+        if (isGrayAlphaColor(*image, m_Type))
+            image = expandGrayAlpha(*image);
+
+        if (image->format == PixelFormat::UNCOMPRESSED && image->channels != m_Channels)
+            return nullptr;
+
+        return std::make_shared<const ImageData>(std::move(*image));
+    }
+
+    auto Texture::allocateStorage(GLenum internalFormat, GLenum format) const -> void {
+        std::int32_t width{ std::max(m_Width >> m_ResidentLevel, 1) };
+        std::int32_t height{ std::max(m_Height >> m_ResidentLevel, 1) };
+
+        if (hasTextureStorage()) {
+            glTexStorage2D(GL_TEXTURE_2D, getLevelCount() - m_ResidentLevel, internalFormat, width, height);
+            return;
+        }
+
+        const bool compressed{ m_Format != PixelFormat::UNCOMPRESSED };
+
+        for (std::int32_t level{}; ; level++) {
+            if (compressed)
+                glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0,
+                                       static_cast<GLsizei>(TextureCompressor::GetLevelBytes(m_Format, width, height)), nullptr);
+            else
+                glTexImage2D(GL_TEXTURE_2D, level, static_cast<GLint>(internalFormat), width, height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+
+            if (width == 1 && height == 1)
+                break;
+
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+        }
     }
 
     auto Texture::fromData(const void *data, kT::Texture::TextureType type, std::int32_t width,
                            std::int32_t height) -> kT::Texture {
         Texture texture{ type, width, height };
+        texture.m_Channels = 4;
         stbi_set_flip_vertically_on_load(true);
 
         if (data != nullptr) {
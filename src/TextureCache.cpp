@@ -0,0 +1,96 @@
+// C++ Standard Library
+#include <system_error>
+#include <utility>
+
+// Project Libraries
+#include "OpenGL/TextureCache.hh"
+
+namespace kT {
+    std::unordered_map<TextureCache::Key, std::shared_ptr<Texture>, TextureCache::KeyHash> TextureCache::s_Textures{};
+    TextureCache::Stats TextureCache::s_Stats{};
+    std::mutex TextureCache::s_Mutex{};
+
+    auto TextureCache::MakeKey(const std::filesystem::path& path, Texture::TextureType type) -> Key {
+        // weakly_canonical does not require the file to exist, missing
+        // textures still get a stable key and fail later when decoded
+        std::error_code error{};
+        std::filesystem::path canonical{ std::filesystem::weakly_canonical(path, error) };
+
+        return Key{ error ? path.lexically_normal().string() : canonical.string(), type };
+    }
+
+    auto TextureCache::Contains(const Key& key) -> bool {
+        std::scoped_lock lock{ s_Mutex };
+        return s_Textures.contains(key);
+    }
+
+    auto TextureCache::Find(const Key& key) -> std::shared_ptr<Texture> {
+        std::scoped_lock lock{ s_Mutex };
+        auto it{ s_Textures.find(key) };
+        if (it == s_Textures.end())
+            return nullptr;
+
+        ++s_Stats.hits;
+        s_Stats.bytesSaved += it->second->getSizeInBytes();
+        return it->second;
+    }
+
+    auto TextureCache::Insert(const Key& key, Texture&& texture) -> std::shared_ptr<Texture> {
+        std::scoped_lock lock{ s_Mutex };
+        auto [it, inserted]{ s_Textures.try_emplace(key, nullptr) };
+
+        if (inserted) {
+            it->second = std::make_shared<Texture>(std::move(texture));
+            ++s_Stats.misses;
+        }
+
+        return it->second;
+    }
+
+    auto TextureCache::Load(const std::filesystem::path& path, Texture::TextureType type) -> std::shared_ptr<Texture> {
+        Key key{ MakeKey(path, type) };
+
+        if (auto texture{ Find(key) })
+            return texture;
+
+        return Insert(key, Texture::fromFile(path, type));
+    }
+
+    auto TextureCache::Purge() -> std::size_t {
+        std::scoped_lock lock{ s_Mutex };
+        std::size_t released{};
+
+        for (auto it{ s_Textures.begin() }; it != s_Textures.end();) {
+            if (it->second.use_count() == 1) {
+                it = s_Textures.erase(it);
+                ++released;
+            }
+            else
+                ++it;
+        }
+
+        return released;
+    }
+
+    auto TextureCache::Clear() -> void {
+        std::scoped_lock lock{ s_Mutex };
+        s_Textures.clear();
+        s_Stats = Stats{};
+    }
+
+    auto TextureCache::GetStats() -> Stats {
+        std::scoped_lock lock{ s_Mutex };
+
+        // summed on demand, streamed textures change size as their residency does
+        Stats stats{ s_Stats };
+        for (const auto& [key, texture] : s_Textures)
+            stats.bytesResident += texture->getSizeInBytes();
+
+        return stats;
+    }
+
+    auto TextureCache::GetSize() -> std::size_t {
+        std::scoped_lock lock{ s_Mutex };
+        return s_Textures.size();
+    }
+}
@@ -0,0 +1,538 @@
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define KATE_TEXTURE_COMPRESSOR_SSE2
+    #include <emmintrin.h>
+#endif
+
+// Project Libraries
+#include "Core/ThreadPool.hh"
+#include "OpenGL/MipGenerator.hh"
+#include "OpenGL/TextureCompressor.hh"
+
+namespace kT {
+    namespace {
+        using Color = std::array<float, 4>;
+
+        // the texels of a block split by channel, so four texels are matched against a palette at once
+        struct BlockTexels {
+            alignas(16) std::array<std::array<float, 16>, 4> channels{};
+        };
+
+        // interpolation weights of the sixteen BC7 levels, out of 64
+        constexpr std::array<std::uint32_t, 16> s_Bc7Weights{ 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        // gray is spread over RGB and missing alpha is opaque, as the swizzle of uncompressed textures reads them
+        auto expandTexel(const std::uint8_t* texel, std::int32_t channels, std::uint8_t* rgba) -> void {
+            switch (channels) {
+                case 1: rgba[0] = rgba[1] = rgba[2] = texel[0]; rgba[3] = 255; break;
+                case 2: rgba[0] = rgba[1] = rgba[2] = texel[0]; rgba[3] = texel[1]; break;
+                case 3: std::memcpy(rgba, texel, 3); rgba[3] = 255; break;
+                default: std::memcpy(rgba, texel, 4); break;
+            }
+        }
+
+        auto loadTexels(std::span<const std::uint8_t, 64> texels) -> BlockTexels {
+            BlockTexels result{};
+            for (std::size_t i{}; i < 16; i++) {
+                for (std::size_t c{}; c < 4; c++)
+                    result.channels[c][i] = static_cast<float>(texels[i * 4 + c]);
+            }
+
+            return result;
+        }
+
+        /**
+         * Finds the closest palette entry of every texel, comparing the first channelCount channels
+         * @returns sum of the squared distances
+         * */
+        auto matchPalette(const BlockTexels& texels, std::size_t channelCount, const Color* palette, std::size_t paletteSize,
+                          std::array<std::uint8_t, 16>& indices) -> float {
+            float total{};
+
+#ifdef KATE_TEXTURE_COMPRESSOR_SSE2
+            for (std::size_t first{}; first < 16; first += 4) {
+                __m128 best{ _mm_set1_ps(std::numeric_limits<float>::max()) };
+                __m128i bestIndex{ _mm_setzero_si128() };
+
+                for (std::size_t entry{}; entry < paletteSize; entry++) {
+                    __m128 distance{ _mm_setzero_ps() };
+                    for (std::size_t c{}; c < channelCount; c++) {
+                        const __m128 delta{ _mm_sub_ps(_mm_load_ps(texels.channels[c].data() + first), _mm_set1_ps(palette[entry][c])) };
+                        distance = _mm_add_ps(distance, _mm_mul_ps(delta, delta));
+                    }
+
+                    const __m128i closer{ _mm_castps_si128(_mm_cmplt_ps(distance, best)) };
+                    best = _mm_min_ps(distance, best);
+                    bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(static_cast<std::int32_t>(entry))), _mm_andnot_si128(closer, bestIndex));
+                }
+
+                alignas(16) std::array<float, 4> distances{};
+                alignas(16) std::array<std::int32_t, 4> lanes{};
+                _mm_store_ps(distances.data(), best);
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes.data()), bestIndex);
+
+                for (std::size_t lane{}; lane < 4; lane++) {
+                    indices[first + lane] = static_cast<std::uint8_t>(lanes[lane]);
+                    total += distances[lane];
+                }
+            }
+#else
+            for (std::size_t i{}; i < 16; i++) {
+                float best{ std::numeric_limits<float>::max() };
+
+                for (std::size_t entry{}; entry < paletteSize; entry++) {
+                    float distance{};
+                    for (std::size_t c{}; c < channelCount; c++) {
+                        const float delta{ texels.channels[c][i] - palette[entry][c] };
+                        distance += delta * delta;
+                    }
+
+                    if (distance < best) {
+                        best = distance;
+                        indices[i] = static_cast<std::uint8_t>(entry);
+                    }
+                }
+
+                total += best;
+            }
+#endif
+
+            return total;
+        }
+
+        /**
+         * Returns the direction the texels spread the most along, found by power iteration on their covariance
+         * @param mean receives the average texel
+         * */
+        auto principalAxis(const BlockTexels& texels, std::size_t channelCount, Color& mean) -> Color {
+            mean = {};
+            for (std::size_t c{}; c < channelCount; c++) {
+                for (const float value : texels.channels[c])
+                    mean[c] += value;
+
+                mean[c] /= 16.0f;
+            }
+
+            std::array<std::array<float, 4>, 4> covariance{};
+            for (std::size_t i{}; i < 16; i++) {
+                for (std::size_t a{}; a < channelCount; a++) {
+                    for (std::size_t b{}; b < channelCount; b++)
+                        covariance[a][b] += (texels.channels[a][i] - mean[a]) * (texels.channels[b][i] - mean[b]);
+                }
+            }
+
+            // starting from the bounding box diagonal converges in a few steps for most blocks
+            Color axis{};
+            for (std::size_t c{}; c < channelCount; c++) {
+                const auto [low, high]{ std::minmax_element(texels.channels[c].begin(), texels.channels[c].end()) };
+                axis[c] = *high - *low;
+            }
+
+            for (int iteration{}; iteration < 8; iteration++) {
+                Color next{};
+                for (std::size_t a{}; a < channelCount; a++) {
+                    for (std::size_t b{}; b < channelCount; b++)
+                        next[a] += covariance[a][b] * axis[b];
+                }
+
+                float largest{};
+                for (std::size_t c{}; c < channelCount; c++)
+                    largest = std::max(largest, std::abs(next[c]));
+
+                if (largest <= 0.0f)
+                    break;
+
+                for (std::size_t c{}; c < channelCount; c++)
+                    axis[c] = next[c] / largest;
+            }
+
+            float length{};
+            for (std::size_t c{}; c < channelCount; c++)
+                length += axis[c] * axis[c];
+
+            length = std::sqrt(length);
+            if (length <= 0.0f)
+                return Color{ 1.0f, 0.0f, 0.0f, 0.0f };
+
+            for (std::size_t c{}; c < channelCount; c++)
+                axis[c] /= length;
+
+            return axis;
+        }
+
+        // ends of the segment covering the projection of every texel on the axis
+        auto fitLine(const BlockTexels& texels, std::size_t channelCount) -> std::pair<Color, Color> {
+            Color mean{};
+            const Color axis{ principalAxis(texels, channelCount, mean) };
+
+            float low{ std::numeric_limits<float>::max() };
+            float high{ std::numeric_limits<float>::lowest() };
+            for (std::size_t i{}; i < 16; i++) {
+                float projection{};
+                for (std::size_t c{}; c < channelCount; c++)
+                    projection += (texels.channels[c][i] - mean[c]) * axis[c];
+
+                low = std::min(low, projection);
+                high = std::max(high, projection);
+            }
+
+            Color start{};
+            Color end{};
+            for (std::size_t c{}; c < channelCount; c++) {
+                start[c] = std::clamp(mean[c] + axis[c] * high, 0.0f, 255.0f);
+                end[c] = std::clamp(mean[c] + axis[c] * low, 0.0f, 255.0f);
+            }
+
+            return { start, end };
+        }
+
+        auto toRgb565(const Color& color) -> std::uint16_t {
+            const auto r{ static_cast<std::uint32_t>(std::lround(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f)) };
+            const auto g{ static_cast<std::uint32_t>(std::lround(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f)) };
+            const auto b{ static_cast<std::uint32_t>(std::lround(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f)) };
+            return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        auto fromRgb565(std::uint16_t packed) -> Color {
+            const std::uint32_t r{ static_cast<std::uint32_t>(packed >> 11) & 31 };
+            const std::uint32_t g{ static_cast<std::uint32_t>(packed >> 5) & 63 };
+            const std::uint32_t b{ static_cast<std::uint32_t>(packed) & 31 };
+            return { static_cast<float>((r << 3) | (r >> 2)), static_cast<float>((g << 2) | (g >> 4)), static_cast<float>((b << 3) | (b >> 2)), 0.0f };
+        }
+
+        struct ColorBlock {
+            std::uint16_t                   color0{};
+            std::uint16_t                   color1{};
+            std::array<std::uint8_t, 16>    indices{};
+            float                           error{ std::numeric_limits<float>::max() };
+        };
+
+        // always in the four color mode, the only one BC3 color blocks have
+        auto quantizeColor(const BlockTexels& texels, const Color& start, const Color& end) -> ColorBlock {
+            ColorBlock block{};
+            block.color0 = toRgb565(start);
+            block.color1 = toRgb565(end);
+            if (block.color0 < block.color1)
+                std::swap(block.color0, block.color1);
+
+            const Color color0{ fromRgb565(block.color0) };
+            const Color color1{ fromRgb565(block.color1) };
+            std::array<Color, 4> palette{ color0, color1 };
+            for (std::size_t c{}; c < 3; c++) {
+                palette[2][c] = (2.0f * color0[c] + color1[c]) / 3.0f;
+                palette[3][c] = (color0[c] + 2.0f * color1[c]) / 3.0f;
+            }
+
+            // equal endpoints decode as the three color mode in BC1, index 0 is the color in both modes
+            block.error = matchPalette(texels, 3, palette.data(), block.color0 == block.color1 ? 1 : 4, block.indices);
+            return block;
+        }
+
+        auto encodeColor(const BlockTexels& texels, std::uint8_t* out) -> void {
+            const auto [start, end]{ fitLine(texels, 3) };
+            ColorBlock best{ quantizeColor(texels, start, end) };
+
+            // least squares endpoints for the chosen indices, each texel a known mix of both
+            static constexpr std::array<float, 4> weights{ 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+            float aa{};
+            float ab{};
+            float bb{};
+            Color ax{};
+            Color bx{};
+
+            for (std::size_t i{}; i < 16; i++) {
+                const float a{ weights[best.indices[i]] };
+                const float b{ 1.0f - a };
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+
+                for (std::size_t c{}; c < 3; c++) {
+                    ax[c] += a * texels.channels[c][i];
+                    bx[c] += b * texels.channels[c][i];
+                }
+            }
+
+            const float determinant{ aa * bb - ab * ab };
+            if (std::abs(determinant) > 1e-6f) {
+                Color refinedStart{};
+                Color refinedEnd{};
+                for (std::size_t c{}; c < 3; c++) {
+                    refinedStart[c] = (bb * ax[c] - ab * bx[c]) / determinant;
+                    refinedEnd[c] = (aa * bx[c] - ab * ax[c]) / determinant;
+                }
+
+                if (ColorBlock refined{ quantizeColor(texels, refinedStart, refinedEnd) }; refined.error < best.error)
+                    best = refined;
+            }
+
+            std::uint32_t indices{};
+            for (std::size_t i{}; i < 16; i++)
+                indices |= static_cast<std::uint32_t>(best.indices[i]) << (i * 2);
+
+            std::memcpy(out, &best.color0, sizeof(best.color0));
+            std::memcpy(out + 2, &best.color1, sizeof(best.color1));
+            std::memcpy(out + 4, &indices, sizeof(indices));
+        }
+
+        // BC4 block of one channel, in the eight value mode
+        auto encodeChannel(const std::array<float, 16>& values, std::uint8_t* out) -> void {
+            const auto [lowest, highest]{ std::minmax_element(values.begin(), values.end()) };
+            const auto low{ static_cast<std::uint32_t>(std::lround(*lowest)) };
+            const auto high{ static_cast<std::uint32_t>(std::lround(*highest)) };
+
+            out[0] = static_cast<std::uint8_t>(high);
+            out[1] = static_cast<std::uint8_t>(low);
+
+            std::uint64_t indices{};
+            if (high > low) {
+                // index 0 is the high end, 1 the low end and 2 to 7 the steps from high to low
+                const float scale{ 7.0f / static_cast<float>(high - low) };
+                for (std::size_t i{}; i < 16; i++) {
+                    const auto step{ static_cast<std::uint64_t>(std::clamp(std::lround((values[i] - static_cast<float>(low)) * scale), 0L, 7L)) };
+                    const std::uint64_t code{ step == 7 ? 0 : step == 0 ? 1 : 8 - step };
+                    indices |= code << (i * 3);
+                }
+            }
+
+            for (std::size_t byte{}; byte < 6; byte++)
+                out[2 + byte] = static_cast<std::uint8_t>(indices >> (byte * 8));
+        }
+
+        struct BitWriter {
+            std::uint8_t* out{};
+            std::size_t position{};
+
+            auto write(std::uint32_t value, std::size_t bits) -> void {
+                for (std::size_t bit{}; bit < bits; bit++, position++) {
+                    if ((value >> bit) & 1)
+                        out[position / 8] |= static_cast<std::uint8_t>(1 << (position % 8));
+                }
+            }
+        };
+
+        // BC7 mode 6: one subset, 7 bit RGBA endpoints each with its own lowest bit, 4 bit indices
+        auto encodeBc7(const BlockTexels& texels, std::uint8_t* out) -> void {
+            const auto [start, end]{ fitLine(texels, 4) };
+
+            std::array<std::array<std::uint32_t, 4>, 2> endpoints{};
+            std::array<std::uint32_t, 2> pbits{};
+            const std::array<Color, 2> targets{ start, end };
+
+            for (std::size_t e{}; e < 2; e++) {
+                float bestError{ std::numeric_limits<float>::max() };
+
+                for (std::uint32_t pbit{}; pbit < 2; pbit++) {
+                    std::array<std::uint32_t, 4> quantized{};
+                    float error{};
+
+                    for (std::size_t c{}; c < 4; c++) {
+                        quantized[c] = static_cast<std::uint32_t>(std::clamp(std::lround((targets[e][c] - static_cast<float>(pbit)) / 2.0f), 0L, 127L));
+                        const float delta{ static_cast<float>((quantized[c] << 1) | pbit) - targets[e][c] };
+                        error += delta * delta;
+                    }
+
+                    if (error < bestError) {
+                        bestError = error;
+                        endpoints[e] = quantized;
+                        pbits[e] = pbit;
+                    }
+                }
+            }
+
+            std::array<Color, 16> palette{};
+            for (std::size_t level{}; level < 16; level++) {
+                for (std::size_t c{}; c < 4; c++) {
+                    const std::uint32_t value0{ (endpoints[0][c] << 1) | pbits[0] };
+                    const std::uint32_t value1{ (endpoints[1][c] << 1) | pbits[1] };
+                    palette[level][c] = static_cast<float>(((64 - s_Bc7Weights[level]) * value0 + s_Bc7Weights[level] * value1 + 32) >> 6);
+                }
+            }
+
+            std::array<std::uint8_t, 16> indices{};
+            matchPalette(texels, 4, palette.data(), palette.size(), indices);
+
+            // the first index is stored without its top bit, swapping the endpoints clears it
+            if (indices[0] >= 8) {
+                std::swap(endpoints[0], endpoints[1]);
+                std::swap(pbits[0], pbits[1]);
+                for (auto& index : indices)
+                    index = static_cast<std::uint8_t>(15 - index);
+            }
+
+            std::memset(out, 0, 16);
+            BitWriter writer{ out };
+            writer.write(1 << 6, 7);
+
+            for (std::size_t c{}; c < 4; c++) {
+                writer.write(endpoints[0][c], 7);
+                writer.write(endpoints[1][c], 7);
+            }
+
+            writer.write(pbits[0], 1);
+            writer.write(pbits[1], 1);
+
+            writer.write(indices[0], 3);
+            for (std::size_t i{ 1 }; i < 16; i++)
+                writer.write(indices[i], 4);
+        }
+    }
+
+    auto TextureCompressor::ChooseFormat(const Texture::ImageData& image, Texture::TextureType type) -> Texture::PixelFormat {
+        if (type == Texture::TextureType::NORMAL)
+            return Texture::PixelFormat::BC5;
+
+        // only gray and alpha or RGBA images have an alpha channel, the last one
+        if (image.channels != 2 && image.channels != 4)
+            return Texture::PixelFormat::BC1;
+
+        bool transparent{};
+        bool translucent{};
+        const std::size_t channels{ static_cast<std::size_t>(image.channels) };
+        const std::size_t texels{ static_cast<std::size_t>(image.width) * static_cast<std::size_t>(image.height) };
+
+        for (std::size_t i{}; i < texels && !translucent; i++) {
+            const std::uint8_t alpha{ image.pixels.get()[i * channels + channels - 1] };
+            transparent = transparent || alpha == 0;
+            translucent = alpha != 0 && alpha != 255;
+        }
+
+        if (translucent)
+            return Texture::PixelFormat::BC7;
+
+        return transparent ? Texture::PixelFormat::BC3 : Texture::PixelFormat::BC1;
+    }
+
+    auto TextureCompressor::Compress(Texture::ImageData& image, Texture::PixelFormat format) -> void {
+        if (format == Texture::PixelFormat::UNCOMPRESSED)
+            throw std::runtime_error("Could not compress texture, GL_RGBA8 is not a block compressed format");
+
+        if (!image.pixels || image.width <= 0 || image.height <= 0 || image.channels < 1 || image.channels > 4)
+            throw std::runtime_error("Could not compress texture, the image is empty");
+
+        if (image.mips.size() != MipGenerator::GetMipBytes(image.width, image.height, image.channels))
+            MipGenerator::Generate(image);
+
+        struct Level {
+            const std::uint8_t* texels{};
+            std::int32_t        width{};
+            std::int32_t        height{};
+            std::size_t         offset{};       // in the compressed blocks
+        };
+
+        std::vector<Level> levels{};
+        std::size_t texelOffset{};
+        std::size_t blockOffset{};
+
+        for (std::int32_t width{ image.width }, height{ image.height }; ; ) {
+            const std::uint8_t* texels{ levels.empty() ? image.pixels.get() : image.mips.data() + texelOffset };
+            if (!levels.empty())
+                texelOffset += static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * static_cast<std::size_t>(image.channels);
+
+            levels.push_back({ texels, width, height, blockOffset });
+            blockOffset += GetLevelBytes(format, width, height);
+
+            if (width == 1 && height == 1)
+                break;
+
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+        }
+
+        // one task per row of blocks of every level
+        std::vector<std::pair<std::size_t, std::int32_t>> rows{};
+        for (std::size_t level{}; level < levels.size(); level++) {
+            for (std::int32_t row{}; row < (levels[level].height + 3) / 4; row++)
+                rows.emplace_back(level, row);
+        }
+
+        image.blocks.assign(blockOffset, 0);
+        const std::size_t blockBytes{ GetBlockBytes(format) };
+        const std::int32_t channels{ image.channels };
+
+        ThreadPool::Get().parallelFor(rows.size(), [&](std::size_t task) -> void {
+            const Level& level{ levels[rows[task].first] };
+            const std::int32_t row{ rows[task].second };
+            const std::int32_t columns{ (level.width + 3) / 4 };
+
+            for (std::int32_t column{}; column < columns; column++) {
+                // blocks hanging over the edge of small levels repeat the last row and column
+                std::array<std::uint8_t, 64> texels{};
+                for (std::int32_t y{}; y < 4; y++) {
+                    for (std::int32_t x{}; x < 4; x++) {
+                        const std::int32_t sourceX{ std::min(column * 4 + x, level.width - 1) };
+                        const std::int32_t sourceY{ std::min(row * 4 + y, level.height - 1) };
+                        const std::size_t texel{ static_cast<std::size_t>(sourceY) * static_cast<std::size_t>(level.width) + static_cast<std::size_t>(sourceX) };
+                        expandTexel(level.texels + texel * static_cast<std::size_t>(channels), channels, texels.data() + (y * 4 + x) * 4);
+                    }
+                }
+
+                const std::size_t block{ static_cast<std::size_t>(row) * static_cast<std::size_t>(columns) + static_cast<std::size_t>(column) };
+                CompressBlock(texels, format, image.blocks.data() + level.offset + block * blockBytes);
+            }
+        });
+
+        image.format = format;
+    }
+
+    auto TextureCompressor::CompressBlock(std::span<const std::uint8_t, 64> texels, Texture::PixelFormat format, std::uint8_t* block) -> void {
+        const BlockTexels split{ loadTexels(texels) };
+
+        switch (format) {
+            case Texture::PixelFormat::BC1:
+                encodeColor(split, block);
+                break;
+            case Texture::PixelFormat::BC3:
+                encodeChannel(split.channels[3], block);
+                encodeColor(split, block + 8);
+                break;
+            case Texture::PixelFormat::BC5:
+                encodeChannel(split.channels[0], block);
+                encodeChannel(split.channels[1], block + 8);
+                break;
+            case Texture::PixelFormat::BC7:
+                encodeBc7(split, block);
+                break;
+            default:
+                throw std::runtime_error("Could not compress texture block, the format is not block compressed");
+        }
+    }
+
+    auto TextureCompressor::GetBlockBytes(Texture::PixelFormat format, std::int32_t channels) -> std::size_t {
+        switch (format) {
+            case Texture::PixelFormat::UNCOMPRESSED: return static_cast<std::size_t>(channels);
+            case Texture::PixelFormat::BC1: return 8;
+            default: return 16;
+        }
+    }
+
+    auto TextureCompressor::GetLevelBytes(Texture::PixelFormat format, std::int32_t width, std::int32_t height, std::int32_t channels) -> std::size_t {
+        if (format == Texture::PixelFormat::UNCOMPRESSED)
+            return static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * GetBlockBytes(format, channels);
+
+        return static_cast<std::size_t>((width + 3) / 4) * static_cast<std::size_t>((height + 3) / 4) * GetBlockBytes(format);
+    }
+
+    auto TextureCompressor::GetChainBytes(Texture::PixelFormat format, std::int32_t width, std::int32_t height, std::int32_t channels) -> std::size_t {
+        std::size_t bytes{};
+        while (width > 0 && height > 0) {
+            bytes += GetLevelBytes(format, width, height, channels);
+            if (width == 1 && height == 1)
+                break;
+
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+        }
+
+        return bytes;
+    }
+}
@@ -0,0 +1,175 @@
+// C++ Standard Library
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Project Libraries
+#include "OpenGL/TextureStreamer.hh"
+#include "OpenGL/TextureUploader.hh"
+
+namespace kT {
+    std::unordered_map<const Texture*, TextureStreamer::Entry> TextureStreamer::s_Entries{};
+    std::uint64_t TextureStreamer::s_Frame{};
+    std::size_t TextureStreamer::s_Budget{ 256 << 20 };
+    TextureStreamer::Stats TextureStreamer::s_Stats{};
+
+    auto TextureStreamer::GetInitialLevel(std::int32_t width, std::int32_t height) -> std::int32_t {
+        std::int32_t level{};
+        while (std::max(width, height) > s_InitialSize) {
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+            ++level;
+        }
+
+        return level;
+    }
+
+    auto TextureStreamer::Register(const std::shared_ptr<Texture>& texture) -> void {
+        if (!texture || !texture->isStreamed())
+            return;
+
+        // a texture freed since the last update may have left its entry at the same address
+        auto [it, inserted]{ s_Entries.try_emplace(texture.get(), Entry{ texture, std::numeric_limits<std::int32_t>::max(), s_Frame }) };
+        if (!inserted && it->second.texture.expired())
+            it->second = Entry{ texture, std::numeric_limits<std::int32_t>::max(), s_Frame };
+    }
+
+    auto TextureStreamer::Request(const Mesh& mesh, float coordinatesPerPixel) -> void {
+        for (const auto& texture : mesh.getTextures()) {
+            auto it{ s_Entries.find(texture.get()) };
+            if (it == s_Entries.end())
+                continue;
+
+            // the level whose texels are about one pixel wide, rounded to the sharper one
+            const auto [width, height]{ texture->getDimensions() };
+            const float texels{ coordinatesPerPixel * static_cast<float>(std::max(width, height)) };
+            const std::int32_t level{ texels > 1.0f ? static_cast<std::int32_t>(std::floor(std::log2(texels))) : 0 };
+
+            it->second.requested = std::min(it->second.requested, level);
+            it->second.lastUsed = s_Frame;
+        }
+    }
+
+    auto TextureStreamer::Update() -> void {
+        struct Streamed {
+            std::shared_ptr<Texture>    texture{};
+            Entry*                      entry{};
+        };
+
+        std::erase_if(s_Entries, [](const auto& entry) -> bool { return entry.second.texture.expired(); });
+
+        std::vector<Streamed> textures{};
+        textures.reserve(s_Entries.size());
+
+        std::size_t resident{};
+        s_Stats.requestedBytes = 0;
+        s_Stats.deferredRaises = 0;
+
+        for (auto& [key, entry] : s_Entries) {
+            Streamed streamed{ entry.texture.lock(), &entry };
+            const Texture& texture{ *streamed.texture };
+
+            resident += texture.getSizeInBytes();
+            s_Stats.requestedBytes += texture.getSizeInBytes(entry.lastUsed == s_Frame
+                                                             ? std::min(entry.requested, texture.getLevelCount() - 1)
+                                                             : GetInitialLevel(texture.getDimensions().first, texture.getDimensions().second));
+            textures.push_back(std::move(streamed));
+        }
+
+        // least recently seen first, their large levels go first
+        std::sort(textures.begin(), textures.end(), [](const Streamed& a, const Streamed& b) -> bool {
+            return a.entry->lastUsed < b.entry->lastUsed;
+        });
+
+        // brings the textures out of view down to their initial levels until the extra bytes fit
+        const auto evict{ [&](std::size_t extra) -> bool {
+            for (const Streamed& streamed : textures) {
+                if (resident + extra <= s_Budget || streamed.entry->lastUsed == s_Frame)
+                    break;
+
+                Texture& texture{ *streamed.texture };
+                const std::int32_t floor{ GetInitialLevel(texture.getDimensions().first, texture.getDimensions().second) };
+                if (texture.getResidentLevel() >= floor)
+                    continue;
+
+                s_Stats.evictedLevels += static_cast<std::size_t>(floor - texture.getResidentLevel());
+                resident -= texture.getSizeInBytes() - texture.getSizeInBytes(floor);
+                texture.setResidentLevel(floor);
+            }
+
+            return resident + extra <= s_Budget;
+        } };
+
+        // a lowered budget takes from the textures out of view, then a level at a time from the ones in view
+        if (!evict(0)) {
+            for (bool evicted{ true }; evicted && resident > s_Budget;) {
+                evicted = false;
+
+                for (const Streamed& streamed : textures) {
+                    Texture& texture{ *streamed.texture };
+                    if (resident <= s_Budget)
+                        break;
+
+                    if (texture.getResidentLevel() >= GetInitialLevel(texture.getDimensions().first, texture.getDimensions().second))
+                        continue;
+
+                    resident -= texture.getSizeInBytes() - texture.getSizeInBytes(texture.getResidentLevel() + 1);
+                    texture.setResidentLevel(texture.getResidentLevel() + 1);
+                    ++s_Stats.evictedLevels;
+                    evicted = true;
+                }
+            }
+        }
+
+        // textures in view lacking the most levels are raised first
+        std::vector<const Streamed*> raises{};
+        for (const Streamed& streamed : textures) {
+            if (streamed.entry->lastUsed == s_Frame && streamed.entry->requested < streamed.texture->getResidentLevel())
+                raises.push_back(&streamed);
+        }
+
+        std::sort(raises.begin(), raises.end(), [](const Streamed* a, const Streamed* b) -> bool {
+            return a->texture->getResidentLevel() - a->entry->requested > b->texture->getResidentLevel() - b->entry->requested;
+        });
+
+        std::size_t raised{};
+        for (const Streamed* streamed : raises) {
+            Texture& texture{ *streamed->texture };
+
+            // the levels of the previous raise are still on their way
+            if (raised == s_MaxRaisesPerFrame || TextureUploader::GetPendingLevel(texture.getId()) >= 0) {
+                ++s_Stats.deferredRaises;
+                continue;
+            }
+
+            // room is made from the textures out of view, otherwise it settles for the detail the budget allows
+            std::int32_t target{ std::max(streamed->entry->requested, 0) };
+            for (; target < texture.getResidentLevel(); target++) {
+                if (evict(texture.getSizeInBytes(target) - texture.getSizeInBytes()))
+                    break;
+            }
+
+            if (target != streamed->entry->requested)
+                ++s_Stats.deferredRaises;
+
+            if (target >= texture.getResidentLevel())
+                continue;
+
+            s_Stats.raisedLevels += static_cast<std::size_t>(texture.getResidentLevel() - target);
+            resident += texture.getSizeInBytes(target) - texture.getSizeInBytes();
+            texture.setResidentLevel(target);
+            ++raised;
+        }
+
+        s_Stats.textures = textures.size();
+        s_Stats.residentBytes = resident;
+        s_Stats.fullyResident = static_cast<std::size_t>(std::count_if(textures.begin(), textures.end(), [](const Streamed& streamed) -> bool {
+            return streamed.texture->getResidentLevel() == 0;
+        }));
+
+        for (auto& [key, entry] : s_Entries)
+            entry.requested = std::numeric_limits<std::int32_t>::max();
+
+        ++s_Frame;
+    }
+}
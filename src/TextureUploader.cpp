@@ -0,0 +1,288 @@
+// C++ Standard Library
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Project Libraries
+#include "OpenGL/MipGenerator.hh"
+#include "OpenGL/TextureCompressor.hh"
+#include "OpenGL/TextureUploader.hh"
+
+namespace kT {
+    std::deque<TextureUploader::Job> TextureUploader::s_Jobs{};
+    std::array<TextureUploader::Buffer, TextureUploader::s_BufferCount> TextureUploader::s_Buffers{};
+    std::size_t TextureUploader::s_BufferBytes{};
+    std::size_t TextureUploader::s_NextBuffer{};
+    std::size_t TextureUploader::s_FrameBudget{ 8 << 20 };
+    TextureUploader::Stats TextureUploader::s_Stats{};
+
+    namespace {
+        // offsets of pixel buffer sources, keeps every row band on a boundary any texel size divides
+        constexpr std::size_t s_Alignment{ 16 };
+
+        struct Level {
+            const std::uint8_t* data{};
+            std::int32_t        width{};
+            std::int32_t        height{};
+        };
+
+        // texels of a mip level, levels are laid out as kT::Texture::ImageData documents
+        auto getLevel(const Texture::ImageData& image, std::int32_t level) -> Level {
+            const bool compressed{ image.format != Texture::PixelFormat::UNCOMPRESSED };
+            const std::uint8_t* data{ compressed ? image.blocks.data() : image.pixels.get() };
+
+            std::int32_t width{ image.width };
+            std::int32_t height{ image.height };
+
+            for (std::int32_t current{}; current < level; current++) {
+                // uncompressed levels after the base one live in their own buffer
+                data = (!compressed && current == 0) ? image.mips.data()
+                                                     : data + TextureCompressor::GetLevelBytes(image.format, width, height, image.channels);
+                width = std::max(width / 2, 1);
+                height = std::max(height / 2, 1);
+            }
+
+            return { data, width, height };
+        }
+
+        // texel rows sent together, a row of blocks for compressed formats
+        auto getRowHeight(const Texture::ImageData& image) -> std::int32_t {
+            return image.format == Texture::PixelFormat::UNCOMPRESSED ? 1 : 4;
+        }
+
+        // uploads of a row band of a level out of the bound pixel buffer
+        struct Upload {
+            std::uint32_t   texture{};
+            GLenum          format{};
+            bool            compressed{};
+            std::int32_t    level{};
+            std::int32_t    y{};
+            std::int32_t    width{};
+            std::int32_t    height{};
+            std::size_t     offset{};
+            std::size_t     bytes{};
+            bool            complete{};     // last band of its level, the texture may sample it from now on
+        };
+
+        auto issue(const Upload& upload, const void* source) -> void {
+            glBindTexture(GL_TEXTURE_2D, upload.texture);
+
+            if (upload.compressed)
+                glCompressedTexSubImage2D(GL_TEXTURE_2D, upload.level, 0, upload.y, upload.width, upload.height,
+                                          upload.format, static_cast<GLsizei>(upload.bytes), source);
+            else
+                glTexSubImage2D(GL_TEXTURE_2D, upload.level, 0, upload.y, upload.width, upload.height,
+                                upload.format, GL_UNSIGNED_BYTE, source);
+
+            if (upload.complete)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, upload.level);
+        }
+    }
+
+    auto TextureUploader::Enqueue(Request&& request) -> void {
+        if (!request.image)
+            throw std::runtime_error("Could not upload Texture data. request has no image");
+
+        const Texture::ImageData& image{ *request.image };
+        const bool compressed{ image.format != Texture::PixelFormat::UNCOMPRESSED };
+
+        if (compressed && image.blocks.size() != TextureCompressor::GetChainBytes(image.format, image.width, image.height))
+            throw std::runtime_error("Could not upload Texture data. image blocks do not match its size");
+
+        if (!compressed && (!image.pixels || image.mips.size() != MipGenerator::GetMipBytes(image.width, image.height, image.channels)))
+            throw std::runtime_error("Could not upload Texture data. image has no pixels or mips");
+
+        const std::int32_t smallest{ MipGenerator::GetLevelCount(image.width, image.height) - 1 };
+        if (request.lastLevel < 0 || request.lastLevel > smallest)
+            request.lastLevel = smallest;
+
+        if (request.firstLevel < 0 || request.firstLevel > request.lastLevel)
+            throw std::runtime_error("Could not upload Texture data. requested levels are out of the mip chain");
+
+        // the smallest level takes a few bytes, sending it now leaves nothing undefined to sample
+        std::int32_t next{ request.lastLevel };
+        if (next == smallest) {
+            const Level level{ getLevel(image, smallest) };
+
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            issue({ .texture = request.texture, .format = request.format, .compressed = compressed, .level = smallest - request.firstLevel,
+                    .width = level.width, .height = level.height,
+                    .bytes = TextureCompressor::GetLevelBytes(image.format, level.width, level.height, image.channels),
+                    .complete = true }, level.data);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            glBindTexture(GL_TEXTURE_2D, 0);
+            --next;
+        }
+
+        if (next >= request.firstLevel)
+            s_Jobs.push_back({ std::move(request), next, 0 });
+    }
+
+    auto TextureUploader::Cancel(std::uint32_t texture) -> void {
+        if (texture == 0)
+            return;
+
+        std::erase_if(s_Jobs, [texture](const Job& job) -> bool { return job.request.texture == texture; });
+    }
+
+    auto TextureUploader::GetPendingLevel(std::uint32_t texture) -> std::int32_t {
+        const auto it{ std::find_if(s_Jobs.begin(), s_Jobs.end(), [texture](const Job& job) -> bool { return job.request.texture == texture; }) };
+        return it != s_Jobs.end() ? it->level - it->request.firstLevel : -1;
+    }
+
+    auto TextureUploader::Update() -> void {
+        send(false);
+    }
+
+    auto TextureUploader::Flush() -> void {
+        while (!s_Jobs.empty())
+            send(true);
+    }
+
+    auto TextureUploader::GetStats() -> Stats {
+        Stats stats{ s_Stats };
+        stats.pendingTextures = s_Jobs.size();
+
+        for (const Job& job : s_Jobs) {
+            const Texture::ImageData& image{ *job.request.image };
+
+            // what is left of the current level, then every level above it
+            const Level level{ getLevel(image, job.level) };
+            const std::int32_t rowHeight{ getRowHeight(image) };
+            stats.pendingBytes += TextureCompressor::GetLevelBytes(image.format, level.width, rowHeight, image.channels) *
+                                  static_cast<std::size_t>((level.height - job.row + rowHeight - 1) / rowHeight);
+
+            for (std::int32_t above{ job.request.firstLevel }; above < job.level; above++) {
+                const Level next{ getLevel(image, above) };
+                stats.pendingBytes += TextureCompressor::GetLevelBytes(image.format, next.width, next.height, image.channels);
+            }
+        }
+
+        return stats;
+    }
+
+    auto TextureUploader::createBuffers() -> void {
+        for (Buffer& buffer : s_Buffers) {
+            // the driver keeps the storage alive until pending uploads read it
+            if (buffer.fence != nullptr)
+                glDeleteSync(buffer.fence);
+            if (buffer.id != 0)
+                glDeleteBuffers(1, &buffer.id);
+
+            buffer = {};
+        }
+
+        s_BufferBytes = s_FrameBudget;
+        s_NextBuffer = 0;
+
+        for (Buffer& buffer : s_Buffers) {
+            glGenBuffers(1, &buffer.id);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.id);
+
+            if (GLEW_ARB_buffer_storage) {
+                constexpr GLbitfield access{ GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+
+                glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(s_BufferBytes), nullptr, access);
+                buffer.mapped = static_cast<std::byte*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(s_BufferBytes), access));
+            }
+            else {
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(s_BufferBytes), nullptr, GL_STREAM_DRAW);
+            }
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        KATE_LOGGER_INFO("Texture upload ring of {} buffers, {} bytes each. Persistently mapped: {}",
+                         s_BufferCount, s_BufferBytes, GLEW_ARB_buffer_storage ? "yes" : "no");
+    }
+
+    auto TextureUploader::send(bool wait) -> void {
+        if (s_Jobs.empty())
+            return;
+
+        if (s_BufferBytes != s_FrameBudget)
+            createBuffers();
+
+        Buffer& buffer{ s_Buffers[s_NextBuffer] };
+        if (buffer.fence != nullptr) {
+            // uploads of a few frames ago may still read this buffer, try again next frame instead of stalling this one
+            const GLenum status{ wait ? glClientWaitSync(buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max())
+                                      : glClientWaitSync(buffer.fence, 0, 0) };
+
+            if (status == GL_TIMEOUT_EXPIRED) {
+                s_Stats.stalledFrames++;
+                return;
+            }
+
+            glDeleteSync(buffer.fence);
+            buffer.fence = nullptr;
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.id);
+        std::byte* destination{ buffer.mapped != nullptr
+            ? buffer.mapped
+            : static_cast<std::byte*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(s_BufferBytes),
+                                                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT)) };
+
+        if (destination == nullptr) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            KATE_LOGGER_ERROR("Could not map texture upload buffer");
+            return;
+        }
+
+        // copy whole row bands until the buffer is full, a level may span several frames
+        std::vector<Upload> uploads{};
+        std::size_t used{};
+
+        while (!s_Jobs.empty()) {
+            Job& job{ s_Jobs.front() };
+            const Texture::ImageData& image{ *job.request.image };
+            const Level level{ getLevel(image, job.level) };
+
+            const std::int32_t rowHeight{ getRowHeight(image) };
+            const std::size_t rowBytes{ TextureCompressor::GetLevelBytes(image.format, level.width, rowHeight, image.channels) };
+            const std::int32_t rowsLeft{ (level.height - job.row + rowHeight - 1) / rowHeight };
+            const auto rows{ static_cast<std::int32_t>(std::min<std::size_t>((s_BufferBytes - used) / rowBytes, static_cast<std::size_t>(rowsLeft))) };
+
+            if (rows == 0)
+                break;
+
+            const std::size_t bytes{ rowBytes * static_cast<std::size_t>(rows) };
+            const std::int32_t height{ std::min(rows * rowHeight, level.height - job.row) };
+
+            std::memcpy(destination + used, level.data + rowBytes * static_cast<std::size_t>(job.row / rowHeight), bytes);
+            uploads.push_back({ .texture = job.request.texture, .format = job.request.format,
+                                .compressed = image.format != Texture::PixelFormat::UNCOMPRESSED, .level = job.level - job.request.firstLevel,
+                                .y = job.row, .width = level.width, .height = height, .offset = used, .bytes = bytes,
+                                .complete = job.row + height == level.height });
+
+            used = std::min((used + bytes + s_Alignment - 1) / s_Alignment * s_Alignment, s_BufferBytes);
+            s_Stats.uploadedBytes += bytes;
+            job.row += height;
+
+            if (job.row == level.height) {
+                job.row = 0;
+
+                // texels are in the pixel buffer now, the client copy can go
+                if (--job.level < job.request.firstLevel)
+                    s_Jobs.pop_front();
+            }
+        }
+
+        if (buffer.mapped == nullptr)
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        // with a pixel buffer bound the source pointer is an offset into it
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (const Upload& upload : uploads)
+            issue(upload, reinterpret_cast<const void*>(upload.offset));
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        s_NextBuffer = (s_NextBuffer + 1) % s_BufferCount;
+    }
+}
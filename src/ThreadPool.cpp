@@ -0,0 +1,52 @@
+// C++ Standard Library
+#include <algorithm>
+
+// Project Libraries
+#include "Core/ThreadPool.hh"
+
+namespace kT {
+    ThreadPool::ThreadPool(std::size_t threadCount) {
+        if (threadCount == 0)
+            threadCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+        m_Workers.reserve(threadCount);
+        for (std::size_t i{}; i < threadCount; i++)
+            m_Workers.emplace_back([this]() -> void { workerLoop(); });
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::scoped_lock lock{ m_Mutex };
+            m_Stopping = true;
+        }
+
+        m_Condition.notify_all();
+        for (auto& worker : m_Workers)
+            worker.join();
+    }
+
+    auto ThreadPool::Get() -> ThreadPool& {
+        static ThreadPool pool{};
+        return pool;
+    }
+
+    auto ThreadPool::workerLoop() -> void {
+        while (true) {
+            std::function<void()> task{};
+
+            {
+                std::unique_lock lock{ m_Mutex };
+                m_Condition.wait(lock, [this]() -> bool { return m_Stopping || !m_Tasks.empty(); });
+
+                // drain the queue before leaving so no future is left without a value
+                if (m_Stopping && m_Tasks.empty())
+                    return;
+
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop();
+            }
+
+            task();
+        }
+    }
+}
@@ -34,11 +34,11 @@ namespace kT {
         glGenVertexArrays(1, &m_Id);
     }
 
-    auto VertexArray::useVertexBuffer(const VertexBuffer &buffer) -> void {
+    auto VertexArray::useVertexBuffer(const VertexBuffer &buffer, std::uint32_t firstAttribute) -> void {
         bind();
         buffer.bind();
 
-        std::uint32_t index{};
+        std::uint32_t index{ firstAttribute };
         for (const auto&i: buffer.getBufferLayout()) {
             glEnableVertexAttribArray(index);
             glVertexAttribPointer(index, i.getAttributeCount(), i.getOpenGLAttributeDataType(),
@@ -1,7 +1,10 @@
 #include "OpenGL/VertexBuffer.hh"
 
 namespace kT {
-    VertexBuffer::VertexBuffer(const std::vector<float>& vertices, const BufferLayout& bufferLayout, GLenum usage) {
+    VertexBuffer::VertexBuffer(const std::vector<float>& vertices, const BufferLayout& bufferLayout, GLenum usage)
+        :   VertexBuffer{ std::span<const float>{ vertices }, bufferLayout, usage } {}
+
+    VertexBuffer::VertexBuffer(std::span<const float> vertices, const BufferLayout& bufferLayout, GLenum usage) {
         glCreateBuffers(1, &m_Id);
         m_ValidId = m_Id != 0;
         m_Layout = bufferLayout;
@@ -11,23 +14,30 @@ namespace kT {
 
 
     VertexBuffer::VertexBuffer(VertexBuffer && other) noexcept
-        :   m_Id{ other.m_Id }, m_Layout{ std::move(other.m_Layout) }, m_ValidId{ other.m_ValidId }, m_Size{ other.m_Size }
+        :   m_Id{ other.m_Id }, m_Layout{ std::move(other.m_Layout) }, m_ValidId{ other.m_ValidId }, m_Size{ other.m_Size }, m_Mapped{ other.m_Mapped }
     {
 
         other.m_Id = 0;
         other.m_Size = 0;
+        other.m_Mapped = nullptr;
     }
 
     auto VertexBuffer::operator=(VertexBuffer && other) noexcept -> VertexBuffer & {
         m_Id = other.getId();
         m_Size = other.getSize();
+        m_Mapped = other.m_Mapped;
 
         other.m_Id = 0;
         other.m_Size = 0;
+        other.m_Mapped = nullptr;
         return *this;
     }
 
     auto VertexBuffer::load(const std::vector<float> &vertices, GLenum usage) -> void {
+        load(std::span<const float>{ vertices }, usage);
+    }
+
+    auto VertexBuffer::load(std::span<const float> vertices, GLenum usage) -> void {
         if (!m_ValidId) {
             glCreateBuffers(1, &m_Id);
             m_ValidId = m_Id != 0;
@@ -35,10 +45,44 @@ namespace kT {
 
         if (!vertices.empty()) {
             bind();
-            m_Size = vertices.size() * sizeof(float);
+            m_Size = vertices.size_bytes();
             glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_Size), vertices.data(), usage);
             unbind();
         }
     }
 
+    auto VertexBuffer::reserve(std::size_t bytes, bool mapped) -> void {
+        if (!m_ValidId) {
+            glCreateBuffers(1, &m_Id);
+            m_ValidId = m_Id != 0;
+        }
+
+        bind();
+        m_Size = static_cast<std::uint32_t>(bytes);
+
+        if (GLEW_ARB_buffer_storage && mapped) {
+            constexpr GLbitfield access{ GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+
+            glBufferStorage(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_DYNAMIC_STORAGE_BIT | access);
+            m_Mapped = static_cast<std::byte*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), access));
+        }
+        else if (GLEW_ARB_buffer_storage)
+            glBufferStorage(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_DYNAMIC_STORAGE_BIT);
+        else
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STATIC_DRAW);
+
+        unbind();
+    }
+
+    auto VertexBuffer::update(std::size_t offset, std::span<const float> vertices) const -> void {
+        update(offset, std::as_bytes(vertices));
+    }
+
+    auto VertexBuffer::update(std::size_t offset, std::span<const std::byte> vertices) const -> void {
+        if (!vertices.empty()) {
+            bind();
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(vertices.size()), vertices.data());
+            unbind();
+        }
+    }
 }
\ No newline at end of file
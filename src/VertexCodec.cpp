@@ -0,0 +1,338 @@
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define KATE_VERTEX_CODEC_SSE2
+    #include <emmintrin.h>
+#endif
+
+// Project Libraries
+#include "OpenGL/VertexCodec.hh"
+
+namespace kT {
+    namespace {
+        // vertices per block, every byte of the vertex has one row of deltas per block
+        constexpr std::size_t s_BlockVertices{ 256 };
+
+        // deltas sharing one bit width
+        constexpr std::size_t s_GroupSize{ 16 };
+
+        // bytes a group of deltas takes for each width code: zero, two, four and eight bits per delta
+        constexpr std::array<std::size_t, 4> s_GroupBytes{ 0, 4, 8, 16 };
+
+        // small negative deltas become small positive numbers, so they need few bits
+        auto zigzag(std::uint8_t delta) -> std::uint8_t {
+            return static_cast<std::uint8_t>((delta << 1) ^ static_cast<std::uint8_t>(static_cast<std::int8_t>(delta) >> 7));
+        }
+
+        auto unzigzag(std::uint8_t value) -> std::uint8_t {
+            return static_cast<std::uint8_t>((value >> 1) ^ static_cast<std::uint8_t>(-(value & 1)));
+        }
+
+        auto encodeGroup(const std::uint8_t* deltas, std::vector<std::byte>& out) -> std::uint8_t {
+            const std::uint8_t largest{ *std::max_element(deltas, deltas + s_GroupSize) };
+            const std::uint8_t code{ static_cast<std::uint8_t>(largest == 0 ? 0 : largest < 4 ? 1 : largest < 16 ? 2 : 3) };
+
+            // element i of a group of two bit deltas is in byte i / 4 at bit 2 * (i % 4), and so on
+            std::array<std::uint8_t, s_GroupSize> packed{};
+            for (std::size_t i{}; i < s_GroupSize; i++) {
+                if (code == 1)
+                    packed[i / 4] |= static_cast<std::uint8_t>(deltas[i] << (i % 4 * 2));
+                else if (code == 2)
+                    packed[i / 2] |= static_cast<std::uint8_t>(deltas[i] << (i % 2 * 4));
+                else
+                    packed[i] = deltas[i];
+            }
+
+            const auto* bytes{ reinterpret_cast<const std::byte*>(packed.data()) };
+            out.insert(out.end(), bytes, bytes + s_GroupBytes[code]);
+            return code;
+        }
+
+#ifdef KATE_VERTEX_CODEC_SSE2
+        auto load32(const std::uint8_t* data) -> __m128i {
+            std::int32_t value{};
+            std::memcpy(&value, data, sizeof(value));
+            return _mm_cvtsi32_si128(value);
+        }
+
+        auto unzigzag(__m128i value) -> __m128i {
+            const __m128i halved{ _mm_and_si128(_mm_srli_epi16(value, 1), _mm_set1_epi8(0x7F)) };
+            return _mm_xor_si128(halved, _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(value, _mm_set1_epi8(1))));
+        }
+
+        // spreads the packed deltas of a group over 16 bytes, shifts are 16 bit wide but the masks keep every byte apart
+        auto unpackGroup(const std::uint8_t* data, std::uint8_t code, std::uint8_t* out) -> void {
+            __m128i result{};
+
+            if (code == 1) {
+                const __m128i packed{ load32(data) };
+                const __m128i mask{ _mm_set1_epi8(3) };
+                const __m128i bits0{ _mm_and_si128(packed, mask) };
+                const __m128i bits2{ _mm_and_si128(_mm_srli_epi16(packed, 2), mask) };
+                const __m128i bits4{ _mm_and_si128(_mm_srli_epi16(packed, 4), mask) };
+                const __m128i bits6{ _mm_and_si128(_mm_srli_epi16(packed, 6), mask) };
+                result = _mm_unpacklo_epi16(_mm_unpacklo_epi8(bits0, bits2), _mm_unpacklo_epi8(bits4, bits6));
+            }
+            else if (code == 2) {
+                const __m128i packed{ _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data)) };
+                const __m128i mask{ _mm_set1_epi8(15) };
+                result = _mm_unpacklo_epi8(_mm_and_si128(packed, mask), _mm_and_si128(_mm_srli_epi16(packed, 4), mask));
+            }
+            else if (code == 3) {
+                result = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), result);
+        }
+
+        // rows[j] lane i becomes rows[i] lane j
+        auto transpose(__m128i* rows) -> void {
+            __m128i bytes[16]{};
+            for (std::size_t pair{}; pair < 8; pair++) {
+                bytes[pair] = _mm_unpacklo_epi8(rows[2 * pair], rows[2 * pair + 1]);
+                bytes[pair + 8] = _mm_unpackhi_epi8(rows[2 * pair], rows[2 * pair + 1]);
+            }
+
+            // words[4 * c + q] holds rows 4q to 4q + 3 of the columns 4c to 4c + 3
+            __m128i words[16]{};
+            for (std::size_t half{}; half < 2; half++) {
+                for (std::size_t quad{}; quad < 4; quad++) {
+                    const __m128i low{ bytes[half * 8 + 2 * quad] };
+                    const __m128i high{ bytes[half * 8 + 2 * quad + 1] };
+                    words[half * 8 + quad] = _mm_unpacklo_epi16(low, high);
+                    words[half * 8 + quad + 4] = _mm_unpackhi_epi16(low, high);
+                }
+            }
+
+            for (std::size_t column{}; column < 4; column++) {
+                const __m128i* quads{ words + column * 4 };
+                const __m128i top0{ _mm_unpacklo_epi32(quads[0], quads[1]) };
+                const __m128i top1{ _mm_unpackhi_epi32(quads[0], quads[1]) };
+                const __m128i bottom0{ _mm_unpacklo_epi32(quads[2], quads[3]) };
+                const __m128i bottom1{ _mm_unpackhi_epi32(quads[2], quads[3]) };
+
+                rows[column * 4] = _mm_unpacklo_epi64(top0, bottom0);
+                rows[column * 4 + 1] = _mm_unpackhi_epi64(top0, bottom0);
+                rows[column * 4 + 2] = _mm_unpacklo_epi64(top1, bottom1);
+                rows[column * 4 + 3] = _mm_unpackhi_epi64(top1, bottom1);
+            }
+        }
+#else
+        auto unpackGroup(const std::uint8_t* data, std::uint8_t code, std::uint8_t* out) -> void {
+            for (std::size_t i{}; i < s_GroupSize; i++) {
+                if (code == 0)
+                    out[i] = 0;
+                else if (code == 1)
+                    out[i] = static_cast<std::uint8_t>((data[i / 4] >> (i % 4 * 2)) & 3);
+                else if (code == 2)
+                    out[i] = static_cast<std::uint8_t>((data[i / 2] >> (i % 2 * 4)) & 15);
+                else
+                    out[i] = data[i];
+            }
+        }
+#endif
+    }
+
+    auto VertexCodec::EncodeVertices(std::span<const std::byte> vertices, std::size_t stride) -> std::vector<std::byte> {
+        if (stride == 0 || stride % 4 != 0 || stride > s_MaxStride || vertices.size() % stride != 0)
+            throw std::runtime_error("Vertices of " + std::to_string(stride) + " bytes can not be encoded");
+
+        const auto* data{ reinterpret_cast<const std::uint8_t*>(vertices.data()) };
+        const std::size_t vertexCount{ vertices.size() / stride };
+
+        std::vector<std::byte> out{};
+        out.reserve(vertices.size() / 2);
+
+        std::array<std::uint8_t, s_MaxStride> last{};
+        std::array<std::uint8_t, s_BlockVertices> deltas{};
+
+        for (std::size_t first{}; first < vertexCount; first += s_BlockVertices) {
+            const std::size_t count{ std::min(s_BlockVertices, vertexCount - first) };
+            const std::size_t groups{ (count + s_GroupSize - 1) / s_GroupSize };
+
+            for (std::size_t k{}; k < stride; k++) {
+                // the padding of the last group decodes to repeats of the last vertex, never stored
+                deltas.fill(0);
+                for (std::size_t i{}; i < count; i++) {
+                    const std::uint8_t value{ data[(first + i) * stride + k] };
+                    deltas[i] = zigzag(static_cast<std::uint8_t>(value - last[k]));
+                    last[k] = value;
+                }
+
+                // two bits of width code per group, the groups follow
+                const std::size_t header{ out.size() };
+                out.resize(out.size() + (groups + 3) / 4);
+
+                for (std::size_t group{}; group < groups; group++) {
+                    const std::uint8_t code{ encodeGroup(deltas.data() + group * s_GroupSize, out) };
+                    out[header + group / 4] |= static_cast<std::byte>(code << (group % 4 * 2));
+                }
+            }
+        }
+
+        return out;
+    }
+
+    auto VertexCodec::DecodeVertices(std::span<const std::byte> encoded, std::size_t stride, std::span<std::byte> vertices) -> bool {
+        if (stride == 0 || stride % 4 != 0 || stride > s_MaxStride || vertices.size() % stride != 0)
+            return false;
+
+        const auto* data{ reinterpret_cast<const std::uint8_t*>(encoded.data()) };
+        auto* out{ reinterpret_cast<std::uint8_t*>(vertices.data()) };
+        const std::size_t vertexCount{ vertices.size() / stride };
+        std::size_t position{};
+
+        // zigzagged deltas of the block, one row per byte of the vertex
+        std::vector<std::uint8_t> rows(stride * s_BlockVertices);
+        alignas(16) std::array<std::uint8_t, s_MaxStride> last{};
+
+        for (std::size_t first{}; first < vertexCount; first += s_BlockVertices) {
+            const std::size_t count{ std::min(s_BlockVertices, vertexCount - first) };
+            const std::size_t groups{ (count + s_GroupSize - 1) / s_GroupSize };
+            const std::size_t headerBytes{ (groups + 3) / 4 };
+
+            for (std::size_t k{}; k < stride; k++) {
+                if (encoded.size() - position < headerBytes)
+                    return false;
+
+                const std::uint8_t* header{ data + position };
+                position += headerBytes;
+
+                for (std::size_t group{}; group < groups; group++) {
+                    const auto code{ static_cast<std::uint8_t>((header[group / 4] >> (group % 4 * 2)) & 3) };
+                    if (encoded.size() - position < s_GroupBytes[code])
+                        return false;
+
+                    unpackGroup(data + position, code, rows.data() + k * s_BlockVertices + group * s_GroupSize);
+                    position += s_GroupBytes[code];
+                }
+            }
+
+            std::uint8_t* block{ out + first * stride };
+            std::size_t k{};
+
+#ifdef KATE_VERTEX_CODEC_SSE2
+            // sixteen bytes of sixteen vertices at a time: transpose the rows back into vertices, then sum the deltas
+            for (; k + 16 <= stride; k += 16) {
+                __m128i sum{ _mm_load_si128(reinterpret_cast<const __m128i*>(last.data() + k)) };
+
+                for (std::size_t vertex{}; vertex < count; vertex += s_GroupSize) {
+                    __m128i lanes[16]{};
+                    for (std::size_t j{}; j < 16; j++)
+                        lanes[j] = unzigzag(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rows.data() + (k + j) * s_BlockVertices + vertex)));
+
+                    transpose(lanes);
+
+                    const std::size_t vertices{ std::min(s_GroupSize, count - vertex) };
+                    for (std::size_t i{}; i < vertices; i++) {
+                        sum = _mm_add_epi8(sum, lanes[i]);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(block + (vertex + i) * stride + k), sum);
+                    }
+                }
+
+                _mm_store_si128(reinterpret_cast<__m128i*>(last.data() + k), sum);
+            }
+#endif
+
+            for (; k < stride; k++) {
+                const std::uint8_t* row{ rows.data() + k * s_BlockVertices };
+                std::uint8_t sum{ last[k] };
+
+                for (std::size_t i{}; i < count; i++) {
+                    sum = static_cast<std::uint8_t>(sum + unzigzag(row[i]));
+                    block[i * stride + k] = sum;
+                }
+
+                last[k] = sum;
+            }
+        }
+
+        return position == encoded.size();
+    }
+
+    auto VertexCodec::EncodeIndices(std::span<const std::uint32_t> indices) -> std::vector<std::byte> {
+        std::vector<std::byte> out{};
+        out.reserve(indices.size() + indices.size() / 2);
+
+        std::uint32_t last{};
+        for (const std::uint32_t index : indices) {
+            const std::uint32_t delta{ index - last };
+            std::uint32_t value{ (delta << 1) ^ static_cast<std::uint32_t>(static_cast<std::int32_t>(delta) >> 31) };
+            last = index;
+
+            // seven bits per byte, the high bit set on every byte but the last
+            while (value >= 0x80) {
+                out.push_back(static_cast<std::byte>(value | 0x80));
+                value >>= 7;
+            }
+
+            out.push_back(static_cast<std::byte>(value));
+        }
+
+        return out;
+    }
+
+    auto VertexCodec::DecodeIndices(std::span<const std::byte> encoded, std::span<std::uint32_t> indices) -> bool {
+        const auto* data{ reinterpret_cast<const std::uint8_t*>(encoded.data()) };
+        std::size_t position{};
+        std::size_t i{};
+        std::uint32_t last{};
+
+        while (i < indices.size()) {
+#ifdef KATE_VERTEX_CODEC_SSE2
+            // on optimized meshes most deltas fit a single byte, sixteen of those are decoded at once
+            if (indices.size() - i >= 16 && encoded.size() - position >= 16) {
+                const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position)) };
+
+                if (_mm_movemask_epi8(bytes) == 0) {
+                    const __m128i zero{ _mm_setzero_si128() };
+                    const __m128i one{ _mm_set1_epi32(1) };
+                    const __m128i low{ _mm_unpacklo_epi8(bytes, zero) };
+                    const __m128i high{ _mm_unpackhi_epi8(bytes, zero) };
+                    const __m128i values[4]{ _mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero),
+                                             _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero) };
+
+                    __m128i previous{ _mm_set1_epi32(static_cast<std::int32_t>(last)) };
+                    for (const __m128i value : values) {
+                        __m128i delta{ _mm_xor_si128(_mm_srli_epi32(value, 1), _mm_sub_epi32(zero, _mm_and_si128(value, one))) };
+                        delta = _mm_add_epi32(delta, _mm_slli_si128(delta, 4));
+                        delta = _mm_add_epi32(delta, _mm_slli_si128(delta, 8));
+
+                        previous = _mm_add_epi32(delta, previous);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices.data() + i), previous);
+                        previous = _mm_shuffle_epi32(previous, _MM_SHUFFLE(3, 3, 3, 3));
+                        i += 4;
+                    }
+
+                    last = static_cast<std::uint32_t>(_mm_cvtsi128_si32(previous));
+                    position += 16;
+                    continue;
+                }
+            }
+#endif
+
+            std::uint32_t value{};
+            for (std::uint32_t shift{}; ; shift += 7) {
+                // a 32 bit value takes five bytes at most
+                if (position == encoded.size() || shift > 28)
+                    return false;
+
+                const std::uint8_t byte{ data[position++] };
+                value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+
+                if ((byte & 0x80) == 0)
+                    break;
+            }
+
+            last += (value >> 1) ^ static_cast<std::uint32_t>(-static_cast<std::int32_t>(value & 1));
+            indices[i++] = last;
+        }
+
+        return position == encoded.size();
+    }
+}
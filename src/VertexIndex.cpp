@@ -6,6 +6,9 @@ namespace kT {
     }
 
     ElementBuffer::ElementBuffer(const std::vector<std::uint32_t>& indices, GLenum usage)
+            : ElementBuffer{ std::span<const std::uint32_t>{ indices }, usage } {}
+
+    ElementBuffer::ElementBuffer(std::span<const std::uint32_t> indices, GLenum usage)
             : m_Id{}, m_Count{}
     {
         glGenBuffers(1, &this->m_Id);
@@ -33,27 +36,70 @@ namespace kT {
     }
 
     auto ElementBuffer::load(const std::vector<std::uint32_t>& indices, GLenum usage) -> void {
+        load(std::span<const std::uint32_t>{ indices }, usage);
+    }
+
+    auto ElementBuffer::load(std::span<const std::uint32_t> indices, GLenum usage) -> void {
         if (!indices.empty()) {
             bind();
-            m_Count = indices.size() * sizeof(std::uint32_t);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_Count, indices.data(), usage);
+            m_Count = indices.size();
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size_bytes()), indices.data(), usage);
             unbind();
         }
     }
 
     ElementBuffer::ElementBuffer(ElementBuffer &&other) noexcept
-        :   m_Id{ other.getId() }, m_Count{ other.getCount() }
+        :   m_Id{ other.getId() }, m_Count{ other.getCount() }, m_Mapped{ other.m_Mapped }
     {
         other.m_Id = 0;
         other.m_Count = 0;
+        other.m_Mapped = nullptr;
     }
 
     auto ElementBuffer::operator=(ElementBuffer&& other) noexcept -> ElementBuffer& {
         m_Id = other.getId();
         m_Count = other.getCount();
+        m_Mapped = other.m_Mapped;
 
         other.m_Id = 0;
         other.m_Count = 0;
+        other.m_Mapped = nullptr;
         return *this;
     }
+
+    auto ElementBuffer::reserve(std::size_t count, bool mapped) -> void {
+        const auto bytes{ static_cast<GLsizeiptr>(count * sizeof(std::uint32_t)) };
+
+        bind();
+        m_Count = count;
+
+        if (GLEW_ARB_buffer_storage && mapped) {
+            constexpr GLbitfield access{ GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+
+            glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, bytes, nullptr, GL_DYNAMIC_STORAGE_BIT | access);
+            m_Mapped = static_cast<std::byte*>(glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, bytes, access));
+        }
+        else if (GLEW_ARB_buffer_storage)
+            glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, bytes, nullptr, GL_DYNAMIC_STORAGE_BIT);
+        else
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, bytes, nullptr, GL_STATIC_DRAW);
+
+        unbind();
+    }
+
+    auto ElementBuffer::update(std::size_t offset, std::span<const std::uint32_t> indices) const -> void {
+        update(offset, indices.data(), indices.size_bytes());
+    }
+
+    auto ElementBuffer::update(std::size_t offset, std::span<const std::uint16_t> indices) const -> void {
+        update(offset, indices.data(), indices.size_bytes());
+    }
+
+    auto ElementBuffer::update(std::size_t offset, const void* data, std::size_t bytes) const -> void {
+        if (bytes != 0) {
+            bind();
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), data);
+            unbind();
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,167 @@
+// C++ Standard Library
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// Project Libraries
+#include "OpenGL/VertexQuantizer.hh"
+
+namespace kT {
+    namespace {
+        // kT::VertexFormat::COMPACT vertex, must match kT::Mesh::GetLayout(VertexFormat::COMPACT)
+        struct CompactVertex {
+            std::uint16_t position[4];
+            std::uint32_t normal;
+            std::uint16_t textureCoordinates[2];
+        };
+
+        static_assert(sizeof(CompactVertex) == 16);
+
+        constexpr std::size_t s_StandardFloats{ 8 };
+    }
+
+    auto VertexQuantizer::Quantize(std::span<const float> vertices) -> QuantizedVertices {
+        const std::size_t vertexCount{ vertices.size() / s_StandardFloats };
+
+        QuantizedVertices result{};
+        result.data.resize(vertexCount * sizeof(CompactVertex));
+
+        if (vertexCount == 0)
+            return result;
+
+        glm::vec3 minimum{ std::numeric_limits<float>::max() };
+        glm::vec3 maximum{ std::numeric_limits<float>::lowest() };
+
+        for (std::size_t i{}; i < vertexCount; i++) {
+            for (int axis{}; axis < 3; axis++) {
+                minimum[axis] = std::min(minimum[axis], vertices[i * s_StandardFloats + axis]);
+                maximum[axis] = std::max(maximum[axis], vertices[i * s_StandardFloats + axis]);
+            }
+        }
+
+        // flat axes keep a scale of one so the stored zero maps back to the minimum
+        glm::vec3 extent{ 1.0f };
+        for (int axis{}; axis < 3; axis++) {
+            if (maximum[axis] > minimum[axis])
+                extent[axis] = maximum[axis] - minimum[axis];
+        }
+
+        result.transform.offset = minimum;
+        result.transform.scale = extent;
+
+        for (std::size_t i{}; i < vertexCount; i++) {
+            const float* source{ vertices.data() + i * s_StandardFloats };
+            CompactVertex vertex{};
+
+            for (int axis{}; axis < 3; axis++) {
+                const float normalized{ std::clamp((source[axis] - minimum[axis]) / extent[axis], 0.0f, 1.0f) };
+                vertex.position[axis] = static_cast<std::uint16_t>(std::lround(normalized * 65535.0f));
+            }
+
+            vertex.normal = PackNormal(glm::vec3(source[3], source[4], source[5]));
+            vertex.textureCoordinates[0] = FloatToHalf(source[6]);
+            vertex.textureCoordinates[1] = FloatToHalf(source[7]);
+
+            std::memcpy(result.data.data() + i * sizeof(CompactVertex), &vertex, sizeof(CompactVertex));
+        }
+
+        return result;
+    }
+
+    auto VertexQuantizer::FloatToHalf(float value) -> std::uint16_t {
+        const auto bits{ std::bit_cast<std::uint32_t>(value) };
+        const auto sign{ static_cast<std::uint16_t>((bits >> 16) & 0x8000u) };
+        const std::uint32_t magnitude{ bits & 0x7fffffffu };
+
+        // NaN keeps a quiet payload, infinity and overflow saturate to infinity
+        if (magnitude > 0x7f800000u)
+            return sign | 0x7e00u;
+
+        if (magnitude >= 0x477ff000u)
+            return sign | 0x7c00u;
+
+        // too small even for a subnormal half
+        if (magnitude < 0x33000000u)
+            return sign;
+
+        std::uint32_t exponent{ magnitude >> 23 };
+        std::uint32_t mantissa{ magnitude & 0x7fffffu };
+        std::uint32_t shift{};
+
+        if (exponent < 113) {
+            // subnormal half, make the implicit bit explicit and shift it into place
+            mantissa |= 0x800000u;
+            shift = 126 - exponent;
+            exponent = 0;
+        }
+        else {
+            shift = 13;
+            exponent -= 112;
+        }
+
+        std::uint32_t half{ (exponent << 10) | (mantissa >> shift) };
+
+        // round to nearest even, a carry into the exponent is still correct
+        const std::uint32_t remainder{ mantissa & ((1u << shift) - 1) };
+        const std::uint32_t halfway{ 1u << (shift - 1) };
+
+        if (remainder > halfway || (remainder == halfway && (half & 1u) != 0))
+            ++half;
+
+        return static_cast<std::uint16_t>(sign | half);
+    }
+
+    auto VertexQuantizer::HalfToFloat(std::uint16_t half) -> float {
+        const std::uint32_t sign{ (static_cast<std::uint32_t>(half) & 0x8000u) << 16 };
+        std::uint32_t exponent{ (half >> 10) & 0x1fu };
+        std::uint32_t mantissa{ half & 0x3ffu };
+
+        // infinity and NaN keep their payload
+        if (exponent == 0x1fu)
+            return std::bit_cast<float>(sign | 0x7f800000u | (mantissa << 13));
+
+        if (exponent == 0) {
+            if (mantissa == 0)
+                return std::bit_cast<float>(sign);
+
+            // subnormal half, normalize it as a float
+            exponent = 113;
+            while ((mantissa & 0x400u) == 0) {
+                mantissa <<= 1;
+                --exponent;
+            }
+
+            return std::bit_cast<float>(sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13));
+        }
+
+        return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+    }
+
+    auto VertexQuantizer::PackNormal(const glm::vec3& normal) -> std::uint32_t {
+        const float length{ glm::length(normal) };
+        const glm::vec3 unit{ length > 0.0f ? normal / length : glm::vec3(0.0f) };
+
+        auto pack{ [](float component) -> std::uint32_t {
+            const auto value{ static_cast<std::int32_t>(std::lround(std::clamp(component, -1.0f, 1.0f) * 511.0f)) };
+            return static_cast<std::uint32_t>(value) & 0x3ffu;
+        } };
+
+        return pack(unit.x) | (pack(unit.y) << 10) | (pack(unit.z) << 20);
+    }
+
+    auto VertexQuantizer::PackTangent(const glm::vec4& tangent) -> std::uint32_t {
+        // the two bit w reads back as -1 from 0b11 and as 1 from 0b01
+        const std::uint32_t handedness{ tangent.w < 0.0f ? 0x3u : 0x1u };
+        return PackNormal(glm::vec3(tangent)) | (handedness << 30);
+    }
+
+    auto VertexQuantizer::PackTangents(std::span<const float> tangents) -> std::vector<std::uint32_t> {
+        std::vector<std::uint32_t> result(tangents.size() / 4);
+        for (std::size_t i{}; i < result.size(); i++)
+            result[i] = PackTangent(glm::vec4(tangents[i * 4], tangents[i * 4 + 1], tangents[i * 4 + 2], tangents[i * 4 + 3]));
+
+        return result;
+    }
+}
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <Core/AssetFiles.hh>
+#include <Core/AssetManifest.hh>
+#include <Core/Hash.hh>
+#include <Core/Logger.hh>
+#include <Core/ThreadPool.hh>
+#include <OpenGL/BakedModel.hh>
+#include <OpenGL/BakedTexture.hh>
+#include <OpenGL/MipGenerator.hh>
+#include <OpenGL/Model.hh>
+
+// Bakes every model and texture under the given directories, assets/models and
+// assets/textures by default, on all the cores. The files each output was built from
+// are recorded with their content hashes in assets/.bakemanifest, so a run only bakes
+// the assets whose sources, import settings or baked format changed since the last one.
+// Pass --force to bake everything again and --uncompressed to keep the texels RGBA instead
+// of block compressing them. No OpenGL context is needed
+namespace {
+    constexpr std::string_view s_ManifestPath{ "../assets/.bakemanifest" };
+
+    auto getFormatName(kT::Texture::PixelFormat format) -> std::string_view {
+        switch (format) {
+            case kT::Texture::PixelFormat::BC1: return "BC1";
+            case kT::Texture::PixelFormat::BC3: return "BC3";
+            case kT::Texture::PixelFormat::BC5: return "BC5";
+            case kT::Texture::PixelFormat::BC7: return "BC7";
+            default: return "RGBA8";
+        }
+    }
+
+    // the texture use picks the block format, so it is part of the bake settings
+    auto getTextureSettings(kT::Texture::TextureType type, bool compress) -> std::uint64_t {
+        return kT::hashString(std::to_string(static_cast<int>(type)) + (compress ? "+compressed" : ""));
+    }
+}
+
+int main(int argc, char** argv) {
+    kT::Logger::Init();
+
+    bool force{};
+    bool compress{ true };
+    std::vector<std::filesystem::path> roots{};
+    for (int arg{ 1 }; arg < argc; arg++) {
+        if (std::string_view{ argv[arg] } == "--force")
+            force = true;
+        else if (std::string_view{ argv[arg] } == "--uncompressed")
+            compress = false;
+        else
+            roots.emplace_back(argv[arg]);
+    }
+
+    // only a run over every asset knows which outputs belong to deleted files
+    const bool everyAsset{ roots.empty() };
+    if (everyAsset)
+        roots = { kT::ModelsDirectory, kT::TexturesDirectory };
+
+    std::vector<std::filesystem::path> models{};
+    std::vector<std::filesystem::path> standalone{};
+    for (const auto& root : roots) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator{ root }) {
+            if (entry.is_regular_file() && kT::isModelFile(entry.path()))
+                models.push_back(entry.path());
+            else if (entry.is_regular_file() && kT::isImageFile(entry.path()))
+                standalone.push_back(entry.path());
+        }
+    }
+
+    // every use of an image gets a bake of its own, see kT::BakedTexture::GetBakePath(). Ordered, so runs do not depend on thread timing
+    std::set<std::pair<std::filesystem::path, kT::Texture::TextureType>> images{};
+
+    std::sort(models.begin(), models.end());
+
+    const auto start{ std::chrono::steady_clock::now() };
+    kT::AssetManifest manifest{ s_ManifestPath };
+
+    // the runtime loads models with the default settings, the bakes must match them. Textures are baked below
+    kT::ModelLoadOptions options{};
+    options.parallelTextureDecode = false;
+    options.useBakedCache = true;
+    const std::uint64_t modelSettings{ kT::Model::GetBakeSettings(options) };
+
+    std::atomic<std::size_t> bakedModels{};
+    std::atomic<std::size_t> failures{};
+    std::mutex imagesMutex{};
+
+    kT::ThreadPool::Get().parallelFor(models.size(), [&](std::size_t i) -> void {
+        const auto& path{ models[i] };
+        const std::filesystem::path bakePath{ kT::BakedModel::GetBakePath(path) };
+
+        try {
+            const auto sources{ kT::Model::GetSourceFiles(path, options) };
+
+            if (force || !manifest.isUpToDate(bakePath, sources, modelSettings, kT::BakedModel::s_Version)) {
+                std::error_code error{};
+                std::filesystem::remove(bakePath, error);
+
+                static_cast<void>(kT::Model::Prepare(path, options));
+                manifest.record(bakePath, sources, modelSettings, kT::BakedModel::s_Version);
+                bakedModels++;
+                KATE_LOGGER_INFO("Baked model {}", path.string());
+            }
+
+            // textures referenced by the model are baked even when they live outside the roots
+            const auto baked{ kT::BakedModel::Open(bakePath, kT::Model::HashSources(path, options), path.parent_path()) };
+            if (!baked)
+                throw std::runtime_error("the baked file could not be opened");
+
+            std::lock_guard lock{ imagesMutex };
+            for (const auto& mesh : baked->getMeshes())
+                for (const auto& ref : mesh.textures)
+                    if (!ref.embedded)
+                        images.emplace(ref.path, ref.type);
+        }
+        catch (const std::exception& e) {
+            failures++;
+            KATE_LOGGER_WARN("Could not bake model {}: {}", path.string(), e.what());
+        }
+    });
+
+    // images no model references are taken as diffuse
+    for (const auto& path : standalone) {
+        const auto used{ images.lower_bound({ path, kT::Texture::TextureType::DIFFUSE }) };
+        if (used == images.end() || used->first != path)
+            images.emplace(path, kT::Texture::TextureType::DIFFUSE);
+    }
+
+    const std::vector<std::pair<std::filesystem::path, kT::Texture::TextureType>> textures{ images.begin(), images.end() };
+    std::atomic<std::size_t> bakedTextures{};
+    std::atomic<std::size_t> rgbaBytes{};
+    std::atomic<std::size_t> bakedBytes{};
+
+    kT::ThreadPool::Get().parallelFor(textures.size(), [&](std::size_t i) -> void {
+        const auto& [path, type]{ textures[i] };
+        const std::filesystem::path bakePath{ kT::BakedTexture::GetBakePath(path, type) };
+        const std::uint64_t settings{ getTextureSettings(type, compress) };
+
+        try {
+            if (force || !manifest.isUpToDate(bakePath, { path }, settings, kT::BakedTexture::s_Version)) {
+                const kT::Texture::PixelFormat format{ kT::BakedTexture::Bake(path, type, compress) };
+                manifest.record(bakePath, { path }, settings, kT::BakedTexture::s_Version);
+                bakedTextures++;
+                KATE_LOGGER_INFO("Baked texture {} as {}", path.string(), getFormatName(format));
+            }
+
+            // the levels uploaded as they are baked, against the full RGBA chain the runtime would build otherwise
+            const auto [width, height]{ kT::Texture::probe(path) };
+            rgbaBytes += static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4 + kT::MipGenerator::GetMipBytes(width, height);
+            bakedBytes += static_cast<std::size_t>(std::filesystem::file_size(bakePath));
+        }
+        catch (const std::exception& e) {
+            failures++;
+            KATE_LOGGER_WARN("Could not bake texture {}: {}", path.string(), e.what());
+        }
+    });
+
+    if (everyAsset)
+        manifest.prune();
+
+    manifest.save(s_ManifestPath);
+
+    const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+    KATE_LOGGER_INFO("Baked {} of {} models and {} of {} textures in {:.2f} s on {} threads, {} failed", bakedModels.load(), models.size(),
+                     bakedTextures.load(), textures.size(), elapsed.count(), kT::ThreadPool::Get().getThreadCount() + 1, failures.load());
+    KATE_LOGGER_INFO("Texture memory with mips: {:.2f} MiB as RGBA, {:.2f} MiB baked", static_cast<double>(rgbaBytes.load()) / (1024.0 * 1024.0),
+                     static_cast<double>(bakedBytes.load()) / (1024.0 * 1024.0));
+
+    return failures > 0 ? 1 : 0;
+}
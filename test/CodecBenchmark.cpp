@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Core/AssetFiles.hh>
+#include <Core/Logger.hh>
+#include <OpenGL/Mesh.hh>
+#include <OpenGL/Model.hh>
+#include <OpenGL/TangentGenerator.hh>
+#include <OpenGL/VertexCodec.hh>
+
+// Compresses the geometry of every model under assets/models with kT::VertexCodec and
+// reports the compression ratio and the decode speed in GB/s of decoded data. Decoding
+// pays off on disks slower than the reported break even bandwidth: below it, reading the
+// compressed file and decoding it is faster than reading the raw file. No OpenGL context is needed
+namespace {
+    constexpr int s_Runs{ 5 };
+
+    // best of several runs, in seconds
+    auto bestTime(const std::function<void()>& run) -> double {
+        double best{ std::numeric_limits<double>::max() };
+
+        for (int i{}; i < s_Runs; i++) {
+            const auto start{ std::chrono::steady_clock::now() };
+            run();
+            best = std::min(best, std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count());
+        }
+
+        return best;
+    }
+}
+
+int main() {
+    kT::Logger::Init();
+
+    const std::vector<std::filesystem::path> models{ kT::findModelFiles() };
+
+    const std::size_t vertexStride{ kT::Mesh::GetLayout().getStride() };
+    const std::size_t tangentStride{ kT::TangentGenerator::s_Components * sizeof(float) };
+
+    for (const auto& path : models) {
+        try {
+            const kT::PreparedModel prepared{ kT::Model::Prepare(path, { .parallelTextureDecode = false, .useBakedCache = false }) };
+
+            struct Streams {
+                std::vector<std::byte> vertices{};
+                std::vector<std::byte> indices{};
+                std::vector<std::byte> tangents{};
+            };
+
+            std::vector<Streams> encoded(prepared.imported.size());
+            std::size_t rawBytes{};
+            std::size_t encodedBytes{};
+
+            for (std::size_t i{}; i < prepared.imported.size(); i++) {
+                const auto& mesh{ prepared.imported[i] };
+                encoded[i].vertices = kT::VertexCodec::EncodeVertices(std::as_bytes(std::span{ mesh.vertices }), vertexStride);
+                encoded[i].indices = kT::VertexCodec::EncodeIndices(mesh.indices);
+                encoded[i].tangents = kT::VertexCodec::EncodeVertices(std::as_bytes(std::span{ mesh.tangents }), tangentStride);
+
+                rawBytes += (mesh.vertices.size() + mesh.tangents.size()) * sizeof(float) + mesh.indices.size() * sizeof(std::uint32_t);
+                encodedBytes += encoded[i].vertices.size() + encoded[i].indices.size() + encoded[i].tangents.size();
+            }
+
+            std::vector<kT::MeshData> decoded(prepared.imported.size());
+            for (std::size_t i{}; i < decoded.size(); i++) {
+                decoded[i].vertices.resize(prepared.imported[i].vertices.size());
+                decoded[i].indices.resize(prepared.imported[i].indices.size());
+                decoded[i].tangents.resize(prepared.imported[i].tangents.size());
+            }
+
+            bool valid{ true };
+            const double elapsed{ bestTime([&]() -> void {
+                for (std::size_t i{}; i < encoded.size(); i++) {
+                    valid = kT::VertexCodec::DecodeVertices(encoded[i].vertices, vertexStride, std::as_writable_bytes(std::span{ decoded[i].vertices })) &&
+                            kT::VertexCodec::DecodeIndices(encoded[i].indices, decoded[i].indices) &&
+                            kT::VertexCodec::DecodeVertices(encoded[i].tangents, tangentStride, std::as_writable_bytes(std::span{ decoded[i].tangents })) && valid;
+                }
+            }) };
+
+            for (std::size_t i{}; i < decoded.size(); i++) {
+                const auto& mesh{ prepared.imported[i] };
+                valid = valid && decoded[i].vertices == mesh.vertices && decoded[i].indices == mesh.indices && decoded[i].tangents == mesh.tangents;
+            }
+
+            const double raw{ static_cast<double>(rawBytes) };
+            const double speed{ raw / elapsed / 1e9 };
+            const double breakEven{ (raw - static_cast<double>(encodedBytes)) / raw * speed };
+
+            KATE_LOGGER_INFO("{:<60} {:>8.2f} MB -> {:>8.2f} MB ({:.2f}x)  decode {:>6.2f} GB/s  wins below {:.2f} GB/s{}", path.string(),
+                             raw / (1024.0 * 1024.0), static_cast<double>(encodedBytes) / (1024.0 * 1024.0),
+                             raw / std::max(static_cast<double>(encodedBytes), 1.0), speed, breakEven, valid ? "" : "  MISMATCH");
+        }
+        catch (const std::exception& e) {
+            KATE_LOGGER_WARN("{:<60} failed: {}", path.string(), e.what());
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Core/AssetFiles.hh>
+#include <Core/Logger.hh>
+#include <Core/ProcessMemory.hh>
+#include <Core/Window.hh>
+#include <OpenGL/GeometryArena.hh>
+#include <OpenGL/Model.hh>
+#include <OpenGL/TextureCache.hh>
+
+// Loads every model under assets/models with each import configuration and
+// reports the wall clock time. An OpenGL context is needed for the uploads.
+// Peak RSS only grows, pass a configuration name to run it alone and compare
+// the memory of several configurations across separate runs
+namespace {
+    struct Configuration {
+        std::string_view name{};
+        kT::ModelLoadOptions options{};
+        bool persistentMapping{ true };     // upload into mapped arena blocks instead of glBufferSubData
+    };
+
+    auto timeLoad(const std::filesystem::path& path, const Configuration& config) -> double {
+        kT::GeometryArena::SetPersistentMapping(config.persistentMapping);
+
+        const auto start{ std::chrono::steady_clock::now() };
+        double elapsed{};
+
+        {
+            kT::Model model{ path, config.options };
+            elapsed = std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - start }.count();
+        }
+
+        // the next configuration gets blocks created with its own mapping setting and decodes its own textures
+        kT::GeometryArena::Trim();
+        kT::TextureCache::Clear();
+        return elapsed;
+    }
+}
+
+int main(int argc, char** argv) {
+    kT::Logger::Init();
+
+    kT::Window window{};
+    window.StartUp("LoadBenchmark", 320, 240);
+
+    const std::vector<Configuration> configurations{
+        { "serial decode", { .parallelTextureDecode = false, .useBakedCache = false } },
+        { "parallel decode", { .parallelTextureDecode = true, .useBakedCache = false } },
+        { "assimp", { .parallelTextureDecode = true, .useBakedCache = false, .nativeImporters = false } },
+        { "baked", { .parallelTextureDecode = true, .useBakedCache = true } },
+        { "baked subdata", { .parallelTextureDecode = true, .useBakedCache = true }, false },
+        { "streaming", { .parallelTextureDecode = true, .useBakedCache = false, .memoryBudget = std::size_t{ 512 } * 1024 * 1024 } },
+    };
+
+    const std::string_view only{ argc > 1 ? argv[1] : "" };
+
+    for (const auto& path : kT::findModelFiles()) {
+        for (const auto& config : configurations) {
+            if (!only.empty() && config.name != only)
+                continue;
+
+            try {
+                const double elapsed{ timeLoad(path, config) };
+                KATE_LOGGER_INFO("{:<60} {:<16} {:>10.2f} ms {:>10.2f} MB peak RSS", path.string(), config.name, elapsed,
+                                 static_cast<double>(kT::getPeakResidentBytes()) / (1024.0 * 1024.0));
+            }
+            catch (const std::exception& e) {
+                KATE_LOGGER_WARN("{:<60} {:<16} failed: {}", path.string(), config.name, e.what());
+            }
+        }
+    }
+
+    return 0;
+}
@@ -12,5 +12,7 @@ int main(int, char**) {
     while (app->IsRunning())
         app->UpdateState();
 
+    app->ShutDown();
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <Core/Logger.hh>
+#include <OpenGL/Model.hh>
+#include <OpenGL/ObjLoader.hh>
+
+// Parses every OBJ file under assets/models with kT::ObjLoader and with assimp
+// and reports the throughput of each in MB/s. Only the import is timed, for assimp
+// without the conversion to kT::MeshData, so no OpenGL context is needed
+namespace {
+    constexpr int s_Runs{ 5 };
+
+    // best of several runs, the first one also pays for reading the file from disk
+    auto bestTime(const std::function<void()>& load) -> double {
+        double best{ std::numeric_limits<double>::max() };
+
+        for (int run{}; run < s_Runs; run++) {
+            const auto start{ std::chrono::steady_clock::now() };
+            load();
+            best = std::min(best, std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - start }.count());
+        }
+
+        return best;
+    }
+}
+
+int main() {
+    kT::Logger::Init();
+
+    std::vector<std::filesystem::path> models{};
+    for (const auto& entry : std::filesystem::recursive_directory_iterator{ "../assets/models" })
+        if (entry.is_regular_file() && kT::ObjLoader::IsSupported(entry.path()))
+            models.push_back(entry.path());
+
+    std::sort(models.begin(), models.end());
+
+    for (const auto& path : models) {
+        const double megabytes{ static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0) };
+
+        try {
+            std::size_t nativeVertices{};
+            const double native{ bestTime([&]() -> void {
+                nativeVertices = 0;
+                for (const auto& mesh : kT::ObjLoader::Load(path))
+                    nativeVertices += mesh.vertices.size() / 8;
+            }) };
+
+            std::size_t assimpVertices{};
+            const double assimp{ bestTime([&]() -> void {
+                Assimp::Importer importer{};
+                const aiScene* scene{ importer.ReadFile(path.string(), kT::Model::s_ImportFlags) };
+                if (scene == nullptr)
+                    throw std::runtime_error(importer.GetErrorString());
+
+                assimpVertices = 0;
+                for (unsigned int i{}; i < scene->mNumMeshes; i++)
+                    assimpVertices += scene->mMeshes[i]->mNumVertices;
+            }) };
+
+            KATE_LOGGER_INFO("{:<60} {:>7.2f} MB  native {:>8.1f} MB/s  assimp {:>8.1f} MB/s  ({:.1f}x), {} vs {} vertices", path.string(), megabytes,
+                             megabytes / (native / 1000.0), megabytes / (assimp / 1000.0), assimp / native, nativeVertices, assimpVertices);
+        }
+        catch (const std::exception& e) {
+            KATE_LOGGER_WARN("{:<60} failed: {}", path.string(), e.what());
+        }
+    }
+
+    return 0;
+}
@@ -140,6 +140,14 @@ auto run() -> void {
             g_DefaultShaders.setUniformMat4("view", g_Camera.getView());
             g_DefaultShaders.setUniformMat4("projection", g_Camera.getProjection());
 
+            // the cube vertices are floats in model space, no quantization to undo
+            g_DefaultShaders.setUniformVec3("positionOffset", glm::vec3(0.0f));
+            g_DefaultShaders.setUniformVec3("positionScale", glm::vec3(1.0f));
+
+            // the container textures are loaded as plain data, already gamma encoded
+            g_DefaultShaders.setUniformBool("gammaEncode", false);
+            g_DefaultShaders.setUniformBool("gammaDecode", false);
+
             g_DefaultShaders.setUniformInt("material.specular", 1);
 
             g_Texture.bind();
@@ -153,6 +161,12 @@ auto run() -> void {
             g_Vbo.bind();
             g_Vao.bind();
 
+            // the cube is not instanced, feed the instance transform
+            // (locations 3 to 6) the identity as a constant attribute
+            const glm::mat4 identity{ glm::mat4(1.0f) };
+            for (GLuint column{}; column < 4; ++column)
+                glVertexAttrib4fv(3 + column, glm::value_ptr(identity[column]));
+
             // NOTE: 36 because we have 6 faces to render with 2 triangles
             // each and 3 vertices per triangles, same goes for the light cube
             glDrawArrays(GL_TRIANGLES, 0, 36);